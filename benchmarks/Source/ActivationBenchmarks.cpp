@@ -0,0 +1,154 @@
+/**
+ * Activation Benchmarks
+ *
+ * MachineId::generate() (cached and recomputed), and Activation's state
+ * calls against an activation.json in a scratch directory. The contended
+ * variants time calls on this thread while other threads hammer the same
+ * state: readers calling isActivated(), or a writer cycling
+ * loadState()/saveState() as a second plugin instance would.
+ */
+
+#include "Benchmark.h"
+
+#include <beatconnect/Activation.h>
+#include <beatconnect/MachineId.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace beatconnect::bench {
+
+namespace {
+
+/** Threads running fn in a loop until destroyed. */
+class Contenders {
+public:
+    Contenders(int count, std::function<void()> fn) {
+        for (int i = 0; i < count; ++i) {
+            threads.emplace_back([this, fn] {
+                ready.fetch_add(1);
+                while (!stop.load(std::memory_order_relaxed)) fn();
+            });
+        }
+
+        // Measure under contention, not while the threads are still starting
+        while (ready.load() < count) std::this_thread::yield();
+    }
+
+    ~Contenders() {
+        stop = true;
+        for (auto& thread : threads) thread.join();
+    }
+
+private:
+    std::atomic<bool> stop { false };
+    std::atomic<int> ready { 0 };
+    std::vector<std::thread> threads;
+};
+
+/** Activation over an activated state file in its own scratch directory. */
+struct ActivationFixture {
+    ScratchDirectory scratch { "beatconnect-bench-activation" };
+    std::unique_ptr<Activation> activation;
+
+    ActivationFixture() {
+        auto stateFile = scratch.getDirectory().getChildFile("activation.json");
+
+        juce::DynamicObject::Ptr saved = new juce::DynamicObject();
+        saved->setProperty("activation_code", "BENCH-0000-0000-0000");
+        saved->setProperty("machine_id", juce::String(MachineId::generate()));
+        saved->setProperty("activated_at", juce::Time::getCurrentTime().toISO8601(true));
+        saved->setProperty("is_valid", true);
+        saved->setProperty("current_activations", 1);
+        saved->setProperty("max_activations", 3);
+        saved->setProperty("last_validated_at", juce::Time::getCurrentTime().toISO8601(true));
+        stateFile.replaceWithText(juce::JSON::toString(juce::var(saved.get())));
+
+        // Never talks to the API: no startup validation, no revalidation
+        ActivationConfig config;
+        config.apiBaseUrl = "http://127.0.0.1:9";
+        config.pluginId = "00000000-0000-0000-0000-000000000000";
+        config.supabaseKey = "bench";
+        config.statePath = stateFile.getFullPathName().toStdString();
+        config.validateOnStartup = false;
+        config.revalidateIntervalSeconds = 0;
+        activation = Activation::create(config);
+    }
+};
+
+} // namespace
+
+void registerActivationBenchmarks(Registry& registry) {
+    // ==========================================================================
+    // Machine ID
+    // ==========================================================================
+
+    registry.add("machineid/generate", [](State& state) {
+        MachineId::generate();
+        state.measure([] { juce::ignoreUnused(MachineId::generate()); });
+    });
+
+    // What the first call in a process pays (hardware queries + hash)
+    registry.add("machineid/compute", [](State& state) {
+        state.measure([] {
+            MachineId::invalidateCache();
+            juce::ignoreUnused(MachineId::generate());
+        });
+    });
+
+    // ==========================================================================
+    // State file
+    // ==========================================================================
+
+    registry.add("activation/loadState", [](State& state) {
+        ActivationFixture fixture;
+        state.measure([&] { fixture.activation->loadState(); });
+    });
+
+    registry.add("activation/saveState", [](State& state) {
+        ActivationFixture fixture;
+        state.measure([&] { fixture.activation->saveState(); });
+    });
+
+    // ==========================================================================
+    // isActivated() under contention
+    // ==========================================================================
+
+    for (int threads : { 1, 4, 8 }) {
+        registry.add("activation/isActivated/threads:" + std::to_string(threads), [threads](State& state) {
+            ActivationFixture fixture;
+            auto* activation = fixture.activation.get();
+            if (!activation->isActivated()) {
+                state.skip("seeded state did not load as activated");
+                return;
+            }
+
+            Contenders readers(threads - 1, [activation] { juce::ignoreUnused(activation->isActivated()); });
+            state.setItemsPerCall(1);
+            state.measure([activation] { juce::ignoreUnused(activation->isActivated()); });
+        });
+    }
+
+    registry.add("activation/isActivated/with-writer", [](State& state) {
+        ActivationFixture fixture;
+        auto* activation = fixture.activation.get();
+
+        Contenders writer(1, [activation] {
+            activation->loadState();
+            activation->saveState();
+        });
+        state.setItemsPerCall(1);
+        state.measure([activation] { juce::ignoreUnused(activation->isActivated()); });
+    });
+
+    registry.add("activation/saveState/with-readers:4", [](State& state) {
+        ActivationFixture fixture;
+        auto* activation = fixture.activation.get();
+
+        Contenders readers(4, [activation] { juce::ignoreUnused(activation->isActivated()); });
+        state.measure([activation] { activation->saveState(); });
+    });
+}
+
+} // namespace beatconnect::bench
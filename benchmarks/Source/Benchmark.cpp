@@ -0,0 +1,265 @@
+/**
+ * Benchmark Harness - Implementation
+ */
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#ifndef BEATCONNECT_BENCH_SDK_VERSION
+    #define BEATCONNECT_BENCH_SDK_VERSION "unknown"
+#endif
+
+#ifndef BEATCONNECT_BENCH_SDK_REVISION
+    #define BEATCONNECT_BENCH_SDK_REVISION "unknown"
+#endif
+
+#ifndef BEATCONNECT_BENCH_BUILD_TYPE
+    #define BEATCONNECT_BENCH_BUILD_TYPE "unknown"
+#endif
+
+namespace beatconnect::bench {
+
+namespace {
+
+// Aim for this many samples per benchmark; never fewer than minSamples
+constexpr int targetSamples = 30;
+constexpr int minSamples = 5;
+constexpr int64_t maxBatch = 10'000'000;
+
+juce::String compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + juce::String(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+// ==============================================================================
+// State
+// ==============================================================================
+
+State::State(double minTime) : minSeconds(minTime) {}
+
+void State::measure(const std::function<void()>& fn) {
+    if (skipped) return;
+
+    // Warm-up call, which also sizes the batches
+    auto warmStart = Clock::now();
+    fn();
+    const auto warmSeconds = std::chrono::duration<double>(Clock::now() - warmStart).count();
+
+    const auto sampleSeconds = minSeconds / targetSamples;
+    auto batch = warmSeconds > 0.0 ? (int64_t)(sampleSeconds / warmSeconds) : maxBatch;
+    batch = std::clamp<int64_t>(batch, 1, maxBatch);
+
+    double elapsed = 0.0;
+    while ((int)sampleNs.size() < minSamples || elapsed < minSeconds) {
+        auto start = Clock::now();
+        for (int64_t i = 0; i < batch; ++i) fn();
+        const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        sampleNs.push_back(seconds * 1e9 / (double)batch);
+        calls += batch;
+        elapsed += seconds;
+
+        // Very slow calls: a few samples are enough
+        if ((int)sampleNs.size() >= 3 && elapsed > minSeconds * 10.0) break;
+    }
+}
+
+void State::measureEach(const std::function<void()>& setup, const std::function<void()>& fn) {
+    if (skipped) return;
+
+    setup();
+    fn();  // Warm-up
+
+    double elapsed = 0.0;
+    while ((int)sampleNs.size() < minSamples || elapsed < minSeconds) {
+        setup();
+
+        auto start = Clock::now();
+        fn();
+        const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        sampleNs.push_back(seconds * 1e9);
+        ++calls;
+        elapsed += seconds;
+
+        if ((int)sampleNs.size() >= 3 && elapsed > minSeconds * 10.0) break;
+    }
+}
+
+void State::skip(const std::string& reason) {
+    skipped = true;
+    skipReason = reason;
+}
+
+double State::getMedianNs() const {
+    if (sampleNs.empty()) return 0.0;
+
+    auto sorted = sampleNs;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[sorted.size() / 2];
+}
+
+Result State::finish(const std::string& name) const {
+    Result result;
+    result.name = name;
+    result.counters = counters;
+    result.skipped = skipped || sampleNs.empty();
+    result.skipReason = skipped ? skipReason : (sampleNs.empty() ? "nothing measured" : "");
+    if (result.skipped) return result;
+
+    auto sorted = sampleNs;
+    std::sort(sorted.begin(), sorted.end());
+
+    const auto n = sorted.size();
+    result.calls = calls;
+    result.samples = (int)n;
+    result.medianNs = sorted[n / 2];
+    result.minNs = sorted.front();
+    result.p95Ns = sorted[std::min(n - 1, (size_t)std::ceil(0.95 * (double)n) - 1)];
+
+    double sum = 0.0;
+    for (auto ns : sorted) sum += ns;
+    result.meanNs = sum / (double)n;
+
+    double variance = 0.0;
+    for (auto ns : sorted) variance += (ns - result.meanNs) * (ns - result.meanNs);
+    result.stddevNs = std::sqrt(variance / (double)n);
+
+    const auto seconds = result.medianNs / 1e9;
+    if (seconds > 0.0) {
+        result.bytesPerSecond = (double)bytesPerCall / seconds;
+        result.itemsPerSecond = (double)itemsPerCall / seconds;
+    }
+    return result;
+}
+
+// ==============================================================================
+// Registry
+// ==============================================================================
+
+void Registry::add(std::string name, BenchmarkFn fn) {
+    entries.push_back({ std::move(name), std::move(fn) });
+}
+
+// ==============================================================================
+// Reports
+// ==============================================================================
+
+juce::var toJson(const std::vector<Result>& results) {
+    juce::DynamicObject::Ptr context = new juce::DynamicObject();
+    context->setProperty("sdk_version", BEATCONNECT_BENCH_SDK_VERSION);
+    context->setProperty("sdk_revision", BEATCONNECT_BENCH_SDK_REVISION);
+    context->setProperty("build_type", BEATCONNECT_BENCH_BUILD_TYPE);
+    context->setProperty("compiler", compilerName());
+    context->setProperty("juce_version", juce::SystemStats::getJUCEVersion());
+    context->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    context->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    context->setProperty("cpu", juce::SystemStats::getCpuModel());
+    context->setProperty("cpu_count", juce::SystemStats::getNumCpus());
+    context->setProperty("memory_mb", juce::SystemStats::getMemorySizeInMegabytes());
+
+    juce::Array<juce::var> benchmarks;
+    for (const auto& result : results) {
+        juce::DynamicObject::Ptr entry = new juce::DynamicObject();
+        entry->setProperty("name", juce::String(result.name));
+
+        if (result.skipped) {
+            entry->setProperty("skipped", true);
+            entry->setProperty("reason", juce::String(result.skipReason));
+        } else {
+            entry->setProperty("calls", result.calls);
+            entry->setProperty("samples", result.samples);
+            entry->setProperty("median_ns", result.medianNs);
+            entry->setProperty("mean_ns", result.meanNs);
+            entry->setProperty("min_ns", result.minNs);
+            entry->setProperty("p95_ns", result.p95Ns);
+            entry->setProperty("stddev_ns", result.stddevNs);
+            if (result.bytesPerSecond > 0.0) entry->setProperty("bytes_per_second", result.bytesPerSecond);
+            if (result.itemsPerSecond > 0.0) entry->setProperty("items_per_second", result.itemsPerSecond);
+        }
+
+        if (!result.counters.empty()) {
+            juce::DynamicObject::Ptr counters = new juce::DynamicObject();
+            for (const auto& [name, value] : result.counters) {
+                counters->setProperty(juce::Identifier(juce::String(name)), value);
+            }
+            entry->setProperty("counters", juce::var(counters.get()));
+        }
+
+        benchmarks.add(juce::var(entry.get()));
+    }
+
+    juce::DynamicObject::Ptr report = new juce::DynamicObject();
+    report->setProperty("context", juce::var(context.get()));
+    report->setProperty("benchmarks", benchmarks);
+    return juce::var(report.get());
+}
+
+int compareWithBaseline(const std::vector<Result>& results, const juce::var& baseline,
+                        double maxRegressionPercent) {
+    std::map<std::string, double> baselineNs;
+    if (auto* entries = baseline.getProperty("benchmarks", juce::var()).getArray()) {
+        for (const auto& entry : *entries) {
+            if ((bool)entry.getProperty("skipped", false)) continue;
+            baselineNs[entry.getProperty("name", "").toString().toStdString()] =
+                (double)entry.getProperty("median_ns", 0.0);
+        }
+    }
+
+    const auto baselineVersion = baseline.getProperty("context", juce::var())
+                                     .getProperty("sdk_version", "unknown").toString();
+    std::cout << "\nCompared with baseline (SDK " << baselineVersion << "), median per call:\n";
+
+    int regressions = 0;
+    for (const auto& result : results) {
+        if (result.skipped) continue;
+
+        auto found = baselineNs.find(result.name);
+        if (found == baselineNs.end() || found->second <= 0.0) {
+            std::cout << "  " << result.name << ": new\n";
+            continue;
+        }
+
+        const auto change = (result.medianNs - found->second) / found->second * 100.0;
+        const bool regressed = change > maxRegressionPercent;
+        regressions += regressed ? 1 : 0;
+
+        std::cout << "  " << result.name << ": "
+                  << juce::String(change >= 0.0 ? "+" : "") << juce::String(change, 1) << "%"
+                  << (regressed ? "  REGRESSION" : "") << "\n";
+    }
+    return regressions;
+}
+
+// ==============================================================================
+// Scratch Directory
+// ==============================================================================
+
+ScratchDirectory::ScratchDirectory(const juce::String& prefix)
+    : directory(juce::File::getSpecialLocation(juce::File::tempDirectory)
+                    .getNonexistentChildFile(prefix, "", false)) {
+    directory.createDirectory();
+}
+
+ScratchDirectory::~ScratchDirectory() {
+    directory.deleteRecursively();
+}
+
+void ScratchDirectory::clear() {
+    directory.deleteRecursively();
+    directory.createDirectory();
+}
+
+} // namespace beatconnect::bench
@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * Benchmark Harness
+ *
+ * Minimal runner for the SDK benchmarks: each benchmark is timed in samples
+ * of one or more calls, and the per-call statistics (median, mean, min,
+ * p95) go to a table on stdout and, with --json, to a machine-readable
+ * report that a later run can be compared against (--compare), so SDK
+ * releases can be checked for regressions before upgrading.
+ *
+ *   registry.add("state/codec/write", [](State& state) {
+ *       ... setup ...
+ *       state.setBytesPerCall(block.getSize());
+ *       state.measure([&] { codec.write(...); });
+ *   });
+ */
+
+#include <juce_core/juce_core.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace beatconnect::bench {
+
+// ==============================================================================
+// Results
+// ==============================================================================
+
+struct Result {
+    std::string name;
+    int64_t calls = 0;             // Timed calls across all samples
+    int samples = 0;
+
+    // Nanoseconds per call
+    double medianNs = 0.0;
+    double meanNs = 0.0;
+    double minNs = 0.0;
+    double p95Ns = 0.0;
+    double stddevNs = 0.0;
+
+    double bytesPerSecond = 0.0;   // From setBytesPerCall(), 0 if unset
+    double itemsPerSecond = 0.0;   // From setItemsPerCall(), 0 if unset
+
+    std::map<std::string, double> counters;
+
+    bool skipped = false;
+    std::string skipReason;
+};
+
+// ==============================================================================
+// State
+// ==============================================================================
+
+/** Handed to each benchmark to time its hot path and report extras. */
+class State {
+public:
+    explicit State(double minSeconds);
+
+    /**
+     * Time fn. Calls are batched so each sample runs for a fair slice of
+     * the time budget; the first call is a warm-up and isn't counted.
+     */
+    void measure(const std::function<void()>& fn);
+
+    /**
+     * Time fn one call per sample, running setup (untimed) before each -
+     * for calls that consume their input, like a download into an empty
+     * directory.
+     */
+    void measureEach(const std::function<void()>& setup, const std::function<void()>& fn);
+
+    /** Throughput: bytes (or items) processed by one call of fn. */
+    void setBytesPerCall(int64_t bytes) { bytesPerCall = bytes; }
+    void setItemsPerCall(int64_t items) { itemsPerCall = items; }
+
+    /** Extra value for the report, e.g. a realtime factor. */
+    void setCounter(const std::string& name, double value) { counters[name] = value; }
+
+    /** Report the benchmark as skipped (missing precondition) instead of failing. */
+    void skip(const std::string& reason);
+
+    bool isSkipped() const { return skipped; }
+
+    /** Median nanoseconds per call so far, for derived counters. */
+    double getMedianNs() const;
+
+    Result finish(const std::string& name) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    double minSeconds;
+    std::vector<double> sampleNs;  // Per call, one entry per sample
+    int64_t calls = 0;
+    int64_t bytesPerCall = 0;
+    int64_t itemsPerCall = 0;
+    std::map<std::string, double> counters;
+    bool skipped = false;
+    std::string skipReason;
+};
+
+// ==============================================================================
+// Registry
+// ==============================================================================
+
+using BenchmarkFn = std::function<void(State&)>;
+
+class Registry {
+public:
+    void add(std::string name, BenchmarkFn fn);
+
+    struct Entry {
+        std::string name;
+        BenchmarkFn fn;
+    };
+
+    const std::vector<Entry>& getEntries() const { return entries; }
+
+private:
+    std::vector<Entry> entries;
+};
+
+// Per-area registration, one function per Benchmarks.cpp file
+void registerActivationBenchmarks(Registry& registry);
+void registerDownloadBenchmarks(Registry& registry);
+void registerPresetBenchmarks(Registry& registry);
+void registerStateBenchmarks(Registry& registry);
+void registerProcessBlockBenchmarks(Registry& registry);
+
+// ==============================================================================
+// Reports
+// ==============================================================================
+
+/** JSON report: { "context": {...}, "benchmarks": [...] }. */
+juce::var toJson(const std::vector<Result>& results);
+
+/**
+ * Print each benchmark's median against baseline (a report from an earlier
+ * run). Returns the number that got slower by more than maxRegressionPercent.
+ */
+int compareWithBaseline(const std::vector<Result>& results, const juce::var& baseline,
+                        double maxRegressionPercent);
+
+/** Unique, empty scratch directory under the temp folder; removed on destruction. */
+class ScratchDirectory {
+public:
+    explicit ScratchDirectory(const juce::String& prefix);
+    ~ScratchDirectory();
+
+    const juce::File& getDirectory() const { return directory; }
+
+    /** Empty the directory (keeping it). */
+    void clear();
+
+private:
+    juce::File directory;
+};
+
+} // namespace beatconnect::bench
@@ -0,0 +1,205 @@
+/**
+ * Download Benchmarks
+ *
+ * AssetDownloader against the local mock server (MockServer.h): single
+ * stream and segmented throughput for one large asset, and batches of
+ * small assets at several concurrency limits, and a pack sync. Each timed
+ * call downloads into an emptied directory, so nothing is skipped as
+ * already present.
+ */
+
+#include "Benchmark.h"
+#include "MockServer.h"
+
+#include <beatconnect/AssetDownloader.h>
+
+namespace beatconnect::bench {
+
+namespace {
+
+constexpr int64_t largeAssetBytes = 64 * 1024 * 1024;
+constexpr int64_t smallAssetBytes = 1024 * 1024;
+constexpr int batchSize = 32;
+constexpr int packSize = 8;
+
+DownloaderConfig makeConfig(const MockAssetServer& server, const ScratchDirectory& scratch) {
+    DownloaderConfig config;
+    config.apiBaseUrl = server.getBaseUrl();
+    config.downloadPath = scratch.getDirectory().getFullPathName().toStdString();
+    config.verifyChecksums = false;  // The mock serves no checksums
+    config.skipExisting = false;
+    config.resumeDownloads = false;
+    config.maxRetries = 0;
+    return config;
+}
+
+/** Fails the benchmark up front rather than timing error paths. */
+bool checkDownload(State& state, const std::pair<DownloadStatus, std::string>& result) {
+    if (result.first == DownloadStatus::Success) return true;
+    state.skip(std::string("download failed: ") + downloadStatusToString(result.first));
+    return false;
+}
+
+} // namespace
+
+void registerDownloadBenchmarks(Registry& registry) {
+    // ==========================================================================
+    // One large asset
+    // ==========================================================================
+
+    registry.add("download/single/64MB", [](State& state) {
+        MockAssetServer server;
+        if (!server.isRunning()) return state.skip("could not bind a local port");
+        server.addAsset("large", largeAssetBytes);
+
+        ScratchDirectory scratch("beatconnect-bench-download");
+        AssetDownloader downloader;
+        downloader.configure(makeConfig(server, scratch));
+
+        if (!checkDownload(state, downloader.download("large"))) return;
+
+        state.setBytesPerCall(largeAssetBytes);
+        state.measureEach([&] { scratch.clear(); },
+                          [&] { downloader.download("large"); });
+    });
+
+    for (int segments : { 2, 4, 8 }) {
+        registry.add("download/segmented/64MB/segments:" + std::to_string(segments), [segments](State& state) {
+            MockAssetServer server;
+            if (!server.isRunning()) return state.skip("could not bind a local port");
+            server.addAsset("large", largeAssetBytes);
+
+            ScratchDirectory scratch("beatconnect-bench-download");
+            auto config = makeConfig(server, scratch);
+            config.segmentedDownloads = true;
+            config.segmentThresholdBytes = smallAssetBytes;
+            config.segmentsPerFile = segments;
+
+            AssetDownloader downloader;
+            downloader.configure(config);
+
+            if (!checkDownload(state, downloader.download("large"))) return;
+
+            const auto rangesBefore = server.getRangeRequests();
+            state.setBytesPerCall(largeAssetBytes);
+            state.measureEach([&] { scratch.clear(); },
+                              [&] { downloader.download("large"); });
+
+            // 0 means the downloader fell back to one stream
+            state.setCounter("range_requests", server.getRangeRequests() - rangesBefore);
+        });
+    }
+
+    // Presigned URL path (package purchases): no info / URL lookups
+    registry.add("download/fromUrl/64MB", [](State& state) {
+        MockAssetServer server;
+        if (!server.isRunning()) return state.skip("could not bind a local port");
+        server.addAsset("large", largeAssetBytes);
+
+        ScratchDirectory scratch("beatconnect-bench-download");
+        AssetDownloader downloader;
+        downloader.configure(makeConfig(server, scratch));
+
+        const auto url = server.getBaseUrl() + "/files/large";
+        if (!checkDownload(state, downloader.downloadFromUrl(url, "large.bin"))) return;
+
+        state.setBytesPerCall(largeAssetBytes);
+        state.measureEach([&] { scratch.clear(); },
+                          [&] { downloader.downloadFromUrl(url, "large.bin"); });
+    });
+
+    // ==========================================================================
+    // Batches of small assets
+    // ==========================================================================
+
+    for (int concurrent : { 1, 4, 8 }) {
+        registry.add("download/batch/32x1MB/concurrent:" + std::to_string(concurrent), [concurrent](State& state) {
+            MockAssetServer server;
+            if (!server.isRunning()) return state.skip("could not bind a local port");
+
+            std::vector<std::string> ids;
+            for (int i = 0; i < batchSize; ++i) {
+                ids.push_back("small-" + std::to_string(i));
+                server.addAsset(ids.back(), smallAssetBytes);
+            }
+
+            ScratchDirectory scratch("beatconnect-bench-download");
+            auto config = makeConfig(server, scratch);
+            config.maxConcurrent = concurrent;
+
+            AssetDownloader downloader;
+            downloader.configure(config);
+
+            // Completion arrives on a worker thread
+            int failed = 0;
+            auto runBatch = [&] {
+                juce::WaitableEvent done;
+                downloader.downloadBatch(ids, nullptr, [&](int, int batchFailed) {
+                    failed += batchFailed;
+                    done.signal();
+                });
+                done.wait();
+            };
+
+            runBatch();
+            if (failed > 0) return state.skip(std::to_string(failed) + " of the batch failed to download");
+
+            state.setBytesPerCall(smallAssetBytes * batchSize);
+            state.setItemsPerCall(batchSize);
+            state.measureEach([&] { scratch.clear(); }, runBatch);
+            state.setCounter("failed", failed);
+        });
+    }
+
+    // ==========================================================================
+    // Pack sync
+    // ==========================================================================
+
+    // Every sync follows a cancelAll, which must only stop what was running
+    // then: a sync started afterwards has to bring the whole pack down
+    registry.add("download/pack/8x1MB/after-cancelAll", [](State& state) {
+        MockAssetServer server;
+        if (!server.isRunning()) return state.skip("could not bind a local port");
+
+        std::vector<std::string> ids;
+        for (int i = 0; i < packSize; ++i) {
+            ids.push_back("pack-" + std::to_string(i));
+            server.addAsset(ids.back(), smallAssetBytes);
+        }
+        server.addPack("bench-pack", ids);
+
+        ScratchDirectory scratch("beatconnect-bench-download");
+        auto config = makeConfig(server, scratch);
+        config.maxConcurrent = 4;
+
+        AssetDownloader downloader;
+        downloader.configure(config);
+
+        // Completion arrives on a worker thread
+        PackSyncResult result;
+        auto runSync = [&] {
+            juce::WaitableEvent done;
+            downloader.syncPack("bench-pack", nullptr, [&](const PackSyncResult& r) {
+                result = r;
+                done.signal();
+            });
+            done.wait();
+        };
+
+        downloader.cancelAll();
+        runSync();
+        if (result.status != DownloadStatus::Success || result.downloaded != packSize) {
+            return state.skip(std::string("sync after cancelAll did not complete: ")
+                              + downloadStatusToString(result.status) + ", "
+                              + std::to_string(result.downloaded) + " of "
+                              + std::to_string(packSize) + " downloaded");
+        }
+
+        state.setBytesPerCall(smallAssetBytes * packSize);
+        state.setItemsPerCall(packSize);
+        state.measureEach([&] { scratch.clear(); downloader.cancelAll(); }, runSync);
+        state.setCounter("failed", result.failed);
+    });
+}
+
+} // namespace beatconnect::bench
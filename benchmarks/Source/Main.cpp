@@ -0,0 +1,169 @@
+/**
+ * BeatConnect SDK Benchmarks
+ *
+ *   beatconnect_benchmarks [--filter <text|wildcard>] [--list]
+ *                          [--json <report.json>] [--compare <baseline.json>]
+ *                          [--max-regression <percent>] [--min-time <seconds>] [--quick]
+ *
+ * Runs every registered benchmark (or those whose name contains --filter,
+ * or matches it when it has a '*'), prints a table, optionally writes the
+ * JSON report and compares medians against an earlier report. Exits 1 if
+ * any benchmark got slower than --max-regression percent (default 10).
+ */
+
+#include "Benchmark.h"
+
+#include <juce_events/juce_events.h>
+
+#include <iostream>
+
+using namespace beatconnect::bench;
+
+namespace {
+
+struct Options {
+    juce::String filter;
+    bool listOnly = false;
+    juce::File jsonFile;
+    juce::File baselineFile;
+    double maxRegressionPercent = 10.0;
+    double minSeconds = 0.5;
+};
+
+void printUsage() {
+    std::cout << "Usage: beatconnect_benchmarks [--filter <text|wildcard>] [--list]\n"
+                 "                              [--json <report.json>] [--compare <baseline.json>]\n"
+                 "                              [--max-regression <percent>] [--min-time <seconds>] [--quick]\n";
+}
+
+bool parseOptions(const juce::StringArray& args, Options& options) {
+    for (int i = 0; i < args.size(); ++i) {
+        const auto& arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+
+        if (arg == "--filter" && hasValue) {
+            options.filter = args[++i];
+        } else if (arg == "--list") {
+            options.listOnly = true;
+        } else if (arg == "--json" && hasValue) {
+            options.jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(args[++i]);
+        } else if (arg == "--compare" && hasValue) {
+            options.baselineFile = juce::File::getCurrentWorkingDirectory().getChildFile(args[++i]);
+        } else if (arg == "--max-regression" && hasValue) {
+            options.maxRegressionPercent = args[++i].getDoubleValue();
+        } else if (arg == "--min-time" && hasValue) {
+            options.minSeconds = juce::jmax(0.001, args[++i].getDoubleValue());
+        } else if (arg == "--quick") {
+            options.minSeconds = 0.05;
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool matchesFilter(const std::string& name, const juce::String& filter) {
+    if (filter.isEmpty()) return true;
+    if (filter.containsChar('*')) return juce::String(name).matchesWildcard(filter, true);
+    return juce::String(name).containsIgnoreCase(filter);
+}
+
+juce::String formatNs(double ns) {
+    if (ns < 1e3) return juce::String(ns, 1) + " ns";
+    if (ns < 1e6) return juce::String(ns / 1e3, 2) + " us";
+    if (ns < 1e9) return juce::String(ns / 1e6, 2) + " ms";
+    return juce::String(ns / 1e9, 2) + " s";
+}
+
+juce::String formatRate(const Result& result) {
+    if (result.bytesPerSecond > 0.0) return juce::String(result.bytesPerSecond / (1024.0 * 1024.0), 1) + " MB/s";
+    if (result.itemsPerSecond > 0.0) return juce::String(result.itemsPerSecond, 0) + " items/s";
+    return {};
+}
+
+void printRow(const Result& result) {
+    auto line = juce::String(result.name).paddedRight(' ', 52);
+
+    if (result.skipped) {
+        line << "skipped (" << juce::String(result.skipReason) << ")";
+    } else {
+        line << formatNs(result.medianNs).paddedLeft(' ', 12)
+             << formatNs(result.p95Ns).paddedLeft(' ', 12)
+             << formatRate(result).paddedLeft(' ', 18);
+        for (const auto& [name, value] : result.counters) {
+            line << "  " << juce::String(name) << "=" << juce::String(value, 2);
+        }
+    }
+    std::cout << line << "\n" << std::flush;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    // Message manager for the SDK's async callbacks and the preset index
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i) args.add(juce::String::fromUTF8(argv[i]));
+
+    Options options;
+    if (!parseOptions(args, options)) {
+        printUsage();
+        return 2;
+    }
+
+    Registry registry;
+    registerActivationBenchmarks(registry);
+    registerDownloadBenchmarks(registry);
+    registerPresetBenchmarks(registry);
+    registerStateBenchmarks(registry);
+    registerProcessBlockBenchmarks(registry);
+
+    if (options.listOnly) {
+        for (const auto& entry : registry.getEntries()) {
+            if (matchesFilter(entry.name, options.filter)) std::cout << entry.name << "\n";
+        }
+        return 0;
+    }
+
+    std::cout << juce::String("benchmark").paddedRight(' ', 52)
+              << juce::String("median").paddedLeft(' ', 12)
+              << juce::String("p95").paddedLeft(' ', 12)
+              << juce::String("throughput").paddedLeft(' ', 18) << "\n";
+
+    std::vector<Result> results;
+    for (const auto& entry : registry.getEntries()) {
+        if (!matchesFilter(entry.name, options.filter)) continue;
+
+        State state(options.minSeconds);
+        entry.fn(state);
+        results.push_back(state.finish(entry.name));
+        printRow(results.back());
+    }
+
+    if (options.jsonFile != juce::File()) {
+        if (!options.jsonFile.replaceWithText(juce::JSON::toString(toJson(results)))) {
+            std::cerr << "Could not write " << options.jsonFile.getFullPathName() << "\n";
+            return 2;
+        }
+        std::cout << "\nWrote " << options.jsonFile.getFullPathName() << "\n";
+    }
+
+    if (options.baselineFile != juce::File()) {
+        auto baseline = juce::JSON::parse(options.baselineFile);
+        if (!baseline.isObject()) {
+            std::cerr << "Could not read baseline " << options.baselineFile.getFullPathName() << "\n";
+            return 2;
+        }
+
+        auto regressions = compareWithBaseline(results, baseline, options.maxRegressionPercent);
+        if (regressions > 0) {
+            std::cout << "\n" << regressions << " benchmark(s) regressed by more than "
+                      << options.maxRegressionPercent << "%\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
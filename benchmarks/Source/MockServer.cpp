@@ -0,0 +1,274 @@
+/**
+ * Mock Asset Server - Implementation
+ */
+
+#include "MockServer.h"
+
+#include <algorithm>
+
+namespace beatconnect::bench {
+
+namespace {
+
+constexpr int patternSize = 1024 * 1024;
+constexpr int chunkSize = 64 * 1024;
+constexpr int maxHeaderBytes = 16 * 1024;
+constexpr int socketTimeoutMs = 10000;
+
+bool writeAll(juce::StreamingSocket& socket, const char* data, int size) {
+    while (size > 0) {
+        auto written = socket.write(data, size);
+        if (written <= 0) return false;  // Client went away (e.g. cancelled)
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool writeAll(juce::StreamingSocket& socket, const juce::String& text) {
+    return writeAll(socket, text.toRawUTF8(), (int)text.getNumBytesAsUTF8());
+}
+
+juce::String etagFor(const std::string& id, int64_t size) {
+    return "\"" + juce::String(id) + "-" + juce::String(size) + "\"";
+}
+
+} // namespace
+
+MockAssetServer::MockAssetServer() : juce::Thread("MockAssetServer"), pool(16) {
+    pattern.resize(patternSize);
+    for (int i = 0; i < patternSize; ++i) {
+        pattern[(size_t)i] = (char)(((uint32_t)i * 2654435761u) >> 24);
+    }
+
+    running = listener.createListener(0, "127.0.0.1");
+    if (running) startThread();
+}
+
+MockAssetServer::~MockAssetServer() {
+    signalThreadShouldExit();
+    listener.close();  // Wakes waitForNextConnection()
+    stopThread(5000);
+    pool.removeAllJobs(true, 10000);
+}
+
+std::string MockAssetServer::getBaseUrl() const {
+    return "http://127.0.0.1:" + std::to_string(listener.getBoundPort());
+}
+
+void MockAssetServer::addAsset(const std::string& id, int64_t size) {
+    std::lock_guard<std::mutex> lock(assetsMutex);
+    assets[id] = size;
+}
+
+void MockAssetServer::addPack(const std::string& id, const std::vector<std::string>& assetIds) {
+    std::lock_guard<std::mutex> lock(assetsMutex);
+    packs[id] = assetIds;
+}
+
+int64_t MockAssetServer::findAsset(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(assetsMutex);
+    auto found = assets.find(id);
+    return found != assets.end() ? found->second : -1;
+}
+
+void MockAssetServer::run() {
+    while (!threadShouldExit()) {
+        std::shared_ptr<juce::StreamingSocket> socket(listener.waitForNextConnection());
+        if (socket == nullptr) {
+            if (threadShouldExit() || !listener.isConnected()) return;
+            continue;
+        }
+
+        pool.addJob([this, socket] { handle(*socket); });
+    }
+}
+
+void MockAssetServer::handle(juce::StreamingSocket& socket) {
+    Request request;
+    if (!readRequest(socket, request)) return;
+
+    // /content/<id>/info, /content/<id>/download-url, /files/<id>,
+    // /content/packs/<id>/manifest
+    auto parts = juce::StringArray::fromTokens(request.path, "/", "");
+    parts.removeEmptyStrings();
+
+    if (parts.size() == 2 && parts[0] == "files" && request.method == "GET") {
+        auto id = parts[1].toStdString();
+        auto size = findAsset(id);
+        if (size >= 0) {
+            sendFile(socket, id, size, request);
+            return;
+        }
+    } else if (parts.size() == 4 && parts[0] == "content" && parts[1] == "packs"
+               && parts[3] == "manifest" && request.method == "GET") {
+        if (sendPackManifest(socket, juce::URL::removeEscapeChars(parts[2]).toStdString())) return;
+    } else if (parts.size() == 3 && parts[0] == "content" && parts[1] != "batch") {
+        auto id = parts[1].toStdString();
+        auto size = findAsset(id);
+        const auto url = juce::String(getBaseUrl()) + "/files/" + parts[1];
+
+        if (size >= 0 && parts[2] == "info") {
+            juce::DynamicObject::Ptr info = new juce::DynamicObject();
+            info->setProperty("id", parts[1]);
+            info->setProperty("name", parts[1] + ".bin");
+            info->setProperty("type", "sample");
+            info->setProperty("mime_type", "application/octet-stream");
+            info->setProperty("file_size", (juce::int64)size);
+            info->setProperty("download_url", url);
+            sendJson(socket, juce::var(info.get()));
+            return;
+        }
+
+        if (size >= 0 && parts[2] == "download-url") {
+            juce::DynamicObject::Ptr body = new juce::DynamicObject();
+            body->setProperty("url", url);
+            sendJson(socket, juce::var(body.get()));
+            return;
+        }
+    }
+
+    sendStatus(socket, 404, "Not Found");
+}
+
+bool MockAssetServer::readRequest(juce::StreamingSocket& socket, Request& request) {
+    juce::MemoryBlock received;
+    char buffer[4096];
+
+    // Headers
+    int headerEnd = -1;
+    while (headerEnd < 0) {
+        if (socket.waitUntilReady(true, socketTimeoutMs) != 1) return false;
+
+        auto bytes = socket.read(buffer, (int)sizeof(buffer), false);
+        if (bytes <= 0) return false;
+        received.append(buffer, (size_t)bytes);
+
+        auto text = juce::String::fromUTF8((const char*)received.getData(), (int)received.getSize());
+        headerEnd = text.indexOf("\r\n\r\n");
+        if (headerEnd < 0 && (int)received.getSize() > maxHeaderBytes) return false;
+
+        if (headerEnd >= 0) {
+            auto lines = juce::StringArray::fromLines(text.substring(0, headerEnd));
+            auto requestLine = juce::StringArray::fromTokens(lines[0], " ", "");
+            if (requestLine.size() < 2) return false;
+
+            request.method = requestLine[0];
+            request.path = requestLine[1].upToFirstOccurrenceOf("?", false, false);
+
+            for (int i = 1; i < lines.size(); ++i) {
+                request.headers.set(lines[i].upToFirstOccurrenceOf(":", false, false).trim(),
+                                    lines[i].fromFirstOccurrenceOf(":", false, false).trim());
+            }
+        }
+    }
+
+    // Drain any body (batch POSTs) so closing doesn't reset the connection
+    // before the client has read the response
+    auto bodyBytes = request.headers.getValue("Content-Length", "0").getLargeIntValue();
+    auto alreadyRead = (juce::int64)received.getSize() - (headerEnd + 4);
+    while (alreadyRead < bodyBytes) {
+        if (socket.waitUntilReady(true, socketTimeoutMs) != 1) return false;
+        auto bytes = socket.read(buffer, (int)sizeof(buffer), false);
+        if (bytes <= 0) return false;
+        alreadyRead += bytes;
+    }
+    return true;
+}
+
+void MockAssetServer::sendJson(juce::StreamingSocket& socket, const juce::var& body) {
+    auto json = juce::JSON::toString(body, true);
+    writeAll(socket, "HTTP/1.1 200 OK\r\n"
+                     "Content-Type: application/json\r\n"
+                     "Content-Length: " + juce::String((int)json.getNumBytesAsUTF8()) + "\r\n"
+                     "Connection: close\r\n\r\n" + json);
+}
+
+bool MockAssetServer::sendPackManifest(juce::StreamingSocket& socket, const std::string& id) {
+    juce::Array<juce::var> files;
+    {
+        std::lock_guard<std::mutex> lock(assetsMutex);
+        auto pack = packs.find(id);
+        if (pack == packs.end()) return false;
+
+        for (const auto& assetId : pack->second) {
+            auto asset = assets.find(assetId);
+            if (asset == assets.end()) continue;
+
+            juce::DynamicObject::Ptr file = new juce::DynamicObject();
+            file->setProperty("path", juce::String(assetId) + ".bin");
+            file->setProperty("size", (juce::int64)asset->second);
+            file->setProperty("asset_id", juce::String(assetId));
+            files.add(juce::var(file.get()));
+        }
+    }
+
+    juce::DynamicObject::Ptr body = new juce::DynamicObject();
+    body->setProperty("version", "1.0.0");
+    body->setProperty("files", files);
+    sendJson(socket, juce::var(body.get()));
+    return true;
+}
+
+void MockAssetServer::sendStatus(juce::StreamingSocket& socket, int status, const char* reason) {
+    writeAll(socket, "HTTP/1.1 " + juce::String(status) + " " + reason + "\r\n"
+                     "Content-Length: 0\r\n"
+                     "Connection: close\r\n\r\n");
+}
+
+void MockAssetServer::sendFile(juce::StreamingSocket& socket, const std::string& id, int64_t size,
+                               const Request& request) {
+    const auto etag = etagFor(id, size);
+
+    // Range: bytes=<start>-[<end>], ignored when If-Range names another version
+    int64_t start = 0;
+    int64_t end = size - 1;
+    bool partial = false;
+
+    auto range = request.headers.getValue("Range", {});
+    auto ifRange = request.headers.getValue("If-Range", {});
+    if (range.startsWith("bytes=") && (ifRange.isEmpty() || ifRange == etag)) {
+        auto spec = range.fromFirstOccurrenceOf("=", false, false);
+        start = spec.upToFirstOccurrenceOf("-", false, false).getLargeIntValue();
+        auto last = spec.fromFirstOccurrenceOf("-", false, false).trim();
+        if (last.isNotEmpty()) end = std::min(end, (int64_t)last.getLargeIntValue());
+
+        if (start > end || start >= size) {
+            writeAll(socket, "HTTP/1.1 416 Range Not Satisfiable\r\n"
+                             "Content-Range: bytes */" + juce::String(size) + "\r\n"
+                             "Content-Length: 0\r\n"
+                             "Connection: close\r\n\r\n");
+            return;
+        }
+
+        partial = true;
+        rangeRequests.fetch_add(1);
+    }
+
+    const auto length = end - start + 1;
+    juce::String head;
+    head << (partial ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n")
+         << "Content-Type: application/octet-stream\r\n"
+         << "Content-Length: " << length << "\r\n"
+         << "Accept-Ranges: bytes\r\n"
+         << "ETag: " << etag << "\r\n";
+    if (partial) {
+        head << "Content-Range: bytes " << start << "-" << end << "/" << size << "\r\n";
+    }
+    head << "Connection: close\r\n\r\n";
+
+    if (!writeAll(socket, head)) return;
+
+    auto offset = start;
+    while (offset <= end) {
+        const auto patternOffset = (int)(offset % patternSize);
+        const auto count = (int)std::min<int64_t>({ (int64_t)chunkSize, end - offset + 1,
+                                                    (int64_t)(patternSize - patternOffset) });
+        if (!writeAll(socket, pattern.data() + patternOffset, count)) return;
+
+        offset += count;
+        bytesServed.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+} // namespace beatconnect::bench
@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * Mock Asset Server
+ *
+ * Local HTTP/1.1 server standing in for the BeatConnect content API and R2
+ * for the download benchmarks, so they measure the downloader rather than
+ * the internet:
+ *
+ *   GET /content/<id>/info           asset info JSON (name, file_size, download_url)
+ *   GET /content/<id>/download-url   { "url": ".../files/<id>" }
+ *   GET /files/<id>                  the asset's bytes; honors Range / If-Range
+ *   GET /content/packs/<id>/manifest pack manifest listing its assets
+ *
+ * Batch endpoints answer 404, which is the downloader's cue to fall back to
+ * per-asset requests. Asset bytes are a repeating pattern generated once,
+ * so serving never touches the disk. One connection per request
+ * (Connection: close), each handled on its own pool thread.
+ */
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace beatconnect::bench {
+
+class MockAssetServer : private juce::Thread {
+public:
+    MockAssetServer();
+    ~MockAssetServer() override;
+
+    /** False if no local port could be bound. */
+    bool isRunning() const { return running; }
+
+    /** http://127.0.0.1:<port> - use as DownloaderConfig::apiBaseUrl. */
+    std::string getBaseUrl() const;
+
+    /** Serve an asset of size bytes under id. */
+    void addAsset(const std::string& id, int64_t size);
+
+    /** Serve a pack of previously added assets, one file "<assetId>.bin" each. */
+    void addPack(const std::string& id, const std::vector<std::string>& assetIds);
+
+    int64_t getBytesServed() const { return bytesServed.load(); }
+    int getRangeRequests() const { return rangeRequests.load(); }
+
+private:
+    struct Request {
+        juce::String method;
+        juce::String path;
+        juce::StringPairArray headers;
+    };
+
+    void run() override;
+    void handle(juce::StreamingSocket& socket);
+    bool readRequest(juce::StreamingSocket& socket, Request& request);
+
+    void sendJson(juce::StreamingSocket& socket, const juce::var& body);
+    void sendStatus(juce::StreamingSocket& socket, int status, const char* reason);
+    void sendFile(juce::StreamingSocket& socket, const std::string& id, int64_t size, const Request& request);
+    bool sendPackManifest(juce::StreamingSocket& socket, const std::string& id);
+
+    int64_t findAsset(const std::string& id) const;
+
+    juce::StreamingSocket listener;
+    juce::ThreadPool pool;
+    bool running = false;
+
+    std::vector<char> pattern;
+
+    mutable std::mutex assetsMutex;
+    std::map<std::string, int64_t> assets;
+    std::map<std::string, std::vector<std::string>> packs;
+
+    std::atomic<int64_t> bytesServed { 0 };
+    std::atomic<int> rangeRequests { 0 };
+};
+
+} // namespace beatconnect::bench
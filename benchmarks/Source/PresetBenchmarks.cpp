@@ -0,0 +1,143 @@
+/**
+ * Preset Benchmarks
+ *
+ * The template's PresetManager with thousands of user presets: building the
+ * index with and without last session's cache, the list/search/page calls
+ * the web UI makes, and recalling a preset. Presets go to a uniquely named
+ * folder under the system temp directory, removed afterwards, so the user's
+ * own presets are never touched.
+ */
+
+#include "Benchmark.h"
+#include "PluginProcessor.h"
+#include "PresetManager.h"
+
+#include <optional>
+#include <thread>
+
+namespace beatconnect::bench {
+
+namespace {
+
+const juce::StringArray categories { "Bass", "Drums", "Keys", "Pads", "FX" };
+
+struct PresetFixture {
+    BenchTemplateProcessor processor;
+    juce::String pluginName = "BeatConnectBench";
+    juce::File dataDirectory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                   .getChildFile("BeatConnectBench-" + juce::Uuid().toString());
+    std::optional<PresetManager> manager;
+    int count;
+
+    explicit PresetFixture(int presetCount) : count(presetCount) {
+        open();
+
+        auto& apvts = processor.getAPVTS();
+        for (int i = 0; i < count; ++i) {
+            apvts.getParameter("gain")->setValueNotifyingHost((float)(i % 100) / 100.0f);
+            manager->saveUserPreset(getName(i), { "bench", "tag" + juce::String(i % 10) },
+                                    categories[i % categories.size()]);
+        }
+
+        close();
+    }
+
+    ~PresetFixture() {
+        manager.reset();
+        dataDirectory.deleteRecursively();
+    }
+
+    static juce::String getName(int index) {
+        return "Preset " + juce::String(index).paddedLeft('0', 5);
+    }
+
+    /** Construct the manager and wait for its first scan. */
+    void open() {
+        manager.emplace(processor.getAPVTS(), pluginName, dataDirectory);
+        while (!manager->isIndexReady()) std::this_thread::yield();
+    }
+
+    /** Destroy the manager, which writes the index cache. */
+    void close() { manager.reset(); }
+};
+
+} // namespace
+
+void registerPresetBenchmarks(Registry& registry) {
+    for (int count : { 1000, 5000 }) {
+        const auto suffix = "/" + std::to_string(count);
+
+        // ======================================================================
+        // Index
+        // ======================================================================
+
+        // First launch, or a lost cache: every preset file is parsed
+        registry.add("presets/index/cold" + suffix, [count](State& state) {
+            PresetFixture fixture(count);
+            auto cacheFile = fixture.dataDirectory.getChildFile("UserPresetIndex.json");
+
+            state.setItemsPerCall(count);
+            state.measureEach([&] { fixture.close(); cacheFile.deleteFile(); },
+                              [&] { fixture.open(); });
+        });
+
+        // Usual launch: cache loaded, files only stat'ed
+        registry.add("presets/index/warm" + suffix, [count](State& state) {
+            PresetFixture fixture(count);
+
+            state.setItemsPerCall(count);
+            state.measureEach([&] { fixture.close(); },
+                              [&] { fixture.open(); });
+        });
+
+        // ======================================================================
+        // Listing
+        // ======================================================================
+
+        registry.add("presets/names" + suffix, [count](State& state) {
+            PresetFixture fixture(count);
+            fixture.open();
+            state.measure([&] { juce::ignoreUnused(fixture.manager->getUserPresetNames()); });
+        });
+
+        registry.add("presets/find" + suffix, [count](State& state) {
+            PresetFixture fixture(count);
+            fixture.open();
+            state.measure([&] { juce::ignoreUnused(fixture.manager->findUserPresets("tag7")); });
+        });
+
+        // One page of the web UI's list, and the whole list in one message
+        registry.add("presets/json/page:50" + suffix, [count](State& state) {
+            PresetFixture fixture(count);
+            fixture.open();
+            state.measure([&] { juce::ignoreUnused(fixture.manager->getPresetListAsJson(0, 50)); });
+        });
+
+        registry.add("presets/json/all" + suffix, [count](State& state) {
+            PresetFixture fixture(count);
+            fixture.open();
+            state.measure([&] { juce::ignoreUnused(fixture.manager->getPresetListAsJson()); });
+        });
+
+        // ======================================================================
+        // Recall
+        // ======================================================================
+
+        // Alternates between two presets so every recall changes a parameter
+        registry.add("presets/load" + suffix, [count](State& state) {
+            PresetFixture fixture(count);
+            fixture.open();
+
+            const auto first = PresetFixture::getName(0);
+            const auto second = PresetFixture::getName(count / 2 + 1);
+            if (!fixture.manager->loadPreset(first, false)) return state.skip("preset did not load");
+
+            bool flip = false;
+            state.measure([&] {
+                fixture.manager->loadPreset((flip = !flip) ? second : first, false);
+            });
+        });
+    }
+}
+
+} // namespace beatconnect::bench
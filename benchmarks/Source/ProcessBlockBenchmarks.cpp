@@ -0,0 +1,65 @@
+/**
+ * processBlock Benchmarks
+ *
+ * The template processor's processBlock() at common host buffer sizes,
+ * 48 kHz stereo, with parameters moving so the smoothers stay busy. Reports
+ * realtime_x: how many times faster than the buffer's duration a block runs
+ * (higher is better; 1 would use the whole deadline).
+ */
+
+#include "Benchmark.h"
+#include "PluginProcessor.h"
+
+namespace beatconnect::bench {
+
+namespace {
+
+constexpr double sampleRate = 48000.0;
+constexpr int numChannels = 2;
+
+} // namespace
+
+void registerProcessBlockBenchmarks(Registry& registry) {
+    for (int blockSize : { 32, 64, 128, 256, 512, 1024, 2048 }) {
+        registry.add("processBlock/template/" + std::to_string(blockSize), [blockSize](State& state) {
+            BenchTemplateProcessor processor;
+            processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+
+            juce::AudioBuffer<float> input(numChannels, blockSize);
+            juce::Random random(1234);
+            for (int channel = 0; channel < numChannels; ++channel) {
+                for (int i = 0; i < blockSize; ++i) {
+                    input.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+                }
+            }
+            juce::AudioBuffer<float> buffer(numChannels, blockSize);
+            juce::MidiBuffer midi;
+
+            auto* gain = processor.getAPVTS().getParameter("gain");
+            auto* mix = processor.getAPVTS().getParameter("mix");
+            int block = 0;
+
+            state.setItemsPerCall(blockSize);
+            state.measure([&] {
+                // A new target every 16 blocks, like slow automation
+                if ((++block & 15) == 0) {
+                    gain->setValueNotifyingHost((float)((block >> 4) % 10) / 10.0f);
+                    mix->setValueNotifyingHost((float)((block >> 4) % 7) / 7.0f);
+                }
+
+                // Fresh input each block (the copy is timed too), so gain
+                // isn't compounded into denormals or infinities
+                buffer.makeCopyOf(input, true);
+                processor.processBlock(buffer, midi);
+            });
+
+            const auto blockNs = (double)blockSize / sampleRate * 1e9;
+            state.setCounter("realtime_x", blockNs / state.getMedianNs());
+
+            processor.releaseResources();
+        });
+    }
+}
+
+} // namespace beatconnect::bench
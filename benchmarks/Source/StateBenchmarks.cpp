@@ -0,0 +1,161 @@
+/**
+ * State Benchmarks
+ *
+ * Plugin state save/restore: the template's get/setStateInformation()
+ * (StateCodec), the XML round trip it replaced as a baseline, and both
+ * again for a large synthetic processor (512 parameters), where the
+ * difference shows up in session save times.
+ */
+
+#include "Benchmark.h"
+#include "PluginProcessor.h"
+
+#include <beatconnect/StateCodec.h>
+
+namespace beatconnect::bench {
+
+namespace {
+
+constexpr juce::uint32 stateVersion = 1;
+
+/** Bare processor with many float parameters and no audio. */
+class LargeStateProcessor : public juce::AudioProcessor {
+public:
+    explicit LargeStateProcessor(int numParameters)
+        : apvts(*this, nullptr, "Parameters", createLayout(numParameters)) {}
+
+    static juce::AudioProcessorValueTreeState::ParameterLayout createLayout(int numParameters) {
+        juce::AudioProcessorValueTreeState::ParameterLayout layout;
+        for (int i = 0; i < numParameters; ++i) {
+            auto id = "param" + juce::String(i);
+            layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { id, 1 }, id,
+                juce::NormalisableRange<float>(0.0f, 1.0f), (float)(i % 7) / 7.0f));
+        }
+        return layout;
+    }
+
+    juce::AudioProcessorValueTreeState apvts;
+
+    const juce::String getName() const override { return "LargeState"; }
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+    using AudioProcessor::processBlock;
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+};
+
+// The getStateInformation() every plugin had before StateCodec
+void writeXml(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& dest) {
+    auto xml = apvts.copyState().createXml();
+    xml->setAttribute("stateVersion", (int)stateVersion);
+    juce::AudioProcessor::copyXmlToBinary(*xml, dest);
+}
+
+void readXml(juce::AudioProcessorValueTreeState& apvts, const juce::MemoryBlock& data) {
+    if (auto xml = juce::AudioProcessor::getXmlFromBinary(data.getData(), (int)data.getSize())) {
+        apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    }
+}
+
+void registerCodecBenchmarks(Registry& registry, const std::string& prefix,
+                             const std::function<std::unique_ptr<juce::AudioProcessor>()>& create,
+                             const std::function<juce::AudioProcessorValueTreeState&(juce::AudioProcessor&)>& getState) {
+    registry.add(prefix + "/codec/write", [=](State& state) {
+        auto processor = create();
+        auto& apvts = getState(*processor);
+
+        juce::MemoryBlock block;
+        StateCodec::write(apvts, block, stateVersion);
+        state.setBytesPerCall((int64_t)block.getSize());
+        state.measure([&] { StateCodec::write(apvts, block, stateVersion); });
+    });
+
+    registry.add(prefix + "/codec/read", [=](State& state) {
+        auto processor = create();
+        auto& apvts = getState(*processor);
+
+        juce::MemoryBlock block;
+        StateCodec::write(apvts, block, stateVersion);
+        state.setBytesPerCall((int64_t)block.getSize());
+        state.measure([&] { StateCodec::read(apvts, block.getData(), (int)block.getSize()); });
+    });
+
+    registry.add(prefix + "/codec/write/zlib", [=](State& state) {
+        auto processor = create();
+        auto& apvts = getState(*processor);
+
+        juce::MemoryBlock block;
+        StateCodec::write(apvts, block, stateVersion, StateCodec::Compression::zlib);
+        state.setBytesPerCall((int64_t)block.getSize());
+        state.measure([&] { StateCodec::write(apvts, block, stateVersion, StateCodec::Compression::zlib); });
+    });
+
+    registry.add(prefix + "/xml/write", [=](State& state) {
+        auto processor = create();
+        auto& apvts = getState(*processor);
+
+        juce::MemoryBlock block;
+        writeXml(apvts, block);
+        state.setBytesPerCall((int64_t)block.getSize());
+        state.measure([&] {
+            block.reset();
+            writeXml(apvts, block);
+        });
+    });
+
+    registry.add(prefix + "/xml/read", [=](State& state) {
+        auto processor = create();
+        auto& apvts = getState(*processor);
+
+        juce::MemoryBlock block;
+        writeXml(apvts, block);
+        state.setBytesPerCall((int64_t)block.getSize());
+        state.measure([&] { readXml(apvts, block); });
+    });
+}
+
+} // namespace
+
+void registerStateBenchmarks(Registry& registry) {
+    // What hosts actually call on the template
+    registry.add("state/template/getStateInformation", [](State& state) {
+        BenchTemplateProcessor processor;
+        juce::MemoryBlock block;
+        processor.getStateInformation(block);
+        state.setBytesPerCall((int64_t)block.getSize());
+        state.measure([&] { processor.getStateInformation(block); });
+    });
+
+    registry.add("state/template/setStateInformation", [](State& state) {
+        BenchTemplateProcessor processor;
+        juce::MemoryBlock block;
+        processor.getStateInformation(block);
+        state.setBytesPerCall((int64_t)block.getSize());
+        state.measure([&] { processor.setStateInformation(block.getData(), (int)block.getSize()); });
+    });
+
+    registerCodecBenchmarks(registry, "state/template",
+        [] { return std::make_unique<BenchTemplateProcessor>(); },
+        [](juce::AudioProcessor& p) -> juce::AudioProcessorValueTreeState& {
+            return static_cast<BenchTemplateProcessor&>(p).getAPVTS();
+        });
+
+    registerCodecBenchmarks(registry, "state/params:512",
+        [] { return std::make_unique<LargeStateProcessor>(512); },
+        [](juce::AudioProcessor& p) -> juce::AudioProcessorValueTreeState& {
+            return static_cast<LargeStateProcessor&>(p).apvts;
+        });
+}
+
+} // namespace beatconnect::bench
@@ -0,0 +1,24 @@
+/*
+  ==============================================================================
+    {{PLUGIN_NAME}} - Benchmark stand-in for the template's editor
+
+    Configured as PluginEditor.h next to the instantiated template processor,
+    so PluginProcessor.cpp builds without the WebView (the benchmarks never
+    open an editor).
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+class {{PLUGIN_NAME}}Editor : public juce::GenericAudioProcessorEditor
+{
+public:
+    explicit {{PLUGIN_NAME}}Editor({{PLUGIN_NAME}}Processor& p)
+        : juce::GenericAudioProcessorEditor(p)
+    {
+    }
+};
@@ -16,6 +16,10 @@
 #   BEATCONNECT_USE_WEBUI          - Enable WebView UI (default: auto-detect)
 #   BEATCONNECT_ENABLE_ACTIVATION  - Enable license activation (default: OFF)
 #   BEATCONNECT_DEV_MODE           - Enable hot reload for WebUI (default: OFF)
+#   BEATCONNECT_EMBED_WEBUI        - Embed WebUI as one archive instead of
+#                                    copying Resources/WebUI (default: OFF)
+#   BEATCONNECT_RT_CHECKS          - Report allocations, locks and system calls
+#                                    in processBlock, for QA builds (default: OFF)
 #
 # ==============================================================================
 
@@ -38,6 +42,10 @@ endif()
 
 option(BEATCONNECT_ENABLE_ACTIVATION "Enable BeatConnect license activation" OFF)
 option(BEATCONNECT_DEV_MODE "Enable development mode with hot reload" OFF)
+option(BEATCONNECT_EMBED_WEBUI "Embed the WebUI in the binary as a single archive" OFF)
+
+include(${CMAKE_CURRENT_LIST_DIR}/BeatConnectWebUI.cmake)
+include(${CMAKE_CURRENT_LIST_DIR}/BeatConnectRealtimeChecks.cmake)
 
 # ==============================================================================
 # JUCE Fetch (if not already available)
@@ -112,8 +120,22 @@ function(beatconnect_configure_plugin TARGET_NAME)
             )
         endif()
 
-        # WebUI resource copy commands
-        _beatconnect_setup_webui_copy(${TARGET_NAME})
+        # Embedded archive (production only), otherwise copy Resources/WebUI
+        if(BEATCONNECT_EMBED_WEBUI AND NOT BEATCONNECT_DEV_MODE)
+            _beatconnect_find_webui_dist(WEBUI_DIST)
+            if(WEBUI_DIST)
+                beatconnect_embed_webui(${TARGET_NAME} "${WEBUI_DIST}")
+            else()
+                message(WARNING "[BeatConnect] WebUI enabled but no dist directory found. Run 'npm run build' in web-ui/")
+                target_compile_definitions(${TARGET_NAME} PUBLIC BEATCONNECT_WEBUI_EMBEDDED=0)
+            endif()
+        else()
+            target_compile_definitions(${TARGET_NAME} PUBLIC BEATCONNECT_WEBUI_EMBEDDED=0)
+            _beatconnect_setup_webui_copy(${TARGET_NAME})
+        endif()
+
+        # Cached resource provider (beatconnect_webui)
+        _beatconnect_link_sdk_module(${TARGET_NAME} webui)
     else()
         message(STATUS "[BeatConnect] Configuring ${TARGET_NAME} with native JUCE UI")
         target_compile_definitions(${TARGET_NAME}
@@ -123,6 +145,16 @@ function(beatconnect_configure_plugin TARGET_NAME)
         )
     endif()
 
+    # =========================================================================
+    # Real-time helpers (telemetry) - header-only
+    # =========================================================================
+    _beatconnect_link_sdk_module(${TARGET_NAME} audio)
+
+    # =========================================================================
+    # Editor helpers (adaptive update timer) - header-only
+    # =========================================================================
+    _beatconnect_link_sdk_module(${TARGET_NAME} ui)
+
     # =========================================================================
     # BeatConnect Activation SDK
     # =========================================================================
@@ -133,6 +165,11 @@ function(beatconnect_configure_plugin TARGET_NAME)
     # =========================================================================
     _beatconnect_setup_project_data(${TARGET_NAME})
 
+    # =========================================================================
+    # Real-time safety checks (BEATCONNECT_RT_CHECKS, QA builds only)
+    # =========================================================================
+    beatconnect_enable_rt_checks(${TARGET_NAME})
+
     # =========================================================================
     # Recommended libraries and flags
     # =========================================================================
@@ -146,17 +183,27 @@ function(beatconnect_configure_plugin TARGET_NAME)
 endfunction()
 
 # ==============================================================================
-# Internal: Setup WebUI resource copying
+# Internal: Locate the built WebUI (empty if none)
 # ==============================================================================
-function(_beatconnect_setup_webui_copy TARGET_NAME)
-    # Determine WebUI source directory
+function(_beatconnect_find_webui_dist OUT_VAR)
     if(EXISTS "${CMAKE_SOURCE_DIR}/web-ui/dist")
-        set(WEBUI_DIST "${CMAKE_SOURCE_DIR}/web-ui/dist")
+        set(${OUT_VAR} "${CMAKE_SOURCE_DIR}/web-ui/dist" PARENT_SCOPE)
     elseif(EXISTS "${CMAKE_SOURCE_DIR}/web/dist")
-        set(WEBUI_DIST "${CMAKE_SOURCE_DIR}/web/dist")
+        set(${OUT_VAR} "${CMAKE_SOURCE_DIR}/web/dist" PARENT_SCOPE)
     elseif(EXISTS "${CMAKE_SOURCE_DIR}/Resources/WebUI")
-        set(WEBUI_DIST "${CMAKE_SOURCE_DIR}/Resources/WebUI")
+        set(${OUT_VAR} "${CMAKE_SOURCE_DIR}/Resources/WebUI" PARENT_SCOPE)
     else()
+        set(${OUT_VAR} "" PARENT_SCOPE)
+    endif()
+endfunction()
+
+# ==============================================================================
+# Internal: Setup WebUI resource copying
+# ==============================================================================
+function(_beatconnect_setup_webui_copy TARGET_NAME)
+    # Determine WebUI source directory
+    _beatconnect_find_webui_dist(WEBUI_DIST)
+    if(NOT WEBUI_DIST)
         message(WARNING "[BeatConnect] WebUI enabled but no dist directory found. Run 'npm run build' in web-ui/")
         return()
     endif()
@@ -192,6 +239,30 @@ function(_beatconnect_setup_webui_copy TARGET_NAME)
     endif()
 endfunction()
 
+# ==============================================================================
+# Internal: Add and link an SDK module (sdk/<MODULE>, target beatconnect_<MODULE>)
+# ==============================================================================
+function(_beatconnect_link_sdk_module TARGET_NAME MODULE)
+    set(MODULE_PATHS
+        "${CMAKE_SOURCE_DIR}/beatconnect-sdk/sdk/${MODULE}"
+        "${CMAKE_SOURCE_DIR}/../sdk/${MODULE}"
+        "${CMAKE_SOURCE_DIR}/sdk/${MODULE}"
+    )
+
+    foreach(MODULE_PATH ${MODULE_PATHS})
+        if(EXISTS "${MODULE_PATH}/CMakeLists.txt")
+            if(NOT TARGET beatconnect_${MODULE})
+                add_subdirectory(${MODULE_PATH} ${CMAKE_BINARY_DIR}/beatconnect_${MODULE})
+            endif()
+            target_link_libraries(${TARGET_NAME} PRIVATE beatconnect_${MODULE})
+            message(STATUS "[BeatConnect] ${MODULE} SDK enabled from ${MODULE_PATH}")
+            return()
+        endif()
+    endforeach()
+
+    message(WARNING "[BeatConnect] sdk/${MODULE} not found")
+endfunction()
+
 # ==============================================================================
 # Internal: Setup BeatConnect Activation SDK
 # ==============================================================================
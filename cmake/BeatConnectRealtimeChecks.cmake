@@ -0,0 +1,66 @@
+# ==============================================================================
+# BeatConnectRealtimeChecks.cmake
+# ==============================================================================
+# Opt-in real-time safety instrumentation for QA builds. With
+# BEATCONNECT_RT_CHECKS=ON, code inside a BEATCONNECT_RT_SCOPE (processBlock)
+# reports heap allocations, locks, system calls and blocking SDK calls with a
+# backtrace, plus per-block time against the buffer deadline. See
+# sdk/audio/include/beatconnect/RealtimeChecks.h.
+#
+# Usage:
+#   include(path/to/beatconnect-sdk/cmake/BeatConnectRealtimeChecks.cmake)
+#   beatconnect_enable_rt_checks(MyPlugin)    # No-op unless the option is ON
+#
+#   cmake -B build -DCMAKE_BUILD_TYPE=Debug -DBEATCONNECT_RT_CHECKS=ON
+#
+# Call it after beatconnect_audio (and beatconnect_activation, if used) have
+# been added. Meant for debug/QA builds; don't ship with it on.
+# ==============================================================================
+
+option(BEATCONNECT_RT_CHECKS "Report allocations, locks and system calls inside processBlock (QA builds)" OFF)
+
+set(_BEATCONNECT_RT_CHECKS_SOURCE "${CMAKE_CURRENT_LIST_DIR}/../sdk/audio/src/RealtimeChecks.cpp")
+
+# libc calls routed through the checks on Linux (must match the __wrap_
+# functions in RealtimeChecks.cpp)
+set(_BEATCONNECT_RT_CHECKS_WRAPPED
+    malloc calloc realloc free
+    pthread_mutex_lock pthread_cond_wait pthread_cond_timedwait
+    pthread_rwlock_rdlock pthread_rwlock_wrlock sem_wait
+    nanosleep usleep
+    read write fopen fread fwrite fflush
+)
+
+function(beatconnect_enable_rt_checks TARGET_NAME)
+    if(NOT BEATCONNECT_RT_CHECKS)
+        return()
+    endif()
+
+    if(NOT TARGET beatconnect_audio)
+        message(WARNING "[BeatConnect] BEATCONNECT_RT_CHECKS needs beatconnect_audio (sdk/audio) - checks not enabled")
+        return()
+    endif()
+
+    target_sources(${TARGET_NAME} PRIVATE ${_BEATCONNECT_RT_CHECKS_SOURCE})
+    target_compile_definitions(${TARGET_NAME} PUBLIC BEATCONNECT_RT_CHECKS=1)
+
+    # SDK calls that block report themselves when made from a checked scope
+    if(TARGET beatconnect_activation)
+        target_compile_definitions(beatconnect_activation PRIVATE BEATCONNECT_RT_CHECKS=1)
+        target_link_libraries(beatconnect_activation PRIVATE beatconnect_audio)
+    endif()
+
+    # Linux: wrap libc calls at link time. PUBLIC so the options reach the
+    # format targets (VST3, Standalone) that link JUCE's shared code library.
+    if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+        target_compile_definitions(${TARGET_NAME} PRIVATE BEATCONNECT_RT_CHECKS_WRAP=1)
+        foreach(SYMBOL ${_BEATCONNECT_RT_CHECKS_WRAPPED})
+            target_link_options(${TARGET_NAME} PUBLIC "LINKER:--wrap=${SYMBOL}")
+        endforeach()
+
+        # Bind the plugin's own operator new/delete rather than the host's
+        target_link_options(${TARGET_NAME} PUBLIC "LINKER:-Bsymbolic-functions")
+    endif()
+
+    message(STATUS "[BeatConnect] Real-time checks enabled for ${TARGET_NAME}")
+endfunction()
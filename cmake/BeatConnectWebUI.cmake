@@ -0,0 +1,85 @@
+# ==============================================================================
+# BeatConnectWebUI.cmake
+# ==============================================================================
+# Packs a built web UI (Vite dist/) into a single zip archive and embeds it in
+# the plugin binary, instead of copying a Resources/WebUI folder of loose files
+# next to it. One archive means one blob in the binary, no per-asset file
+# opens on a cold editor open, and deflated entries for a smaller installer.
+#
+# Entries are plain deflate, with no brotli / gzip variants: JUCE's
+# WebBrowserComponent::Resource carries only bytes and a MIME type, with no
+# Content-Encoding, so the browser can't be handed compressed bytes.
+# WebResourceCache::fromArchive() inflates the whole archive onto the heap
+# the first time an editor opens. That memory is the size of the
+# uncompressed dist/ and is held while any editor is open.
+#
+# Usage:
+#   include(path/to/beatconnect-sdk/cmake/BeatConnectWebUI.cmake)
+#   beatconnect_embed_webui(MyPlugin "${CMAKE_SOURCE_DIR}/Resources/WebUI")
+#
+# Defines BEATCONNECT_WEBUI_EMBEDDED=1 and links a MyPlugin_WebUI binary data
+# target with header "WebUIData.h". Serve it from the editor with:
+#
+#   beatconnect::WebResourceCache::fromArchive(WebUIData::WebUI_zip,
+#                                              WebUIData::WebUI_zipSize)
+#
+# This file doubles as the packing script (cmake -P) the build step runs.
+# ==============================================================================
+
+# ==============================================================================
+# Script mode: pack WEBUI_DIST into WEBUI_PACK
+# ==============================================================================
+if(CMAKE_SCRIPT_MODE_FILE AND DEFINED WEBUI_PACK)
+    file(GLOB_RECURSE WEBUI_FILES LIST_DIRECTORIES false RELATIVE "${WEBUI_DIST}" "${WEBUI_DIST}/*")
+    if(NOT WEBUI_FILES)
+        message(FATAL_ERROR "[BeatConnect] ${WEBUI_DIST} is empty. Run 'npm run build' in web-ui/")
+    endif()
+
+    get_filename_component(WEBUI_PACK_DIR "${WEBUI_PACK}" DIRECTORY)
+    file(MAKE_DIRECTORY "${WEBUI_PACK_DIR}")
+
+    # Runs from WEBUI_DIST so entries are stored relative to it. A fixed
+    # timestamp keeps the archive (and so the binary) reproducible.
+    file(ARCHIVE_CREATE
+        OUTPUT "${WEBUI_PACK}"
+        PATHS ${WEBUI_FILES}
+        FORMAT zip
+        MTIME "1980-01-01 00:00:00 UTC"
+    )
+    return()
+endif()
+
+# ==============================================================================
+# beatconnect_embed_webui(<target> <dist dir>)
+# ==============================================================================
+function(beatconnect_embed_webui TARGET_NAME WEBUI_DIST)
+    if(NOT IS_DIRECTORY "${WEBUI_DIST}")
+        message(WARNING "[BeatConnect] Cannot embed WebUI, ${WEBUI_DIST} not found. Run 'npm run build' in web-ui/")
+        target_compile_definitions(${TARGET_NAME} PUBLIC BEATCONNECT_WEBUI_EMBEDDED=0)
+        return()
+    endif()
+
+    set(WEBUI_PACK "${CMAKE_CURRENT_BINARY_DIR}/${TARGET_NAME}_WebUI/WebUI.zip")
+    file(GLOB_RECURSE WEBUI_FILES CONFIGURE_DEPENDS "${WEBUI_DIST}/*")
+
+    add_custom_command(
+        OUTPUT "${WEBUI_PACK}"
+        COMMAND ${CMAKE_COMMAND}
+            -DWEBUI_DIST=${WEBUI_DIST}
+            -DWEBUI_PACK=${WEBUI_PACK}
+            -P "${CMAKE_CURRENT_FUNCTION_LIST_FILE}"
+        WORKING_DIRECTORY "${WEBUI_DIST}"
+        DEPENDS ${WEBUI_FILES} "${CMAKE_CURRENT_FUNCTION_LIST_FILE}"
+        COMMENT "[BeatConnect] Packing WebUI into ${TARGET_NAME}..."
+        VERBATIM
+    )
+
+    juce_add_binary_data(${TARGET_NAME}_WebUI
+        HEADER_NAME "WebUIData.h"
+        NAMESPACE WebUIData
+        SOURCES "${WEBUI_PACK}"
+    )
+    target_link_libraries(${TARGET_NAME} PRIVATE ${TARGET_NAME}_WebUI)
+    target_compile_definitions(${TARGET_NAME} PUBLIC BEATCONNECT_WEBUI_EMBEDDED=1)
+    message(STATUS "[BeatConnect] WebUI embedded from ${WEBUI_DIST}")
+endfunction()
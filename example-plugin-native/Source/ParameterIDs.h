@@ -1,11 +1,32 @@
 #pragma once
 
 /**
- * Parameter IDs - Shared between processor and editor
+ * Parameters - Shared between processor and editor
+ *
+ * Each X(id, spec) line generates the APVTS parameter, its Param enumerator
+ * for cached reads in processBlock and (in the WebView example) its relay.
+ * The id must match the web UI's getSliderState()/getToggleState() calls.
  */
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <beatconnect/ParameterTable.h>
+
+// Gain 0-200%, mix 0-100%
+#define PLUGIN_PARAMETERS(X)                                    \
+    X(gain,   slider("Gain", 0.0f, 2.0f, 0.01f, 1.0f, "%"))      \
+    X(mix,    slider("Mix", 0.0f, 1.0f, 0.01f, 1.0f, "%"))       \
+    X(bypass, toggle("Bypass", false))
+
+enum class Param : size_t
+{
+    PLUGIN_PARAMETERS(BEATCONNECT_PARAMETER_ENUMERATOR)
+};
+
 namespace ParamIDs
 {
-    inline constexpr const char* gain = "gain";
-    inline constexpr const char* mix = "mix";
-    inline constexpr const char* bypass = "bypass";
+    PLUGIN_PARAMETERS(BEATCONNECT_PARAMETER_ID)
 }
+
+inline constexpr std::array kParameters { PLUGIN_PARAMETERS(BEATCONNECT_PARAMETER_SPEC) };
+
+using ParameterTable = beatconnect::ParameterTable<Param, kParameters.size()>;
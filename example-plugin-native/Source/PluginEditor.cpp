@@ -113,25 +113,51 @@ ExamplePluginNativeEditor::ExamplePluginNativeEditor(ExamplePluginNativeProcesso
         apvts, ParamIDs::bypass, bypassButton);
 
     setSize(400, 300);
-    startTimerHz(30);
+    scheduler.start();
 }
 
 ExamplePluginNativeEditor::~ExamplePluginNativeEditor()
 {
-    stopTimer();
+    scheduler.stop();
     setLookAndFeel(nullptr);
 }
 
-void ExamplePluginNativeEditor::timerCallback()
+bool ExamplePluginNativeEditor::updateMeters()
 {
-    // Smooth the level meters
-    float targetIn = processorRef.getInputLevel();
-    float targetOut = processorRef.getOutputLevel();
+    // Fold the frames queued since the last tick into one reading, then
+    // smooth the level meters
+    beatconnect::LevelSummary levels;
+    processorRef.getLevelTelemetry().drain([&levels](const beatconnect::LevelFrame& frame) {
+        levels.add(frame);
+    });
+
+    float targetIn = levels.getInputPeak();
+    float targetOut = levels.getOutputPeak();
+
+    // Repaint a meter only when its fill moves by at least a pixel
+    auto fillHeight = [](const juce::Rectangle<int>& bounds, float level) {
+        return juce::roundToInt(bounds.getHeight() * juce::jlimit(0.0f, 1.0f, level));
+    };
+
+    const int oldIn = fillHeight(inputMeterBounds, displayInputLevel);
+    const int oldOut = fillHeight(outputMeterBounds, displayOutputLevel);
 
     displayInputLevel = displayInputLevel * 0.8f + targetIn * 0.2f;
     displayOutputLevel = displayOutputLevel * 0.8f + targetOut * 0.2f;
 
-    repaint();
+    bool changed = false;
+    if (fillHeight(inputMeterBounds, displayInputLevel) != oldIn)
+    {
+        repaint(inputMeterBounds);
+        changed = true;
+    }
+    if (fillHeight(outputMeterBounds, displayOutputLevel) != oldOut)
+    {
+        repaint(outputMeterBounds);
+        changed = true;
+    }
+
+    return changed;
 }
 
 void ExamplePluginNativeEditor::paint(juce::Graphics& g)
@@ -146,53 +172,54 @@ void ExamplePluginNativeEditor::paint(juce::Graphics& g)
     g.setGradientFill(headerGradient);
     g.fillRect(0, 0, getWidth(), 60);
 
-    // Level meters
-    auto meterArea = getLocalBounds().removeFromRight(40).reduced(10, 80);
-    auto meterWidth = (meterArea.getWidth() - 5) / 2;
-
     // Input meter background
     g.setColour(juce::Colour(0xFF3f3f46));
-    auto inputMeterBounds = meterArea.removeFromLeft(meterWidth).toFloat();
-    g.fillRoundedRectangle(inputMeterBounds, 3.0f);
+    auto inputMeter = inputMeterBounds.toFloat();
+    g.fillRoundedRectangle(inputMeter, 3.0f);
 
     // Input meter fill
-    auto inputFillHeight = inputMeterBounds.getHeight() * juce::jlimit(0.0f, 1.0f, displayInputLevel);
+    auto inputFillHeight = inputMeter.getHeight() * juce::jlimit(0.0f, 1.0f, displayInputLevel);
     g.setColour(juce::Colour(0xFF22c55e));  // Green
     g.fillRoundedRectangle(
-        inputMeterBounds.getX(),
-        inputMeterBounds.getBottom() - inputFillHeight,
-        inputMeterBounds.getWidth(),
+        inputMeter.getX(),
+        inputMeter.getBottom() - inputFillHeight,
+        inputMeter.getWidth(),
         inputFillHeight,
         3.0f);
 
-    meterArea.removeFromLeft(5);  // Spacing
-
     // Output meter background
     g.setColour(juce::Colour(0xFF3f3f46));
-    auto outputMeterBounds = meterArea.toFloat();
-    g.fillRoundedRectangle(outputMeterBounds, 3.0f);
+    auto outputMeter = outputMeterBounds.toFloat();
+    g.fillRoundedRectangle(outputMeter, 3.0f);
 
     // Output meter fill
-    auto outputFillHeight = outputMeterBounds.getHeight() * juce::jlimit(0.0f, 1.0f, displayOutputLevel);
+    auto outputFillHeight = outputMeter.getHeight() * juce::jlimit(0.0f, 1.0f, displayOutputLevel);
     g.setColour(juce::Colour(0xFF6366f1));  // Indigo
     g.fillRoundedRectangle(
-        outputMeterBounds.getX(),
-        outputMeterBounds.getBottom() - outputFillHeight,
-        outputMeterBounds.getWidth(),
+        outputMeter.getX(),
+        outputMeter.getBottom() - outputFillHeight,
+        outputMeter.getWidth(),
         outputFillHeight,
         3.0f);
 
     // Meter labels
     g.setColour(juce::Colour(0xFF71717a));
     g.setFont(10.0f);
-    g.drawText("IN", inputMeterBounds.toNearestInt().translated(0, -15), juce::Justification::centred);
-    g.drawText("OUT", outputMeterBounds.toNearestInt().translated(0, -15), juce::Justification::centred);
+    g.drawText("IN", inputMeterBounds.translated(0, -15), juce::Justification::centred);
+    g.drawText("OUT", outputMeterBounds.translated(0, -15), juce::Justification::centred);
 }
 
 void ExamplePluginNativeEditor::resized()
 {
     auto area = getLocalBounds();
 
+    // Level meters on the right, side by side
+    auto meterArea = area.withLeft(area.getRight() - 40).reduced(10, 80);
+    auto meterWidth = (meterArea.getWidth() - 5) / 2;
+    inputMeterBounds = meterArea.removeFromLeft(meterWidth);
+    meterArea.removeFromLeft(5);  // Spacing
+    outputMeterBounds = meterArea;
+
     // Title at top
     titleLabel.setBounds(area.removeFromTop(60));
 
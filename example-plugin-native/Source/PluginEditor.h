@@ -3,6 +3,7 @@
 #include "PluginProcessor.h"
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_basics/juce_gui_basics.h>
+#include <beatconnect/UpdateScheduler.h>
 
 /**
  * Native JUCE UI Example
@@ -15,8 +16,7 @@
  *
  * No WebView, no React - just JUCE Components.
  */
-class ExamplePluginNativeEditor : public juce::AudioProcessorEditor,
-                                   private juce::Timer
+class ExamplePluginNativeEditor : public juce::AudioProcessorEditor
 {
 public:
     explicit ExamplePluginNativeEditor(ExamplePluginNativeProcessor&);
@@ -26,7 +26,7 @@ public:
     void resized() override;
 
 private:
-    void timerCallback() override;
+    bool updateMeters();
 
     ExamplePluginNativeProcessor& processorRef;
 
@@ -54,11 +54,16 @@ private:
     // Level meters (simple rectangles)
     float displayInputLevel = 0.0f;
     float displayOutputLevel = 0.0f;
+    juce::Rectangle<int> inputMeterBounds;
+    juce::Rectangle<int> outputMeterBounds;
 
     // Parameter attachments (connect UI to APVTS)
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> gainAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> mixAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> bypassAttachment;
 
+    // Meter updates: 30 Hz while they move, slower when static or hidden
+    beatconnect::UpdateScheduler scheduler { *this, [this] { return updateMeters(); } };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ExamplePluginNativeEditor)
 };
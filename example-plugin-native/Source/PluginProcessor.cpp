@@ -1,12 +1,13 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "ParameterIDs.h"
+#include <beatconnect/StateCodec.h>
 
 ExamplePluginNativeProcessor::ExamplePluginNativeProcessor()
     : AudioProcessor(BusesProperties()
                          .withInput("Input", juce::AudioChannelSet::stereo(), true)
                          .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts(*this, nullptr, "Parameters", createParameterLayout())
+      apvts(*this, nullptr, "Parameters", beatconnect::createParameterLayout(kParameters)),
+      params(apvts, kParameters)
 {
 }
 
@@ -14,44 +15,11 @@ ExamplePluginNativeProcessor::~ExamplePluginNativeProcessor()
 {
 }
 
-juce::AudioProcessorValueTreeState::ParameterLayout ExamplePluginNativeProcessor::createParameterLayout()
+void ExamplePluginNativeProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    // Gain: 0-200% (0.0 to 2.0)
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::gain, 1 },
-        "Gain",
-        juce::NormalisableRange<float>(0.0f, 2.0f, 0.01f),
-        1.0f,
-        juce::AudioParameterFloatAttributes().withLabel("%")));
-
-    // Mix: 0-100%
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::mix, 1 },
-        "Mix",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-        1.0f,
-        juce::AudioParameterFloatAttributes().withLabel("%")));
-
-    // Bypass
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::bypass, 1 },
-        "Bypass",
-        false));
-
-    return { params.begin(), params.end() };
-}
-
-void ExamplePluginNativeProcessor::prepareToPlay(double sampleRate, int /*samplesPerBlock*/)
-{
-    // Initialize smoothed values with 20ms ramp time
-    smoothedGain.reset(sampleRate, 0.02);
-    smoothedMix.reset(sampleRate, 0.02);
-
-    // Set initial values
-    smoothedGain.setCurrentAndTargetValue(*apvts.getRawParameterValue(ParamIDs::gain));
-    smoothedMix.setCurrentAndTargetValue(*apvts.getRawParameterValue(ParamIDs::mix));
+    // 20ms ramps, starting from the current values
+    gainMix.prepare(sampleRate, samplesPerBlock, 0.02);
+    gainMix.reset(params.get(Param::gain), params.get(Param::mix));
 }
 
 void ExamplePluginNativeProcessor::releaseResources()
@@ -60,6 +28,7 @@ void ExamplePluginNativeProcessor::releaseResources()
 
 void ExamplePluginNativeProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
+    BEATCONNECT_RT_SCOPE(rtMonitor, buffer.getNumSamples(), getSampleRate());
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -69,45 +38,32 @@ void ExamplePluginNativeProcessor::processBlock(juce::AudioBuffer<float>& buffer
         buffer.clear(i, 0, buffer.getNumSamples());
 
     // Calculate input level
-    float inLevel = 0.0f;
-    for (int ch = 0; ch < totalNumInputChannels; ++ch)
-        inLevel = std::max(inLevel, buffer.getMagnitude(ch, 0, buffer.getNumSamples()));
-    inputLevel.store(inLevel);
+    beatconnect::LevelFrame levels;
+    levels.numSamples = buffer.getNumSamples();
+    beatconnect::measureLevels(buffer.getArrayOfReadPointers(), totalNumInputChannels,
+                               buffer.getNumSamples(), levels.inputPeak, levels.inputRms);
 
     // Check bypass
-    bool bypassed = *apvts.getRawParameterValue(ParamIDs::bypass) > 0.5f;
+    bool bypassed = params.getBool(Param::bypass);
 
     if (bypassed)
     {
-        smoothedGain.setCurrentAndTargetValue(*apvts.getRawParameterValue(ParamIDs::gain));
-        smoothedMix.setCurrentAndTargetValue(*apvts.getRawParameterValue(ParamIDs::mix));
-        outputLevel.store(inLevel);
+        gainMix.reset(params.get(Param::gain), params.get(Param::mix));
+        levels.outputPeak = levels.inputPeak;
+        levels.outputRms = levels.inputRms;
+        levelTelemetry.push(levels);
         return;
     }
 
-    // Update target values
-    smoothedGain.setTargetValue(*apvts.getRawParameterValue(ParamIDs::gain));
-    smoothedMix.setTargetValue(*apvts.getRawParameterValue(ParamIDs::mix));
+    // Smoothed gain and dry/wet: one coefficient ramp per block, then one
+    // vector multiply per channel
+    gainMix.setTargets(params.get(Param::gain), params.get(Param::mix));
+    gainMix.process(buffer.getArrayOfWritePointers(), totalNumInputChannels, buffer.getNumSamples());
 
-    // Process audio
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-    {
-        float gain = smoothedGain.getNextValue();
-        float mix = smoothedMix.getNextValue();
-
-        for (int ch = 0; ch < totalNumInputChannels; ++ch)
-        {
-            float dry = buffer.getSample(ch, sample);
-            float wet = dry * gain;
-            buffer.setSample(ch, sample, dry * (1.0f - mix) + wet * mix);
-        }
-    }
-
-    // Calculate output level
-    float outLevel = 0.0f;
-    for (int ch = 0; ch < totalNumOutputChannels; ++ch)
-        outLevel = std::max(outLevel, buffer.getMagnitude(ch, 0, buffer.getNumSamples()));
-    outputLevel.store(outLevel);
+    // Calculate output level and hand the frame to the editor (never blocks)
+    beatconnect::measureLevels(buffer.getArrayOfReadPointers(), totalNumOutputChannels,
+                               buffer.getNumSamples(), levels.outputPeak, levels.outputRms);
+    levelTelemetry.push(levels);
 }
 
 juce::AudioProcessorEditor* ExamplePluginNativeProcessor::createEditor()
@@ -117,26 +73,20 @@ juce::AudioProcessorEditor* ExamplePluginNativeProcessor::createEditor()
 
 void ExamplePluginNativeProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    xml->setAttribute("stateVersion", kStateVersion);
-    copyXmlToBinary(*xml, destData);
+    beatconnect::StateCodec::write(apvts, destData, kStateVersion);
 }
 
 void ExamplePluginNativeProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState && xmlState->hasTagName(apvts.state.getType()))
-    {
-        int loadedVersion = xmlState->getIntAttribute("stateVersion", 0);
-        apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
-
-        if (loadedVersion != kStateVersion)
+    beatconnect::StateCodec::read(apvts, data, sizeInBytes,
+        [](juce::uint32 loadedVersion, beatconnect::StateValues&)
         {
-            DBG("State version mismatch: loaded " << loadedVersion << ", expected " << kStateVersion);
-        }
-    }
+            if (loadedVersion != (juce::uint32) kStateVersion)
+            {
+                DBG("State version mismatch: loaded " << (int) loadedVersion << ", expected " << kStateVersion);
+                // Could rename or drop stored values here if needed
+            }
+        });
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -2,6 +2,10 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include <beatconnect/Telemetry.h>
+#include <beatconnect/MixKernels.h>
+#include <beatconnect/RealtimeChecks.h>
+#include "ParameterIDs.h"
 
 class ExamplePluginNativeProcessor : public juce::AudioProcessor
 {
@@ -33,22 +37,24 @@ public:
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
-    // Level metering for visualizer
-    float getInputLevel() const { return inputLevel.load(); }
-    float getOutputLevel() const { return outputLevel.load(); }
+    // Level metering for visualizer: one frame per block, drained by the editor
+    using LevelTelemetry = beatconnect::TelemetryChannel<beatconnect::LevelFrame>;
+    LevelTelemetry& getLevelTelemetry() { return levelTelemetry; }
 
 private:
-    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
-
     juce::AudioProcessorValueTreeState apvts;
 
-    // Smoothed parameters
-    juce::SmoothedValue<float> smoothedGain;
-    juce::SmoothedValue<float> smoothedMix;
+    // Cached parameter reads by Param (after apvts, which it's built from)
+    ParameterTable params;
+
+    // Smoothed gain + dry/wet, processed a block at a time
+    beatconnect::GainMix gainMix;
+
+    // Level metering (lock-free, audio thread -> editor)
+    LevelTelemetry levelTelemetry;
 
-    // Level metering
-    std::atomic<float> inputLevel { 0.0f };
-    std::atomic<float> outputLevel { 0.0f };
+    // processBlock checks, active with -DBEATCONNECT_RT_CHECKS=ON
+    beatconnect::RealtimeMonitor rtMonitor;
 
     // State versioning
     static constexpr int kStateVersion = 1;
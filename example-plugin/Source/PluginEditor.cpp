@@ -2,6 +2,12 @@
 #include "PluginEditor.h"
 #include "ParameterIDs.h"
 
+#include <beatconnect/WebResourceCache.h>
+
+#if BEATCONNECT_WEBUI_EMBEDDED
+#include "WebUIData.h"
+#endif
+
 ExamplePluginEditor::ExamplePluginEditor(ExamplePluginProcessor& p)
     : AudioProcessorEditor(&p), processorRef(p)
 {
@@ -16,17 +22,15 @@ ExamplePluginEditor::ExamplePluginEditor(ExamplePluginProcessor& p)
     setSize(800, 500);
     setResizable(false, false);
 
-    startTimerHz(30);
+    scheduler.start();
 }
 
 ExamplePluginEditor::~ExamplePluginEditor()
 {
-    stopTimer();
+    scheduler.stop();
 
     // Clean up attachments BEFORE webView
-    gainAttachment.reset();
-    mixAttachment.reset();
-    bypassAttachment.reset();
+    relays.detach();
 
     webView.reset();
 }
@@ -34,11 +38,9 @@ ExamplePluginEditor::~ExamplePluginEditor()
 void ExamplePluginEditor::setupWebView()
 {
     // ===========================================================================
-    // STEP 1: Create relays BEFORE WebBrowserComponent
+    // STEP 1: Relays exist BEFORE WebBrowserComponent
     // ===========================================================================
-    gainRelay = std::make_unique<juce::WebSliderRelay>(ParamIDs::gain);
-    mixRelay = std::make_unique<juce::WebSliderRelay>(ParamIDs::mix);
-    bypassRelay = std::make_unique<juce::WebToggleButtonRelay>(ParamIDs::bypass);
+    // relays already holds one per parameter in PLUGIN_PARAMETERS
 
     // ===========================================================================
     // STEP 2: Find resources directory (handle multiple locations)
@@ -54,45 +56,21 @@ void ExamplePluginEditor::setupWebView()
 
     DBG("Resources dir: " + resourcesDir.getFullPathName());
 
+#if BEATCONNECT_WEBUI_EMBEDDED
+    auto webResources = beatconnect::WebResourceCache::fromArchive(
+        WebUIData::WebUI_zip, (size_t) WebUIData::WebUI_zipSize);
+#else
+    auto webResources = beatconnect::WebResourceCache::forDirectory(resourcesDir);
+#endif
+
     // ===========================================================================
     // STEP 3: Build WebBrowserComponent options
     // ===========================================================================
-    auto options = juce::WebBrowserComponent::Options()
+    // Register relays
+    auto options = beatconnect::withVisualizerTransport(relays.withOptions(juce::WebBrowserComponent::Options()), visualizer)
         .withBackend(juce::WebBrowserComponent::Options::Backend::webview2)
         .withNativeIntegrationEnabled()
-        .withResourceProvider(
-            [this](const juce::String& url) -> std::optional<juce::WebBrowserComponent::Resource>
-            {
-                auto path = url;
-                if (path.startsWith("/")) path = path.substring(1);
-                if (path.isEmpty()) path = "index.html";
-
-                auto file = resourcesDir.getChildFile(path);
-                if (!file.existsAsFile()) return std::nullopt;
-
-                juce::String mimeType = "application/octet-stream";
-                if (path.endsWith(".html")) mimeType = "text/html";
-                else if (path.endsWith(".css")) mimeType = "text/css";
-                else if (path.endsWith(".js")) mimeType = "application/javascript";
-                else if (path.endsWith(".json")) mimeType = "application/json";
-                else if (path.endsWith(".png")) mimeType = "image/png";
-                else if (path.endsWith(".svg")) mimeType = "image/svg+xml";
-                else if (path.endsWith(".woff2")) mimeType = "font/woff2";
-
-                juce::MemoryBlock data;
-                file.loadFileAsData(data);
-
-                return juce::WebBrowserComponent::Resource{
-                    std::vector<std::byte>(
-                        reinterpret_cast<const std::byte*>(data.getData()),
-                        reinterpret_cast<const std::byte*>(data.getData()) + data.getSize()),
-                    mimeType.toStdString()
-                };
-            })
-        // Register relays
-        .withOptionsFrom(*gainRelay)
-        .withOptionsFrom(*mixRelay)
-        .withOptionsFrom(*bypassRelay)
+        .withResourceProvider(beatconnect::makeResourceProvider(webResources))
         // Activation status event (always register, even without activation)
         .withEventListener("getActivationStatus", [this](const juce::var&) {
             juce::DynamicObject::Ptr data = new juce::DynamicObject();
@@ -131,30 +109,23 @@ void ExamplePluginEditor::setupWebView()
 
 void ExamplePluginEditor::setupAttachments()
 {
-    auto& apvts = processorRef.getAPVTS();
-
-    gainAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParamIDs::gain), *gainRelay, nullptr);
-    mixAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParamIDs::mix), *mixRelay, nullptr);
-    bypassAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment>(
-        *apvts.getParameter(ParamIDs::bypass), *bypassRelay, nullptr);
+    relays.attach(processorRef.getAPVTS());
 }
 
-void ExamplePluginEditor::timerCallback()
+bool ExamplePluginEditor::sendVisualizerData()
 {
-    sendVisualizerData();
-}
-
-void ExamplePluginEditor::sendVisualizerData()
-{
-    if (!webView) return;
-
-    juce::DynamicObject::Ptr data = new juce::DynamicObject();
-    data->setProperty("inputLevel", processorRef.getInputLevel());
-    data->setProperty("outputLevel", processorRef.getOutputLevel());
-
-    webView->emitEventIfBrowserIsVisible("visualizerData", juce::var(data.get()));
+    // Fold the frames queued since the last tick into one reading
+    beatconnect::LevelSummary levels;
+    processorRef.getLevelTelemetry().drain([&levels](const beatconnect::LevelFrame& frame) {
+        levels.add(frame);
+    });
+
+    if (!webView || levels.isEmpty()) return false;
+
+    // [inputPeak, outputPeak, inputRms, outputRms], skipped when unchanged
+    const float levelFrame[] = { levels.getInputPeak(), levels.getOutputPeak(),
+                                 levels.getInputRms(), levels.getOutputRms() };
+    return beatconnect::sendVisualizerFrame(*webView, visualizer, "levels", levelFrame, 4);
 }
 
 void ExamplePluginEditor::sendActivationState()
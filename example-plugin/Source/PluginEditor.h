@@ -2,9 +2,11 @@
 
 #include "PluginProcessor.h"
 #include <juce_gui_extra/juce_gui_extra.h>
+#include <beatconnect/VisualizerTransport.h>
+#include <beatconnect/UpdateScheduler.h>
+#include <beatconnect/ParameterRelays.h>
 
-class ExamplePluginEditor : public juce::AudioProcessorEditor,
-                            private juce::Timer
+class ExamplePluginEditor : public juce::AudioProcessorEditor
 {
 public:
     explicit ExamplePluginEditor(ExamplePluginProcessor&);
@@ -16,24 +18,23 @@ public:
 private:
     void setupWebView();
     void setupAttachments();
-    void timerCallback() override;
-    void sendVisualizerData();
+    bool sendVisualizerData();
     void sendActivationState();
 
     ExamplePluginProcessor& processorRef;
 
-    // Parameter relays - created BEFORE WebBrowserComponent
-    std::unique_ptr<juce::WebSliderRelay> gainRelay;
-    std::unique_ptr<juce::WebSliderRelay> mixRelay;
-    std::unique_ptr<juce::WebToggleButtonRelay> bypassRelay;
+    // Parameter relays for every parameter in ParameterIDs.h - created BEFORE
+    // WebBrowserComponent, attached to the APVTS AFTER it
+    beatconnect::ParameterRelays relays { kParameters };
 
-    // Parameter attachments - created AFTER WebBrowserComponent
-    std::unique_ptr<juce::WebSliderParameterAttachment> gainAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> mixAttachment;
-    std::unique_ptr<juce::WebToggleButtonParameterAttachment> bypassAttachment;
+    // Visualizer frames - must outlive webView
+    beatconnect::VisualizerTransport visualizer;
 
     std::unique_ptr<juce::WebBrowserComponent> webView;
     juce::File resourcesDir;
 
+    // Adaptive meter updates - stopped before webView is destroyed
+    beatconnect::UpdateScheduler scheduler { *this, [this] { return sendVisualizerData(); } };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ExamplePluginEditor)
 };
@@ -1,6 +1,6 @@
 import { useState, useEffect, useCallback } from 'react';
 import { useSliderParam, useToggleParam } from './hooks/useJuceParam';
-import { addEventListener, emitEvent, isInJuceWebView } from './lib/juce-bridge';
+import { addEventListener, addVisualizerStreamListener, emitEvent, isInJuceWebView } from './lib/juce-bridge';
 
 // Activation screen component
 function ActivationScreen({ onActivated }: { onActivated: () => void }) {
@@ -60,11 +60,11 @@ function PluginUI() {
   const [levels, setLevels] = useState({ inputLevel: 0, outputLevel: 0 });
 
   useEffect(() => {
-    const unsub = addEventListener('visualizerData', (data: unknown) => {
-      const d = data as { inputLevel?: number; outputLevel?: number };
+    // [inputPeak, outputPeak, inputRms, outputRms]
+    const unsub = addVisualizerStreamListener('levels', (data) => {
       setLevels({
-        inputLevel: d.inputLevel ?? 0,
-        outputLevel: d.outputLevel ?? 0
+        inputLevel: data[0] ?? 0,
+        outputLevel: data[1] ?? 0
       });
     });
     return unsub;
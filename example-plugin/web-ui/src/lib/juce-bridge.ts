@@ -163,3 +163,39 @@ export function emitEvent(event: string, data: unknown): void {
     window.__JUCE__.backend.emitEvent(event, data);
   }
 }
+
+// =============================================================================
+// Visualizer Streams
+// =============================================================================
+// Packed float32 frames sent with beatconnect::sendVisualizerFrame()
+
+type VisualizerCallback = (data: Float32Array, sequence: number) => void;
+const visualizerBuffers = new Map<string, Float32Array>();
+
+function decodeFloat32(base64: string, target: Float32Array | undefined): Float32Array {
+  const binary = atob(base64);
+  const count = binary.length >> 2;
+  const out = target && target.length === count ? target : new Float32Array(count);
+  const bytes = new Uint8Array(out.buffer, out.byteOffset, count * 4);
+  for (let i = 0; i < bytes.length; i++) {
+    bytes[i] = binary.charCodeAt(i);
+  }
+  return out;
+}
+
+// The Float32Array passed to callback is reused between frames
+export function addVisualizerStreamListener(stream: string, callback: VisualizerCallback): () => void {
+  const unsub = addEventListener('__beatconnect__viz', (payload: unknown) => {
+    const frame = payload as { stream: string; seq: number; data: string };
+    if (frame.stream !== stream) return;
+
+    const buffer = decodeFloat32(frame.data, visualizerBuffers.get(stream));
+    visualizerBuffers.set(stream, buffer);
+    callback(buffer, frame.seq);
+  });
+
+  // Unchanged frames aren't sent, so ask for the current one
+  emitEvent('__beatconnect__vizResync', {});
+
+  return unsub;
+}
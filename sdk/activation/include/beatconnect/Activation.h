@@ -90,10 +90,13 @@ struct ActivationConfig {
     // Optional: Timeout for API requests in milliseconds (default: 10000)
     int requestTimeoutMs = 10000;
 
-    // Optional: Whether to validate on startup (default: true)
+    // Optional: Whether to validate on startup (default: true). Runs in the
+    // background a few seconds after creation, and is skipped when
+    // activation.json shows a validation within revalidateIntervalSeconds.
     bool validateOnStartup = true;
 
     // Optional: How often to re-validate in seconds (default: 86400 = 24 hours, 0 = never)
+    // Failed attempts retry with jittered exponential backoff.
     int revalidateIntervalSeconds = 86400;
 
     // Optional: Plugin name for debug logging (e.g., "MyPlugin")
@@ -185,7 +188,8 @@ public:
 
     /**
      * Check if currently activated (fast local check, no network).
-     * Returns cached activation state.
+     * Returns cached activation state; background revalidation keeps it
+     * up to date.
      */
     bool isActivated() const;
 
@@ -195,6 +199,30 @@ public:
      */
     std::optional<ActivationInfo> getActivationInfo() const;
 
+    // =========================================================================
+    // State Change Notification
+    // =========================================================================
+    // Activation state is shared by every instance of this plugin in the
+    // process. Listeners hear about changes made by any of them (activate,
+    // deactivate, background revalidation), so UIs don't need to poll.
+
+    using StateListener = std::function<void(bool isActivated,
+                                             const std::optional<ActivationInfo>& info)>;
+
+    /**
+     * Register a listener for activation state changes.
+     * Called on whichever thread made the change (often not the message
+     * thread). Removed automatically when this instance is destroyed.
+     * @return Id for removeStateListener()
+     */
+    int addStateListener(StateListener listener);
+
+    /**
+     * Stop notifying a listener. A notification already being delivered on
+     * another thread may still complete.
+     */
+    void removeStateListener(int listenerId);
+
     // =========================================================================
     // Activation Operations (Slow - Network Required)
     // =========================================================================
@@ -220,7 +248,8 @@ public:
 
     /**
      * Validate current activation with server.
-     * Updates local cache with server state.
+     * Updates local cache with server state. Concurrent calls for the same
+     * license share one request.
      *
      * @return Status indicating if still valid
      */
@@ -230,6 +259,10 @@ public:
     // Async Operations (Non-blocking)
     // =========================================================================
 
+    // Async work runs on a small thread pool shared by every instance in the
+    // process. Destroying an instance cancels its queued work and waits for
+    // any request it has running, so callbacks never outlive the instance.
+
     using StatusCallback = std::function<void(ActivationStatus)>;
 
     /**
@@ -241,7 +274,9 @@ public:
 
     /**
      * Validate asynchronously.
-     * @param callback Called on completion
+     * If the same license is already being validated (by this or another
+     * instance), joins that request instead of sending another one.
+     * @param callback Called on completion (on a pool thread)
      */
     void validateAsync(StatusCallback callback);
 
@@ -251,7 +286,9 @@ public:
 
     /**
      * Load activation state from disk.
-     * Called automatically on configure() if statePath is set.
+     * Called automatically on configure() if statePath is set. State is
+     * shared by every instance using the same statePath and read once per
+     * process; call this to pick up changes made by another process.
      */
     void loadState();
 
@@ -262,7 +299,7 @@ public:
     void saveState();
 
     /**
-     * Clear all stored activation state.
+     * Clear all stored activation state, for every instance sharing it.
      * Does NOT deactivate on server - use deactivate() for that.
      */
     void clearState();
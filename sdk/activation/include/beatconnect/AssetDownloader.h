@@ -21,6 +21,9 @@
  *
  *   // Download multiple assets
  *   downloader.downloadBatch(assetIds, progressCallback, completionCallback);
+ *
+ *   // Keep a sample pack up to date (only changed files are transferred)
+ *   downloader.syncPack(packId, progressCallback, [](const PackSyncResult& r) { ... });
  */
 
 #include <string>
@@ -44,15 +47,32 @@ enum class DownloadStatus {
     Cancelled,       // Download was cancelled
     AlreadyExists,   // File already exists (skip)
     InvalidUrl,      // Invalid download URL
-    Corrupted        // Downloaded file is corrupted (checksum mismatch)
+    Corrupted,       // Downloaded file is corrupted (checksum mismatch)
+    InProgress       // The same pack is already being synced (syncPack)
 };
 
 const char* downloadStatusToString(DownloadStatus status);
 
+// ==============================================================================
+// Download Priority
+// ==============================================================================
+
+// Order in which waiting transfers get a free slot (see maxConcurrent).
+// Use High for assets the user just asked for, Low for prefetching.
+enum class DownloadPriority {
+    Low,
+    Normal,
+    High
+};
+
 // ==============================================================================
 // Download Progress
 // ==============================================================================
 
+// For batch downloads, assetId/fileName name the file that triggered the
+// update while the byte counts, percent and speed cover the whole batch.
+// Callbacks are coalesced (see DownloaderConfig::progressIntervalMs), and
+// speed/ETA are measured over the last few seconds.
 struct DownloadProgress {
     std::string assetId;
     std::string fileName;
@@ -60,7 +80,22 @@ struct DownloadProgress {
     int64_t totalBytes = 0;
     float percent = 0.0f;          // 0.0 to 100.0
     float speedBytesPerSec = 0.0f;
-    int currentFile = 0;           // For batch downloads
+    float etaSeconds = -1.0f;      // -1 if unknown
+    int currentFile = 0;           // For batch downloads: files finished so far
+    int totalFiles = 0;
+};
+
+// Latest progress of this downloader's most recent report, for polling from
+// a UI timer instead of (or as well as) taking callbacks. No strings, so
+// reading it never allocates or locks.
+struct DownloadProgressSnapshot {
+    bool active = false;           // Any download running on this instance
+    int64_t bytesDownloaded = 0;
+    int64_t totalBytes = 0;
+    float percent = 0.0f;
+    float speedBytesPerSec = 0.0f;
+    float etaSeconds = -1.0f;
+    int currentFile = 0;
     int totalFiles = 0;
 };
 
@@ -75,8 +110,45 @@ struct AssetInfo {
     std::string mimeType;
     int64_t fileSize = 0;
     std::string checksum;          // MD5 or SHA-256
-    std::string downloadUrl;       // Presigned R2 URL
-    int64_t expiresAt = 0;         // URL expiry timestamp
+    std::string downloadUrl;       // Presigned R2 URL (if the server included one)
+    int64_t expiresAt = 0;         // URL expiry, Unix seconds (0 = unknown)
+};
+
+// ==============================================================================
+// Asset Packs
+// ==============================================================================
+
+// One file of a pack, as listed by the pack's remote manifest.
+struct PackFile {
+    std::string path;              // Relative to the pack directory, '/'-separated
+    int64_t size = 0;
+    std::string checksum;          // MD5 or SHA-256 of the content
+    std::string assetId;           // Asset the file is presigned and downloaded as
+};
+
+// What syncPack() does to bring the local copy of a pack up to date.
+// Files whose content is already on disk under another path are moved
+// rather than downloaded again.
+struct PackSyncPlan {
+    std::string packId;
+    std::string version;           // Remote pack version
+    std::string localVersion;      // Version last synced completely, empty if none
+    std::vector<PackFile> toDownload;                            // New or changed
+    std::vector<std::pair<std::string, std::string>> toMove;     // (from, to) paths
+    std::vector<std::string> toDelete;                           // No longer in the pack
+    int unchanged = 0;
+    int64_t bytesToDownload = 0;
+
+    bool isUpToDate() const { return toDownload.empty() && toMove.empty() && toDelete.empty(); }
+};
+
+struct PackSyncResult {
+    DownloadStatus status = DownloadStatus::NetworkError;  // Success once every file is in place
+    std::string localPath;         // The pack directory
+    int downloaded = 0;
+    int moved = 0;
+    int deleted = 0;
+    int failed = 0;
 };
 
 // ==============================================================================
@@ -99,14 +171,66 @@ struct DownloaderConfig {
     // Request timeout in milliseconds
     int requestTimeoutMs = 30000;
 
-    // Whether to verify checksums after download
+    // Whether to verify checksums (SHA-256 or MD5). Hashing runs alongside
+    // the transfer, so verification adds no extra pass over the file.
+    // A mismatch discards the download and reports Corrupted.
     bool verifyChecksums = true;
 
-    // Whether to skip existing files
+    // Whether to skip assets that are already downloaded. A local copy only
+    // counts if its manifest entry matches the server's size and checksum.
     bool skipExisting = true;
 
-    // Maximum concurrent downloads
+    // Maximum concurrent transfers (shared by all downloads on this instance,
+    // or by every instance on the same service when sharedService is set)
     int maxConcurrent = 2;
+
+    // Join the process-wide download service for this pluginId + downloadPath.
+    // Instances on the same service share one manifest and transfer cap, and
+    // identical requests are coalesced into one transfer whose result (and
+    // progress) goes to every caller. A file lock per target keeps separate
+    // host processes from writing the same file at once.
+    bool sharedService = false;
+
+    // Keep interrupted downloads on disk (<file>.download plus a small
+    // <file>.download.json sidecar) and continue them with HTTP Range requests
+    bool resumeDownloads = true;
+
+    // How many times to reconnect after a network failure mid-transfer
+    int maxRetries = 3;
+
+    // Fetch large assets as several parallel byte ranges. Needs the asset's
+    // size from getAssetInfo and a server that honors Range requests (R2
+    // does); falls back to a single stream otherwise.
+    bool segmentedDownloads = false;
+
+    // Assets smaller than this always use a single stream
+    int64_t segmentThresholdBytes = 64 * 1024 * 1024;
+
+    // Parallel ranges per segmented asset (at least 1 MB each)
+    int segmentsPerFile = 4;
+
+    // Cap on combined download bandwidth in bytes per second, 0 = unlimited.
+    // Covers every transfer on this instance, or on the whole service when
+    // sharedService is set (the last configure() sets the rate).
+    int64_t maxBytesPerSecond = 0;
+
+    // Run async and batch transfers on threads at background CPU and I/O
+    // priority, so they yield to the host's disk streaming. Synchronous
+    // download() calls keep the caller's thread priority.
+    bool backgroundPriority = false;
+
+    // Hold transfers while setHostTransportActive(true) is in effect on this
+    // instance (or on any instance of the service in shared mode). Stalled
+    // connections are resumed with Range requests afterwards.
+    bool pauseWhileHostPlaying = false;
+
+    // Minimum time between progress callbacks per transfer (and per batch),
+    // 0 = no time limit. The final update of a file is always reported.
+    int progressIntervalMs = 50;
+
+    // Also report whenever progress has moved this many percent, 0 = off.
+    // With both at 0, every chunk is reported.
+    float progressStepPercent = 0.0f;
 };
 
 // ==============================================================================
@@ -116,6 +240,12 @@ struct DownloaderConfig {
 class AssetDownloader {
 public:
     AssetDownloader();
+
+    /**
+     * Cancels everything and waits for async operations (downloadAsync,
+     * downloadBatch, syncPack) to wind down, including their completion
+     * callbacks. Don't destroy the downloader from one of its callbacks.
+     */
     ~AssetDownloader();
 
     // Prevent copying
@@ -149,11 +279,27 @@ public:
 
     /**
      * Get download URL for an asset.
+     * Presigned URLs are cached per asset until shortly before they expire,
+     * so retries and resumed downloads don't presign again.
      * @param assetId Asset ID
      * @return Presigned download URL or empty string on error
      */
     std::string getDownloadUrl(const std::string& assetId);
 
+    /**
+     * Get info about several assets in one request (per 100 assets).
+     * Falls back to one request per asset if the server has no batch endpoint.
+     * @return One entry per assetId, in the same order (nullopt if not found)
+     */
+    std::vector<std::optional<AssetInfo>> getAssetInfoBatch(const std::vector<std::string>& assetIds);
+
+    /**
+     * Get download URLs for several assets in one request (per 100 assets).
+     * URLs still cached from earlier calls aren't requested again.
+     * @return One URL per assetId, in the same order (empty on error)
+     */
+    std::vector<std::string> getDownloadUrlBatch(const std::vector<std::string>& assetIds);
+
     // =========================================================================
     // Download Operations
     // =========================================================================
@@ -170,7 +316,8 @@ public:
      */
     std::pair<DownloadStatus, std::string> download(
         const std::string& assetId,
-        ProgressCallback progressCallback = nullptr
+        ProgressCallback progressCallback = nullptr,
+        DownloadPriority priority = DownloadPriority::Normal
     );
 
     /**
@@ -179,17 +326,21 @@ public:
     void downloadAsync(
         const std::string& assetId,
         ProgressCallback progressCallback,
-        CompletionCallback completionCallback
+        CompletionCallback completionCallback,
+        DownloadPriority priority = DownloadPriority::Normal
     );
 
     /**
      * Download multiple assets.
-     * Downloads run concurrently up to maxConcurrent limit.
+     * Downloads run concurrently up to maxConcurrent limit, with asset info
+     * and presigned URLs fetched ahead of the transfers that need them.
+     * Progress is reported as one aggregate for the whole batch.
      */
     void downloadBatch(
         const std::vector<std::string>& assetIds,
         ProgressCallback progressCallback,
-        BatchCompletionCallback completionCallback
+        BatchCompletionCallback completionCallback,
+        DownloadPriority priority = DownloadPriority::Normal
     );
 
     /**
@@ -199,7 +350,45 @@ public:
     std::pair<DownloadStatus, std::string> downloadFromUrl(
         const std::string& url,
         const std::string& fileName,
-        ProgressCallback progressCallback = nullptr
+        ProgressCallback progressCallback = nullptr,
+        DownloadPriority priority = DownloadPriority::Normal
+    );
+
+    // =========================================================================
+    // Asset Packs
+    // =========================================================================
+
+    // A pack is a versioned set of files kept under <downloadPath>/<packId>/.
+    // Its remote manifest lists every file's path, size, checksum and asset
+    // ID; a local manifest (.beatconnect-pack.json in the pack directory)
+    // records what is on disk. Syncing transfers only new and changed files,
+    // still concurrent, resumable and verified, so an update costs bandwidth
+    // in proportion to what changed.
+
+    using PackSyncCallback = std::function<void(const PackSyncResult&)>;
+
+    /**
+     * Fetch the pack's remote manifest and diff it against the local copy,
+     * without changing anything on disk.
+     * @return The plan, or nullopt if the remote manifest couldn't be fetched
+     */
+    std::optional<PackSyncPlan> planPackSync(const std::string& packId);
+
+    /**
+     * Bring the local copy of a pack up to date, asynchronously: moves
+     * renamed files, downloads new and changed ones (up to maxConcurrent at
+     * a time, with aggregate progress as for downloadBatch), then deletes
+     * files that left the pack. Deletes wait until every download has
+     * succeeded. Progress is recorded as files finish, so an interrupted or
+     * cancelled sync (cancelAll) continues where it stopped next time.
+     * Completes at once with InProgress if this downloader is already
+     * syncing the pack; that sync's own callback reports the outcome.
+     */
+    void syncPack(
+        const std::string& packId,
+        ProgressCallback progressCallback,
+        PackSyncCallback completionCallback,
+        DownloadPriority priority = DownloadPriority::Normal
     );
 
     // =========================================================================
@@ -212,7 +401,8 @@ public:
     void cancel(const std::string& assetId);
 
     /**
-     * Cancel all active downloads.
+     * Cancel all active downloads, batches and pack syncs. Only stops what
+     * is running now; anything started afterwards runs normally.
      */
     void cancelAll();
 
@@ -221,10 +411,26 @@ public:
      */
     bool isDownloading() const;
 
+    /**
+     * Latest progress, safe to poll from the message thread at any rate.
+     */
+    DownloadProgressSnapshot getProgressSnapshot() const;
+
+    /**
+     * Tell the downloader whether the host is playing or recording. Only a
+     * flag store, so it's safe to call from processBlock every block. Has
+     * an effect when pauseWhileHostPlaying is set.
+     */
+    void setHostTransportActive(bool playingOrRecording);
+
     // =========================================================================
     // Local File Management
     // =========================================================================
 
+    // Downloads are tracked in a manifest (.beatconnect-manifest.json in the
+    // download directory) loaded by configure(). These queries are answered
+    // from memory and don't touch the filesystem.
+
     /**
      * Check if an asset has been downloaded.
      */
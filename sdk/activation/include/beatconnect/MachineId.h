@@ -25,6 +25,8 @@ public:
      *
      * This is deterministic - same machine always returns same ID.
      * Format changes (reinstalls, etc.) don't affect the ID.
+     *
+     * Computed once per process and cached; safe to call from any thread.
      */
     static std::string generate();
 
@@ -34,7 +36,15 @@ public:
      */
     static std::string generateShort();
 
+    /**
+     * Drop the cached ID so the next generate() reads the hardware again.
+     */
+    static void invalidateCache();
+
 private:
+    // Read platform info and hash it (uncached)
+    static std::string compute();
+
     // Platform-specific implementations
     static std::string getWindowsMachineInfo();
     static std::string getMacOSMachineInfo();
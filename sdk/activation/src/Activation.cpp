@@ -7,11 +7,27 @@
 
 #include "beatconnect/Activation.h"
 #include "beatconnect/MachineId.h"
+#include "ActivationState.h"
+#include "HttpClient.h"
+#include "LogWriter.h"
+#include "TaskExecutor.h"
+
+// Blocking calls report themselves inside a processBlock checked by
+// BEATCONNECT_RT_CHECKS (see cmake/BeatConnectRealtimeChecks.cmake)
+#if defined(BEATCONNECT_RT_CHECKS) && BEATCONNECT_RT_CHECKS
+    #include <beatconnect/RealtimeChecks.h>
+#else
+    #define BEATCONNECT_RT_BLOCKING(what) ((void)0)
+#endif
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
-#include <thread>
-#include <fstream>
+#include <future>
+#include <random>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #if __has_include(<juce_core/juce_core.h>)
     #define BEATCONNECT_USE_JUCE 1
@@ -43,53 +59,263 @@ const char* activationStatusToString(ActivationStatus status) {
     return "Unknown status";
 }
 
+// ==============================================================================
+// Validation Coalescing
+// ==============================================================================
+
+namespace {
+
+// Server verdict for one /validate call, before it is applied to an instance
+struct ValidationResponse {
+    ActivationStatus status = ActivationStatus::NetworkError;
+    bool invalidated = false;  // Server says the license is no longer valid
+};
+
+// Everything a /validate call needs, copied so the request can outlive the
+// instance that started it
+struct ValidationRequest {
+    std::shared_ptr<const HttpClient> api;
+    std::string pluginId;
+    std::string code;
+    std::string machineId;
+
+    std::string key() const {
+        return api->getBaseUrl() + '\n' + pluginId + '\n' + code + '\n' + machineId;
+    }
+};
+
+// Client for the Supabase edge functions, auth headers formatted once
+std::shared_ptr<const HttpClient> makeApiClient(const ActivationConfig& config) {
+    // apiBaseUrl is just the Supabase URL (e.g., https://xxx.supabase.co)
+    // We need to add /functions/v1/ to reach edge functions
+    auto client = std::make_shared<HttpClient>(
+        config.apiBaseUrl + "/functions/v1/plugin-activation", config.requestTimeoutMs);
+    if (!config.supabaseKey.empty()) {
+        client->setDefaultHeader("apikey", config.supabaseKey);
+        client->setDefaultHeader("Authorization", "Bearer " + config.supabaseKey);
+    }
+    return client;
+}
+
+// Process-wide: instances validating the same license on the same machine
+// share one in-flight request. Holds no threads, so static lifetime is fine.
+class ValidationCoalescer {
+public:
+    using Listener = std::function<void(const ValidationResponse&)>;
+
+    static ValidationCoalescer& shared() {
+        static ValidationCoalescer instance;
+        return instance;
+    }
+
+    // Blocking: run the request, or wait for the identical one in flight
+    ValidationResponse run(const ValidationRequest& request, TaskExecutor& executor) {
+        std::shared_future<ValidationResponse> pending;
+        bool leading = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = inFlight.find(request.key());
+            if (it != inFlight.end()) {
+                pending = it->second->result;
+            } else {
+                begin(request);
+                leading = true;
+            }
+        }
+
+        if (!leading) {
+            return pending.get();
+        }
+        return complete(request, executor);
+    }
+
+    // Non-blocking: listener is called on the executor (as owner) once the
+    // shared request finishes. Starts the request if none is in flight.
+    void runAsync(const ValidationRequest& request, TaskExecutor& executor,
+                  const void* owner, Listener listener) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = inFlight.find(request.key());
+        auto entry = it != inFlight.end() ? it->second : begin(request);
+        entry->listeners.push_back({owner, std::move(listener)});
+
+        if (it == inFlight.end()) {
+            // Not owned by any instance: others may be waiting on it
+            executor.submit(nullptr, [this, request, &executor] {
+                complete(request, executor);
+            });
+        }
+    }
+
+    // Forget an instance's listeners (it is being destroyed)
+    void detach(const void* owner) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& pair : inFlight) {
+            auto& listeners = pair.second->listeners;
+            listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+                [owner](const auto& l) { return l.first == owner; }), listeners.end());
+        }
+    }
+
+private:
+    struct InFlight {
+        std::promise<ValidationResponse> promise;
+        std::shared_future<ValidationResponse> result;
+        std::vector<std::pair<const void*, Listener>> listeners;
+    };
+
+    // Call with mutex held
+    std::shared_ptr<InFlight> begin(const ValidationRequest& request) {
+        auto entry = std::make_shared<InFlight>();
+        entry->result = entry->promise.get_future().share();
+        inFlight[request.key()] = entry;
+        return entry;
+    }
+
+    // Send the request, publish the result to waiters and listeners
+    ValidationResponse complete(const ValidationRequest& request, TaskExecutor& executor) {
+        auto response = sendValidation(request);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = inFlight.find(request.key());
+        auto entry = it->second;
+        inFlight.erase(it);
+
+        // Submitted under the lock so detach() + cancelAndWait() can't miss one
+        for (auto& listener : entry->listeners) {
+            executor.submit(listener.first,
+                [fn = std::move(listener.second), response] { fn(response); });
+        }
+        entry->promise.set_value(response);
+        return response;
+    }
+
+    static ValidationResponse sendValidation(const ValidationRequest& request);
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<InFlight>> inFlight;
+};
+
+ValidationResponse ValidationCoalescer::sendValidation(const ValidationRequest& request) {
+    ValidationResponse response;
+#if BEATCONNECT_USE_JUCE
+    juce::DynamicObject::Ptr body = new juce::DynamicObject();
+    body->setProperty("code", juce::String(request.code));
+    body->setProperty("plugin_id", juce::String(request.pluginId));
+    body->setProperty("machine_id", juce::String(request.machineId));
+
+    auto jsonBody = juce::JSON::toString(juce::var(body.get()));
+
+    auto reply = request.api->send(HttpRequest::post("/validate", jsonBody.toStdString()));
+    if (!reply.connected()) {
+        response.status = ActivationStatus::NetworkError;
+        return response;
+    }
+
+    auto json = reply.json();
+
+    if (json.isVoid() || !json.getDynamicObject()) {
+        response.status = ActivationStatus::ServerError;
+        return response;
+    }
+
+    auto* obj = json.getDynamicObject();
+
+    // Check for specific errors
+    if (obj->hasProperty("error")) {
+        auto error = obj->getProperty("error").toString().toStdString();
+        if (error.find("revoked") != std::string::npos) {
+            response.status = ActivationStatus::Revoked;
+            response.invalidated = true;
+        } else if (error.find("Invalid") != std::string::npos) {
+            response.status = ActivationStatus::Invalid;
+            response.invalidated = true;
+        } else {
+            response.status = ActivationStatus::ServerError;
+        }
+        return response;
+    }
+
+    // Check valid flag
+    bool isValid = obj->getProperty("valid");
+    response.status = isValid ? ActivationStatus::Valid : ActivationStatus::Invalid;
+    response.invalidated = !isValid;
+#else
+    (void)request;
+    response.status = ActivationStatus::NotConfigured;
+#endif
+    return response;
+}
+
+} // namespace
+
 // ==============================================================================
 // Implementation Class
 // ==============================================================================
 
+// Levels above BEATCONNECT_LOG_LEVEL compile away, and the message isn't
+// even built unless this instance has a log file or callback
+#define BEATCONNECT_ACTIVATION_LOG(level, message)                         \
+    do {                                                                   \
+        if constexpr (LogWriter::isCompiledIn(LogLevel::level)) {          \
+            if (isLogging()) log(LogLevel::level, message);                \
+        }                                                                  \
+    } while (false)
+
 class Activation::Impl {
 public:
     Impl() = default;
-    ~Impl() = default;
+
+    ~Impl() {
+        // Nothing queued or running may touch this instance once it's gone
+        ValidationCoalescer::shared().detach(this);
+        executor->cancelAndWait(this);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int id : stateListenerIds) {
+            state->unsubscribe(id);
+        }
+    }
 
     void setDebugCallback(Activation::DebugCallback callback) {
         std::lock_guard<std::mutex> lock(debugMutex);
+        hasDebugCallback = callback != nullptr;
         debugCallback = callback;
     }
 
-    // Instance-based debug logging (no global state)
-    void debug(const std::string& msg) {
-        // Log to instance's own log file if enabled
-        debugLog("[ActivationSDK] " + msg);
+    std::shared_ptr<LogWriter::Sink> debugLogSink() const {
+        std::lock_guard<std::mutex> lock(debugMutex);
+        return debugSink;
+    }
 
-        // Also call the callback if set
-        Activation::DebugCallback cb;
-        {
-            std::lock_guard<std::mutex> lock(debugMutex);
-            cb = debugCallback;
+    bool isLogging() const {
+        return debugLogSink() != nullptr || hasDebugCallback.load(std::memory_order_relaxed);
+    }
+
+    // Instance-based logging (no global state). Queued for the background
+    // writer; never blocks on the file.
+    void log(LogLevel level, const std::string& msg) {
+        const std::string line = "[ActivationSDK] " + msg;
+
+        if (auto sink = debugLogSink()) {
+            logWriter->write(sink, level, line);
         }
-        if (cb) {
-            cb("[ActivationSDK] " + msg);
+
+        if (hasDebugCallback.load(std::memory_order_relaxed)) {
+            Activation::DebugCallback cb;
+            {
+                std::lock_guard<std::mutex> lock(debugMutex);
+                cb = debugCallback;
+            }
+            if (cb) {
+                cb(line);
+            }
         }
     }
 
     void debugLog(const std::string& msg) {
-        std::lock_guard<std::mutex> lock(debugMutex);
-        if (!debugEnabled || debugLogPath.empty()) return;
-
-#if BEATCONNECT_USE_JUCE
-        std::string timestamp = juce::Time::getCurrentTime()
-            .toString(false, true, true, true).toStdString();
-
-        juce::File logFile(debugLogPath);
-        logFile.appendText("[" + timestamp + "] " + msg + "\n");
-        DBG(juce::String("[BeatConnect] " + msg));
-#else
-        std::ofstream ofs(debugLogPath, std::ios::app);
-        if (ofs.is_open()) {
-            ofs << msg << std::endl;
+        if constexpr (LogWriter::isCompiledIn(LogLevel::info)) {
+            if (auto sink = debugLogSink()) logWriter->write(sink, LogLevel::info, msg);
         }
-#endif
     }
 
     std::string getDebugLogPath() const {
@@ -99,9 +325,10 @@ public:
 
     void revealDebugLog() {
 #if BEATCONNECT_USE_JUCE
-        std::lock_guard<std::mutex> lock(debugMutex);
-        if (!debugLogPath.empty()) {
-            juce::File(debugLogPath).revealToUser();
+        auto path = getDebugLogPath();
+        if (!path.empty()) {
+            logWriter->flush();  // Show the file with everything logged so far
+            juce::File(path).revealToUser();
         }
 #endif
     }
@@ -114,12 +341,19 @@ public:
     // Simple init-time logging (before debug is fully configured)
     void initLog(const std::string& msg) {
 #if BEATCONNECT_USE_JUCE
-        auto logFile = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
-            .getChildFile("BeatConnect")
-            .getChildFile("init.log");
-        logFile.getParentDirectory().createDirectory();
-        logFile.appendText(msg + "\n");
-        DBG(juce::String(msg));
+        if constexpr (LogWriter::isCompiledIn(LogLevel::info)) {
+            if (initSink == nullptr) {
+                auto logFile = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                    .getChildFile("BeatConnect")
+                    .getChildFile("init.log");
+                initSink = logWriter->open(logFile.getFullPathName().toStdString());
+            }
+            logWriter->write(initSink, LogLevel::info, msg);
+        } else {
+            (void)msg;
+        }
+#else
+        (void)msg;
 #endif
     }
 
@@ -131,35 +365,46 @@ public:
         configured = true;
         initLog("[Activation] config set, configured=true");
 
-        // Setup instance-based debug logging
+        // Setup instance-based debug logging. Published under debugMutex:
+        // work queued by an earlier configure() may still be logging.
         {
-            std::lock_guard<std::mutex> lock(debugMutex);
-            debugEnabled = config.enableDebugLogging;
-
             // Determine plugin name for log path
             std::string pluginNameForLog = config.pluginName;
             if (pluginNameForLog.empty()) {
                 pluginNameForLog = config.pluginId;  // Fallback to pluginId
             }
 
+            std::string logPath;
 #if BEATCONNECT_USE_JUCE
             if (!pluginNameForLog.empty()) {
                 auto appData = juce::File::getSpecialLocation(
                     juce::File::userApplicationDataDirectory);
                 auto logDir = appData.getChildFile("BeatConnect")
                                      .getChildFile(juce::String(pluginNameForLog));
-                logDir.createDirectory();
-                debugLogPath = logDir.getChildFile("debug.log")
-                                     .getFullPathName().toStdString();
+                logPath = logDir.getChildFile("debug.log")
+                                .getFullPathName().toStdString();
             }
 #else
-            debugLogPath = pluginNameForLog + "_debug.log";
+            logPath = pluginNameForLog + "_debug.log";
 #endif
 
-            if (debugEnabled && !debugLogPath.empty()) {
-                // Clear log on init when enabled
-                std::ofstream ofs(debugLogPath, std::ios::trunc);
-                ofs << "=== Debug logging initialized for " << pluginNameForLog << " ===" << std::endl;
+            // Instances of the same plugin share the file; the first one
+            // in the process rotates the previous session's log away
+            std::shared_ptr<LogWriter::Sink> sink;
+            if (config.enableDebugLogging && !logPath.empty()) {
+                sink = logWriter->open(logPath);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(debugMutex);
+                debugEnabled = config.enableDebugLogging;
+                debugLogPath = logPath;
+                debugSink = sink;
+            }
+
+            if (sink != nullptr) {
+                logWriter->write(sink, LogLevel::info,
+                                 "=== Debug logging initialized for " + pluginNameForLog + " ===");
             }
         }
 
@@ -182,9 +427,16 @@ public:
             statePath = config.statePath;
         }
 
-        initLog("[Activation] about to call loadState()");
-        loadState();
-        initLog("[Activation] loadState() returned, configure() complete");
+        api = makeApiClient(config);
+
+        // Shared with every instance using the same file; parsed only by the
+        // first one
+        state = SharedActivationState::acquire(statePath);
+        initLog("[Activation] state loaded");
+
+        // Never validate inline: construction must not wait on the network
+        startRevalidationSchedule();
+        initLog("[Activation] configure() complete");
     }
 
     bool isConfigured() const {
@@ -192,34 +444,49 @@ public:
     }
 
     bool isActivated() const {
-        std::lock_guard<std::mutex> lock(mutex);
-        return activated && activationInfo.isValid;
+        return state->snapshot()->isActivated();
     }
 
     std::optional<ActivationInfo> getActivationInfo() const {
-        std::lock_guard<std::mutex> lock(mutex);
-        if (activated) {
-            return activationInfo;
+        auto snapshot = state->snapshot();
+        if (snapshot->activated) {
+            return snapshot->info;
         }
         return std::nullopt;
     }
 
+    int addStateListener(StateListener listener) {
+        int id = state->subscribe([listener](const ActivationSnapshot& snapshot) {
+            std::optional<ActivationInfo> info;
+            if (snapshot.activated) info = snapshot.info;
+            listener(snapshot.isActivated(), info);
+        });
+
+        std::lock_guard<std::mutex> lock(mutex);
+        stateListenerIds.push_back(id);
+        return id;
+    }
+
+    void removeStateListener(int listenerId) {
+        state->unsubscribe(listenerId);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        stateListenerIds.erase(std::remove(stateListenerIds.begin(), stateListenerIds.end(), listenerId),
+                               stateListenerIds.end());
+    }
+
     ActivationStatus activate(const std::string& code) {
         if (!configured) {
-            debug("activate: Not configured");
+            BEATCONNECT_ACTIVATION_LOG(warning, "activate: Not configured");
             return ActivationStatus::NotConfigured;
         }
 
         auto machineId = MachineId::generate();
-        debug("activate: machineId = " + machineId);
+        BEATCONNECT_ACTIVATION_LOG(debug, "activate: machineId = " + machineId);
 
         // Build request
 #if BEATCONNECT_USE_JUCE
-        // apiBaseUrl is just the Supabase URL (e.g., https://xxx.supabase.co)
-        // We need to add /functions/v1/ to reach edge functions
-        juce::String urlStr = juce::String(config.apiBaseUrl) + "/functions/v1/plugin-activation/activate";
-        debug("activate: URL = " + urlStr.toStdString());
-        juce::URL url(urlStr);
+        BEATCONNECT_ACTIVATION_LOG(info, "activate: URL = " + api->getBaseUrl() + "/activate");
 
         juce::DynamicObject::Ptr body = new juce::DynamicObject();
         body->setProperty("code", juce::String(code));
@@ -227,54 +494,44 @@ public:
         body->setProperty("machine_id", juce::String(machineId));
 
         auto jsonBody = juce::JSON::toString(juce::var(body.get()));
-        debug("activate: Request body = " + jsonBody.toStdString());
+        BEATCONNECT_ACTIVATION_LOG(debug, "activate: Request body = " + jsonBody.toStdString());
 
-        juce::URL::InputStreamOptions options(
-            juce::URL::ParameterHandling::inPostData);
-
-        // Build headers with Supabase authentication
-        juce::String headers = "Content-Type: application/json\r\n";
         if (!config.supabaseKey.empty()) {
-            headers += "apikey: " + juce::String(config.supabaseKey) + "\r\n";
-            headers += "Authorization: Bearer " + juce::String(config.supabaseKey) + "\r\n";
-            debug("activate: Using supabaseKey (length=" + std::to_string(config.supabaseKey.length()) + ")");
+            BEATCONNECT_ACTIVATION_LOG(debug, "activate: Using supabaseKey (length=" + std::to_string(config.supabaseKey.length()) + ")");
         } else {
-            debug("activate: WARNING - No supabaseKey configured!");
+            BEATCONNECT_ACTIVATION_LOG(warning, "activate: WARNING - No supabaseKey configured!");
         }
-        options.withExtraHeaders(headers);
-        options.withConnectionTimeoutMs(config.requestTimeoutMs);
-        options.withNumRedirectsToFollow(0);
 
-        url = url.withPOSTData(jsonBody);
+        auto request = HttpRequest::post("/activate", jsonBody.toStdString());
+        request.maxRedirects = 0;
 
-        debug("activate: Creating input stream...");
-        auto stream = url.createInputStream(options);
-        if (!stream) {
-            debug("activate: FAILED - createInputStream returned null (NetworkError)");
+        BEATCONNECT_ACTIVATION_LOG(info, "activate: Sending request...");
+        auto response = api->send(request);
+        if (!response.connected()) {
+            BEATCONNECT_ACTIVATION_LOG(error, "activate: FAILED - no response (NetworkError)");
             return ActivationStatus::NetworkError;
         }
 
-        debug("activate: Reading response...");
-        auto response = stream->readEntireStreamAsString();
-        debug("activate: Response (length=" + std::to_string(response.length()) + "): " + response.toStdString());
+        BEATCONNECT_ACTIVATION_LOG(debug, "activate: Response (status=" + std::to_string(response.statusCode) +
+                                   ", length=" + std::to_string(response.body.length()) + "): " + response.body);
 
-        auto json = juce::JSON::parse(response);
+        auto json = response.json();
 
         if (json.isVoid()) {
-            debug("activate: FAILED - JSON parse returned void (ServerError)");
+            BEATCONNECT_ACTIVATION_LOG(error, "activate: FAILED - JSON parse returned void (ServerError)");
             return ActivationStatus::ServerError;
         }
 
         auto* obj = json.getDynamicObject();
         if (!obj) {
-            debug("activate: FAILED - JSON is not an object (ServerError)");
+            BEATCONNECT_ACTIVATION_LOG(error, "activate: FAILED - JSON is not an object (ServerError)");
             return ActivationStatus::ServerError;
         }
 
         // Check for error
         if (obj->hasProperty("error")) {
             auto error = obj->getProperty("error").toString().toStdString();
-            debug("activate: Server returned error: " + error);
+            BEATCONNECT_ACTIVATION_LOG(warning, "activate: Server returned error: " + error);
             if (error.find("Invalid") != std::string::npos) {
                 return ActivationStatus::Invalid;
             }
@@ -289,40 +546,46 @@ public:
         }
 
         // Success - update state
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            activationInfo.activationCode = code;
-            activationInfo.machineId = machineId;
-            activationInfo.isValid = true;
-
-            // Server returns "activated_at" or we generate it locally
-            if (obj->hasProperty("activated_at")) {
-                activationInfo.activatedAt = obj->getProperty("activated_at")
-                    .toString().toStdString();
-            } else {
-                // Generate timestamp locally (server doesn't always return it)
-                activationInfo.activatedAt = juce::Time::getCurrentTime()
-                    .toISO8601(true).toStdString();
-            }
-
-            // Server returns "activations" (not "current_activations")
-            if (obj->hasProperty("activations")) {
-                activationInfo.currentActivations = static_cast<int>(
-                    obj->getProperty("activations"));
-            } else if (obj->hasProperty("current_activations")) {
-                activationInfo.currentActivations = static_cast<int>(
-                    obj->getProperty("current_activations"));
-            }
+        ActivationInfo info;
+        info.activationCode = code;
+        info.machineId = machineId;
+        info.isValid = true;
+
+        // Server returns "activated_at" or we generate it locally
+        if (obj->hasProperty("activated_at")) {
+            info.activatedAt = obj->getProperty("activated_at")
+                .toString().toStdString();
+        } else {
+            // Generate timestamp locally (server doesn't always return it)
+            info.activatedAt = juce::Time::getCurrentTime()
+                .toISO8601(true).toStdString();
+        }
 
-            if (obj->hasProperty("max_activations")) {
-                activationInfo.maxActivations = static_cast<int>(
-                    obj->getProperty("max_activations"));
-            }
+        // Server returns "activations" (not "current_activations")
+        if (obj->hasProperty("activations")) {
+            info.currentActivations = static_cast<int>(
+                obj->getProperty("activations"));
+        } else if (obj->hasProperty("current_activations")) {
+            info.currentActivations = static_cast<int>(
+                obj->getProperty("current_activations"));
+        }
 
-            activated = true;
+        if (obj->hasProperty("max_activations")) {
+            info.maxActivations = static_cast<int>(
+                obj->getProperty("max_activations"));
         }
 
-        saveState();
+        // Saves activation.json and tells every instance
+        state->update([&info](ActivationSnapshot& snapshot) {
+            snapshot.activated = true;
+            snapshot.info = info;
+            snapshot.lastValidatedMs = juce::Time::currentTimeMillis();
+            return true;
+        });
+
+        if (config.revalidateIntervalSeconds > 0) {
+            scheduleRevalidation(config.revalidateIntervalSeconds * 1000LL);
+        }
         return ActivationStatus::Valid;
 #else
         return ActivationStatus::NotConfigured;
@@ -334,21 +597,14 @@ public:
             return ActivationStatus::NotConfigured;
         }
 
-        std::string code;
-        std::string machineId;
-
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            if (!activated) {
-                return ActivationStatus::NotActivated;
-            }
-            code = activationInfo.activationCode;
-            machineId = activationInfo.machineId;
+        auto snapshot = state->snapshot();
+        if (!snapshot->activated) {
+            return ActivationStatus::NotActivated;
         }
+        auto code = snapshot->info.activationCode;
+        auto machineId = snapshot->info.machineId;
 
 #if BEATCONNECT_USE_JUCE
-        juce::URL url(juce::String(config.apiBaseUrl) + "/functions/v1/plugin-activation/deactivate");
-
         juce::DynamicObject::Ptr body = new juce::DynamicObject();
         body->setProperty("code", juce::String(code));
         body->setProperty("plugin_id", juce::String(config.pluginId));
@@ -356,27 +612,12 @@ public:
 
         auto jsonBody = juce::JSON::toString(juce::var(body.get()));
 
-        juce::URL::InputStreamOptions options(
-            juce::URL::ParameterHandling::inPostData);
-
-        // Build headers with Supabase authentication
-        juce::String headers = "Content-Type: application/json\r\n";
-        if (!config.supabaseKey.empty()) {
-            headers += "apikey: " + juce::String(config.supabaseKey) + "\r\n";
-            headers += "Authorization: Bearer " + juce::String(config.supabaseKey) + "\r\n";
-        }
-        options.withExtraHeaders(headers);
-        options.withConnectionTimeoutMs(config.requestTimeoutMs);
-
-        url = url.withPOSTData(jsonBody);
-
-        auto stream = url.createInputStream(options);
-        if (!stream) {
+        auto response = api->send(HttpRequest::post("/deactivate", jsonBody.toStdString()));
+        if (!response.connected()) {
             return ActivationStatus::NetworkError;
         }
 
-        auto response = stream->readEntireStreamAsString();
-        auto json = juce::JSON::parse(response);
+        auto json = response.json();
 
         if (json.isVoid() || !json.getDynamicObject()) {
             return ActivationStatus::ServerError;
@@ -387,13 +628,7 @@ public:
             return ActivationStatus::ServerError;
         }
 
-        // Success - clear local state
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            activated = false;
-            activationInfo = ActivationInfo{};
-        }
-
+        // Success - clear local state (and every other instance's)
         clearState();
         return ActivationStatus::Valid;
 #else
@@ -402,186 +637,218 @@ public:
     }
 
     ActivationStatus validate() {
-        if (!configured) {
-            return ActivationStatus::NotConfigured;
+        auto request = makeValidationRequest();
+        if (!request) {
+            return configured ? ActivationStatus::NotActivated : ActivationStatus::NotConfigured;
         }
 
-        std::string code;
-        std::string machineId;
+        return applyValidation(ValidationCoalescer::shared().run(*request, *executor));
+    }
 
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            if (!activated) {
-                return ActivationStatus::NotActivated;
+    void activateAsync(const std::string& code, StatusCallback callback) {
+        executor->submit(this, [this, code, callback]() {
+            auto status = activate(code);
+            if (callback) {
+                callback(status);
             }
-            code = activationInfo.activationCode;
-            machineId = activationInfo.machineId;
-        }
-
-#if BEATCONNECT_USE_JUCE
-        juce::URL url(juce::String(config.apiBaseUrl) + "/functions/v1/plugin-activation/validate");
+        });
+    }
 
-        juce::DynamicObject::Ptr body = new juce::DynamicObject();
-        body->setProperty("code", juce::String(code));
-        body->setProperty("plugin_id", juce::String(config.pluginId));
-        body->setProperty("machine_id", juce::String(machineId));
+    void validateAsync(StatusCallback callback) {
+        auto request = makeValidationRequest();
+        if (!request) {
+            auto status = configured ? ActivationStatus::NotActivated : ActivationStatus::NotConfigured;
+            executor->submit(this, [status, callback]() {
+                if (callback) {
+                    callback(status);
+                }
+            });
+            return;
+        }
 
-        auto jsonBody = juce::JSON::toString(juce::var(body.get()));
+        // Joins any identical validation already in flight (from this or
+        // another instance) instead of sending a second request
+        ValidationCoalescer::shared().runAsync(*request, *executor, this,
+            [this, callback](const ValidationResponse& response) {
+                auto status = applyValidation(response);
+                if (callback) {
+                    callback(status);
+                }
+            });
+    }
 
-        juce::URL::InputStreamOptions options(
-            juce::URL::ParameterHandling::inPostData);
+    void loadState() {
+        state->reload();
+    }
 
-        // Build headers with Supabase authentication
-        juce::String headers = "Content-Type: application/json\r\n";
-        if (!config.supabaseKey.empty()) {
-            headers += "apikey: " + juce::String(config.supabaseKey) + "\r\n";
-            headers += "Authorization: Bearer " + juce::String(config.supabaseKey) + "\r\n";
-        }
-        options.withExtraHeaders(headers);
-        options.withConnectionTimeoutMs(config.requestTimeoutMs);
+    void saveState() {
+        state->save();
+    }
 
-        url = url.withPOSTData(jsonBody);
+    void clearState() {
+        state->clear();
+    }
 
-        auto stream = url.createInputStream(options);
-        if (!stream) {
-            return ActivationStatus::NetworkError;
-        }
+    std::string getMachineId() const {
+        return MachineId::generate();
+    }
 
-        auto response = stream->readEntireStreamAsString();
-        auto json = juce::JSON::parse(response);
+private:
+    // Snapshot of what /validate needs; nullopt if not configured/activated
+    std::optional<ValidationRequest> makeValidationRequest() const {
+        if (!configured) return std::nullopt;
+
+        auto snapshot = state->snapshot();
+        if (!snapshot->activated) return std::nullopt;
+
+        ValidationRequest request;
+        request.api = api;
+        request.pluginId = config.pluginId;
+        request.code = snapshot->info.activationCode;
+        request.machineId = snapshot->info.machineId;
+        return request;
+    }
 
-        if (json.isVoid() || !json.getDynamicObject()) {
-            return ActivationStatus::ServerError;
+    ActivationStatus applyValidation(const ValidationResponse& response) {
+        bool answered = response.invalidated || response.status == ActivationStatus::Valid;
+        if (!answered) {
+            return response.status;  // Network/server trouble; keep what we had
         }
 
-        auto* obj = json.getDynamicObject();
-
-        // Check for specific errors
-        if (obj->hasProperty("error")) {
-            auto error = obj->getProperty("error").toString().toStdString();
-            if (error.find("revoked") != std::string::npos) {
-                std::lock_guard<std::mutex> lock(mutex);
-                activationInfo.isValid = false;
-                return ActivationStatus::Revoked;
+        state->update([&response](ActivationSnapshot& snapshot) {
+            if (!snapshot.activated) {
+                return false;  // Deactivated while the request ran
             }
-            if (error.find("Invalid") != std::string::npos) {
-                std::lock_guard<std::mutex> lock(mutex);
-                activationInfo.isValid = false;
-                return ActivationStatus::Invalid;
-            }
-            return ActivationStatus::ServerError;
+            snapshot.info.isValid = !response.invalidated;
+#if BEATCONNECT_USE_JUCE
+            snapshot.lastValidatedMs = juce::Time::currentTimeMillis();
+#endif
+            return true;
+        });
+        return response.status;
+    }
+
+    // =========================================================================
+    // Background Revalidation
+    // =========================================================================
+    // Checks run on the shared executor, never on the caller's thread. Each
+    // check first re-reads last_validated_at from activation.json (another
+    // instance may have just validated) and skips the network if we're still
+    // inside revalidateIntervalSeconds. Failures back off with jitter.
+
+    static constexpr int64_t startupJitterMs = 5000;
+    static constexpr int64_t retryBaseMs = 60 * 1000;
+    static constexpr int64_t retryMaxMs = 60 * 60 * 1000;
+
+    void startRevalidationSchedule() {
+        if (config.validateOnStartup) {
+            // Due-ness is checked when it fires; jitter spreads out instances
+            // that load together
+            scheduleRevalidation(jitter(startupJitterMs / 2, 1.0));
+        } else if (config.revalidateIntervalSeconds > 0) {
+            scheduleRevalidation(config.revalidateIntervalSeconds * 1000LL);
         }
+    }
 
-        // Check valid flag
-        bool isValid = obj->getProperty("valid");
+    // Replaces any check already scheduled (only the newest one runs)
+    void scheduleRevalidation(int64_t delayMs) {
+        uint64_t generation;
         {
             std::lock_guard<std::mutex> lock(mutex);
-            activationInfo.isValid = isValid;
+            generation = ++revalidationGeneration;
         }
-
-        return isValid ? ActivationStatus::Valid : ActivationStatus::Invalid;
-#else
-        return ActivationStatus::NotConfigured;
-#endif
-    }
-
-    void activateAsync(const std::string& code, StatusCallback callback) {
-        std::thread([this, code, callback]() {
-            auto status = activate(code);
-            if (callback) {
-                callback(status);
-            }
-        }).detach();
+        executor->submitAfter(this, delayMs, [this, generation] {
+            runScheduledRevalidation(generation);
+        });
     }
 
-    void validateAsync(StatusCallback callback) {
-        std::thread([this, callback]() {
-            auto status = validate();
-            if (callback) {
-                callback(status);
-            }
-        }).detach();
+    bool isCurrentRevalidation(uint64_t generation) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return generation == revalidationGeneration;
     }
 
-    void loadState() {
-#if BEATCONNECT_USE_JUCE
-        initLog("[Activation] loadState() called");
-
-        if (statePath.empty()) {
-            initLog("[Activation] loadState: statePath is empty, returning");
-            return;
-        }
+    void runScheduledRevalidation(uint64_t generation) {
+        if (!isCurrentRevalidation(generation)) return;
 
-        initLog("[Activation] loadState: checking file at " + statePath);
-        juce::File file(statePath);
+        // Another process may have validated since we last looked
+        state->mergeLastValidatedFromDisk();
 
-        initLog("[Activation] loadState: juce::File created");
-        bool exists = file.existsAsFile();
-        initLog("[Activation] loadState: existsAsFile() = " + std::string(exists ? "true" : "false"));
+        auto request = makeValidationRequest();
+        if (!request) return;  // Deactivated meanwhile
 
-        if (exists) {
-            initLog("[Activation] loadState: setting activated=true");
-            activated = true;
-            activationInfo.isValid = true;
-            initLog("[Activation] loadState: flags set");
+        auto wait = msUntilRevalidationDue();
+        if (!wait) return;  // Validated once and no interval set
+        if (*wait > 0) {
+            scheduleRevalidation(*wait + jitter(startupJitterMs / 2, 1.0));
+            return;
         }
 
-        initLog("[Activation] loadState() complete");
-#endif
+        ValidationCoalescer::shared().runAsync(*request, *executor, this,
+            [this, generation](const ValidationResponse& response) {
+                applyValidation(response);
+                if (!isCurrentRevalidation(generation)) return;
+
+                bool answered = response.invalidated || response.status == ActivationStatus::Valid;
+                int failures;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    failures = answered ? 0 : ++revalidationFailures;
+                    if (answered) revalidationFailures = 0;
+                }
+
+                if (!answered) {
+                    auto backoff = std::min(retryMaxMs, retryBaseMs << std::min(failures - 1, 6));
+                    scheduleRevalidation(jitter(backoff, 0.5));
+                } else if (config.revalidateIntervalSeconds > 0) {
+                    scheduleRevalidation(config.revalidateIntervalSeconds * 1000LL);
+                }
+            });
     }
 
-    void saveState() {
-#if BEATCONNECT_USE_JUCE
-        juce::File file(statePath);
-        file.getParentDirectory().createDirectory();
+    // 0 = due now, nullopt = never (interval 0 and validated before)
+    std::optional<int64_t> msUntilRevalidationDue() const {
+        auto lastValidatedMs = state->snapshot()->lastValidatedMs;
+        if (lastValidatedMs <= 0) return 0;
+        if (config.revalidateIntervalSeconds <= 0) return std::nullopt;
 
-        juce::DynamicObject::Ptr obj = new juce::DynamicObject();
-
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            obj->setProperty("activation_code",
-                juce::String(activationInfo.activationCode));
-            obj->setProperty("machine_id",
-                juce::String(activationInfo.machineId));
-            obj->setProperty("activated_at",
-                juce::String(activationInfo.activatedAt));
-            obj->setProperty("is_valid", activationInfo.isValid);
-            obj->setProperty("current_activations",
-                activationInfo.currentActivations);
-            obj->setProperty("max_activations",
-                activationInfo.maxActivations);
-        }
-
-        auto json = juce::JSON::toString(juce::var(obj.get()));
-        file.replaceWithText(json);
-#endif
-    }
-
-    void clearState() {
 #if BEATCONNECT_USE_JUCE
-        juce::File file(statePath);
-        if (file.existsAsFile()) {
-            file.deleteFile();
-        }
+        auto elapsed = juce::Time::currentTimeMillis() - lastValidatedMs;
+#else
+        int64_t elapsed = 0;
 #endif
+        auto interval = config.revalidateIntervalSeconds * 1000LL;
+        return std::max<int64_t>(0, interval - elapsed);
     }
 
-    std::string getMachineId() const {
-        return MachineId::generate();
+    // delayMs scaled by a random factor in [1 - spread, 1 + spread]
+    static int64_t jitter(int64_t delayMs, double spread) {
+        static std::mutex rngMutex;
+        static std::mt19937 rng(std::random_device{}());
+        std::uniform_real_distribution<double> factor(1.0 - spread, 1.0 + spread);
+
+        std::lock_guard<std::mutex> lock(rngMutex);
+        return static_cast<int64_t>(delayMs * factor(rng));
     }
 
-private:
+    std::shared_ptr<TaskExecutor> executor = TaskExecutor::acquire();
     mutable std::mutex mutex;
     ActivationConfig config;
+    std::shared_ptr<const HttpClient> api;
     std::string statePath;
     bool configured = false;
-    bool activated = false;
-    ActivationInfo activationInfo;
+    std::shared_ptr<SharedActivationState> state;
+    std::vector<int> stateListenerIds;
+    uint64_t revalidationGeneration = 0;
+    int revalidationFailures = 0;
 
     // Instance-based debug state (no global statics!)
-    mutable std::mutex debugMutex;
+    std::shared_ptr<LogWriter> logWriter = LogWriter::acquire();
+    std::shared_ptr<LogWriter::Sink> debugSink;  // Set in configure() if enabled
+    std::shared_ptr<LogWriter::Sink> initSink;
     bool debugEnabled = false;
     std::string debugLogPath;
+    mutable std::mutex debugMutex;  // Guards debugCallback, debugSink, debugEnabled, debugLogPath
+    std::atomic<bool> hasDebugCallback{false};
     Activation::DebugCallback debugCallback;
 };
 
@@ -776,39 +1043,56 @@ std::optional<ActivationInfo> Activation::getActivationInfo() const {
     return pImpl->getActivationInfo();
 }
 
+int Activation::addStateListener(StateListener listener) {
+    return pImpl->addStateListener(std::move(listener));
+}
+
+void Activation::removeStateListener(int listenerId) {
+    pImpl->removeStateListener(listenerId);
+}
+
 ActivationStatus Activation::activate(const std::string& code) {
+    BEATCONNECT_RT_BLOCKING("Activation::activate");
     return pImpl->activate(code);
 }
 
 ActivationStatus Activation::deactivate() {
+    BEATCONNECT_RT_BLOCKING("Activation::deactivate");
     return pImpl->deactivate();
 }
 
 ActivationStatus Activation::validate() {
+    BEATCONNECT_RT_BLOCKING("Activation::validate");
     return pImpl->validate();
 }
 
 void Activation::activateAsync(const std::string& code, StatusCallback callback) {
+    BEATCONNECT_RT_BLOCKING("Activation::activateAsync");
     pImpl->activateAsync(code, callback);
 }
 
 void Activation::validateAsync(StatusCallback callback) {
+    BEATCONNECT_RT_BLOCKING("Activation::validateAsync");
     pImpl->validateAsync(callback);
 }
 
 void Activation::loadState() {
+    BEATCONNECT_RT_BLOCKING("Activation::loadState");
     pImpl->loadState();
 }
 
 void Activation::saveState() {
+    BEATCONNECT_RT_BLOCKING("Activation::saveState");
     pImpl->saveState();
 }
 
 void Activation::clearState() {
+    BEATCONNECT_RT_BLOCKING("Activation::clearState");
     pImpl->clearState();
 }
 
 std::string Activation::getMachineId() const {
+    BEATCONNECT_RT_BLOCKING("Activation::getMachineId");
     return pImpl->getMachineId();
 }
 
@@ -0,0 +1,200 @@
+/**
+ * Shared Activation State - Implementation
+ */
+
+#include "ActivationState.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#if BEATCONNECT_USE_JUCE
+    #include <juce_core/juce_core.h>
+#endif
+
+namespace beatconnect {
+
+namespace {
+
+// Whether subscribers would see a difference (timestamps alone don't count)
+bool differsForListeners(const ActivationSnapshot& a, const ActivationSnapshot& b) {
+    return a.activated != b.activated
+        || a.info.isValid != b.info.isValid
+        || a.info.activationCode != b.info.activationCode
+        || a.info.machineId != b.info.machineId
+        || a.info.activatedAt != b.info.activatedAt
+        || a.info.expiresAt != b.info.expiresAt
+        || a.info.currentActivations != b.info.currentActivations
+        || a.info.maxActivations != b.info.maxActivations;
+}
+
+#if BEATCONNECT_USE_JUCE
+int64_t parseTimestamp(const juce::String& iso8601) {
+    if (iso8601.isEmpty()) return 0;
+    return juce::Time::fromISO8601(iso8601).toMilliseconds();
+}
+#endif
+
+} // namespace
+
+std::shared_ptr<SharedActivationState> SharedActivationState::acquire(const std::string& statePath) {
+    static std::mutex registryMutex;
+    static std::unordered_map<std::string, std::weak_ptr<SharedActivationState>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (auto existing = registry[statePath].lock()) {
+        return existing;
+    }
+
+    auto state = std::make_shared<SharedActivationState>(statePath);
+    registry[statePath] = state;
+    return state;
+}
+
+SharedActivationState::SharedActivationState(std::string path)
+    : statePath(std::move(path)),
+      current(std::make_shared<ActivationSnapshot>(readFromDisk())) {}
+
+std::shared_ptr<const ActivationSnapshot> SharedActivationState::snapshot() const {
+    return std::atomic_load(&current);
+}
+
+void SharedActivationState::update(const Mutator& mutate) {
+    bool changed;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+
+        auto next = std::make_shared<ActivationSnapshot>(*current);
+        if (!mutate(*next)) return;
+
+        persist(*next);
+        changed = differsForListeners(*current, *next);
+        std::atomic_store(&current, std::shared_ptr<const ActivationSnapshot>(next));
+    }
+    if (changed) notifyListeners();
+}
+
+void SharedActivationState::reload() {
+    bool changed;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        auto next = std::make_shared<ActivationSnapshot>(readFromDisk());
+        changed = differsForListeners(*current, *next);
+        std::atomic_store(&current, std::shared_ptr<const ActivationSnapshot>(next));
+    }
+    if (changed) notifyListeners();
+}
+
+void SharedActivationState::save() {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    persist(*current);
+}
+
+void SharedActivationState::clear() {
+    update([](ActivationSnapshot& state) {
+        state = ActivationSnapshot{};
+        return true;
+    });
+}
+
+void SharedActivationState::mergeLastValidatedFromDisk() {
+    std::lock_guard<std::mutex> lock(writeMutex);
+
+    auto onDisk = readFromDisk();
+    if (onDisk.lastValidatedMs <= current->lastValidatedMs) return;
+
+    auto next = std::make_shared<ActivationSnapshot>(*current);
+    next->lastValidatedMs = onDisk.lastValidatedMs;
+    std::atomic_store(&current, std::shared_ptr<const ActivationSnapshot>(next));
+}
+
+int SharedActivationState::subscribe(Listener listener) {
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    int id = nextListenerId++;
+    listeners.emplace_back(id, std::make_shared<Listener>(std::move(listener)));
+    return id;
+}
+
+void SharedActivationState::unsubscribe(int listenerId) {
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+        [listenerId](const auto& l) { return l.first == listenerId; }), listeners.end());
+}
+
+// Runs outside writeMutex so listeners may call back into Activation. Always
+// hands out the latest snapshot, so racing updates can't deliver a stale
+// state last.
+void SharedActivationState::notifyListeners() {
+    std::vector<std::shared_ptr<Listener>> targets;
+    {
+        std::lock_guard<std::mutex> lock(listenerMutex);
+        for (const auto& l : listeners) {
+            targets.push_back(l.second);
+        }
+    }
+    auto latest = snapshot();
+    for (const auto& listener : targets) {
+        (*listener)(*latest);
+    }
+}
+
+void SharedActivationState::persist(const ActivationSnapshot& state) const {
+#if BEATCONNECT_USE_JUCE
+    if (statePath.empty()) return;
+    juce::File file(statePath);
+
+    if (!state.activated) {
+        file.deleteFile();
+        return;
+    }
+
+    file.getParentDirectory().createDirectory();
+
+    juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+    obj->setProperty("activation_code", juce::String(state.info.activationCode));
+    obj->setProperty("machine_id", juce::String(state.info.machineId));
+    obj->setProperty("activated_at", juce::String(state.info.activatedAt));
+    obj->setProperty("is_valid", state.info.isValid);
+    obj->setProperty("current_activations", state.info.currentActivations);
+    obj->setProperty("max_activations", state.info.maxActivations);
+    if (state.lastValidatedMs > 0) {
+        obj->setProperty("last_validated_at",
+            juce::Time(state.lastValidatedMs).toISO8601(true));
+    }
+
+    auto json = juce::JSON::toString(juce::var(obj.get()));
+    file.replaceWithText(json);
+#else
+    (void)state;
+#endif
+}
+
+ActivationSnapshot SharedActivationState::readFromDisk() const {
+    ActivationSnapshot state;
+#if BEATCONNECT_USE_JUCE
+    if (statePath.empty()) return state;
+
+    juce::File file(statePath);
+    if (!file.existsAsFile()) return state;
+
+    // An existing file means activated, even if it's from an older SDK that
+    // wrote fewer fields
+    state.activated = true;
+    state.info.isValid = true;
+
+    auto json = juce::JSON::parse(file.loadFileAsString());
+    if (auto* obj = json.getDynamicObject()) {
+        state.info.activationCode = obj->getProperty("activation_code").toString().toStdString();
+        state.info.machineId = obj->getProperty("machine_id").toString().toStdString();
+        state.info.activatedAt = obj->getProperty("activated_at").toString().toStdString();
+        if (obj->hasProperty("is_valid")) {
+            state.info.isValid = obj->getProperty("is_valid");
+        }
+        state.info.currentActivations = static_cast<int>(obj->getProperty("current_activations"));
+        state.info.maxActivations = static_cast<int>(obj->getProperty("max_activations"));
+        state.lastValidatedMs = parseTimestamp(obj->getProperty("last_validated_at").toString());
+    }
+#endif
+    return state;
+}
+
+} // namespace beatconnect
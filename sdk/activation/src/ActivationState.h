@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * Shared Activation State
+ *
+ * Internal, process-wide activation state for one activation.json. Every
+ * Activation instance pointing at the same file shares one of these, so the
+ * file is parsed once per process, reads are a lock-free snapshot, and a
+ * change made by one instance (activate, deactivate, revalidation) reaches
+ * all of them through subscribe().
+ */
+
+#include "beatconnect/Activation.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace beatconnect {
+
+struct ActivationSnapshot {
+    bool activated = false;
+    ActivationInfo info;
+    int64_t lastValidatedMs = 0;  // Wall clock, 0 = never
+
+    bool isActivated() const { return activated && info.isValid; }
+};
+
+class SharedActivationState {
+public:
+    using Listener = std::function<void(const ActivationSnapshot&)>;
+    using Mutator = std::function<bool(ActivationSnapshot&)>;
+
+    /** State for statePath, loaded from disk on first use. */
+    static std::shared_ptr<SharedActivationState> acquire(const std::string& statePath);
+
+    explicit SharedActivationState(std::string statePath);
+
+    /** Current state. Never blocks on writers. */
+    std::shared_ptr<const ActivationSnapshot> snapshot() const;
+
+    /**
+     * Change the state: mutate gets a copy and returns false to leave things
+     * as they were. The result is written to disk (or the file removed when
+     * no longer activated) and pushed to subscribers.
+     */
+    void update(const Mutator& mutate);
+
+    /** Re-read activation.json, e.g. after another process changed it. */
+    void reload();
+
+    /** Write the current state to disk. */
+    void save();
+
+    /** Forget the activation and delete the file (no server call). */
+    void clear();
+
+    /**
+     * Adopt a newer last_validated_at from disk, written by another process.
+     * Not persisted or broadcast; it only affects revalidation scheduling.
+     */
+    void mergeLastValidatedFromDisk();
+
+    /**
+     * Called (on whichever thread made the change, after the change is
+     * visible through snapshot()) when activation status or info changes.
+     * A call already under way may still finish after unsubscribe() returns.
+     */
+    int subscribe(Listener listener);
+    void unsubscribe(int listenerId);
+
+private:
+    void notifyListeners();
+    void persist(const ActivationSnapshot& state) const;
+    ActivationSnapshot readFromDisk() const;
+
+    const std::string statePath;
+
+    std::mutex writeMutex;  // Serializes update/reload/clear and file writes
+    std::shared_ptr<const ActivationSnapshot> current;
+
+    std::mutex listenerMutex;
+    std::vector<std::pair<int, std::shared_ptr<Listener>>> listeners;
+    int nextListenerId = 1;
+};
+
+} // namespace beatconnect
@@ -6,10 +6,21 @@
  */
 
 #include "beatconnect/AssetDownloader.h"
+#include "AssetManifest.h"
+#include "BandwidthLimiter.h"
+#include "Digest.h"
+#include "DownloadCoordinator.h"
+#include "HttpClient.h"
+#include "PackManifest.h"
+#include "ProgressMeter.h"
 
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <optional>
 #include <queue>
 #include <unordered_map>
 #include <unordered_set>
@@ -39,10 +50,41 @@ const char* downloadStatusToString(DownloadStatus status) {
         case DownloadStatus::AlreadyExists: return "File already exists";
         case DownloadStatus::InvalidUrl:    return "Invalid download URL";
         case DownloadStatus::Corrupted:     return "File corrupted";
+        case DownloadStatus::InProgress:    return "Sync already in progress";
     }
     return "Unknown status";
 }
 
+// ==============================================================================
+// Transfer Slots
+// ==============================================================================
+
+namespace {
+
+// Everything needed to start a transfer, produced by the /info + /download-url
+// round trips. Batches compute these ahead of the transfers that consume them.
+struct ResolvedAsset {
+    DownloadStatus status = DownloadStatus::NetworkError;
+    std::string assetId;
+    std::string fileName;
+    std::string localPath;     // Set when status is AlreadyExists
+    std::string downloadUrl;
+    int64_t fileSize = 0;
+    std::string checksum;
+};
+
+// One file transfer from a presigned URL into the download directory.
+struct TransferRequest {
+    std::string url;
+    std::string fileName;
+    std::string assetId;       // Empty for downloadFromUrl (not cancellable)
+    int64_t expectedSize = 0;  // From AssetInfo::fileSize, 0 if unknown
+    std::string checksum;
+    uint64_t cancelGeneration = 0;  // Cancelled once cancelAll moves past it
+};
+
+} // namespace
+
 // ==============================================================================
 // AssetDownloader Implementation
 // ==============================================================================
@@ -52,45 +94,70 @@ public:
     Impl() = default;
     ~Impl() {
         cancelAll();
+
+        // Async operations run on detached threads that capture this
+        std::unique_lock<std::mutex> lock(workersMutex);
+        workersIdle.wait(lock, [this] { return runningWorkers == 0; });
+        lock.unlock();
+
+        bandwidth->removePauseSource(transportActive);
     }
 
     void configure(const DownloaderConfig& config) {
         std::lock_guard<std::mutex> lock(mutex);
         this->config = config;
         configured = true;
+        rebuildClients();
+        presignedUrls.clear();
+        batchInfoUnsupported = false;
+        batchUrlsUnsupported = false;
 
 #if BEATCONNECT_USE_JUCE
         downloadDir = juce::File(config.downloadPath);
         downloadDir.createDirectory();
+        auto manifestPath = downloadDir.getChildFile(manifestFileName)
+            .getFullPathName().toStdString();
+
+        if (config.sharedService) {
+            coordinator = DownloadCoordinator::getShared(
+                config.pluginId, downloadDir.getFullPathName().toStdString(), manifestPath);
+            manifest = coordinator->getManifest();
+            transferSlots = coordinator->getTransferSlots();
+        } else {
+            if (coordinator) {
+                // Leaving shared mode; stop using the coordinator's state
+                coordinator.reset();
+                manifest = std::make_shared<AssetManifest>();
+                transferSlots = std::make_shared<TransferSlots>();
+            }
+            manifest->load(manifestPath);
+        }
 #endif
+        transferSlots->setLimit(config.maxConcurrent);
+
+        bandwidth->removePauseSource(transportActive);
+        bandwidth = coordinator ? coordinator->getBandwidthLimiter() : ownBandwidth;
+        bandwidth->setRate(config.maxBytesPerSecond);
+        if (config.pauseWhileHostPlaying) {
+            bandwidth->addPauseSource(transportActive);
+        }
     }
 
     void setAuthToken(const std::string& token) {
         std::lock_guard<std::mutex> lock(mutex);
         config.authToken = token;
+        rebuildClients();
+        presignedUrls.clear();  // Signed for the previous user
     }
 
     std::optional<AssetInfo> getAssetInfo(const std::string& assetId) {
         if (!configured) return std::nullopt;
 
 #if BEATCONNECT_USE_JUCE
-        juce::URL url(juce::String(config.apiBaseUrl) +
-                      "/content/" + juce::String(assetId) + "/info");
-
-        juce::URL::InputStreamOptions options(
-            juce::URL::ParameterHandling::inAddress);
-        options.withConnectionTimeoutMs(config.requestTimeoutMs);
-
-        if (!config.authToken.empty()) {
-            options.withExtraHeaders(
-                "Authorization: Bearer " + juce::String(config.authToken) + "\r\n");
-        }
+        auto response = apiClient()->send(HttpRequest::get("/content/" + assetId + "/info"));
+        if (!response.connected()) return std::nullopt;
 
-        auto stream = url.createInputStream(options);
-        if (!stream) return std::nullopt;
-
-        auto response = stream->readEntireStreamAsString();
-        auto json = juce::JSON::parse(response);
+        auto json = response.json();
 
         if (json.isVoid() || !json.getDynamicObject()) {
             return std::nullopt;
@@ -101,184 +168,161 @@ public:
             return std::nullopt;
         }
 
-        AssetInfo info;
-        info.id = assetId;
-        if (obj->hasProperty("name"))
-            info.name = obj->getProperty("name").toString().toStdString();
-        if (obj->hasProperty("type"))
-            info.type = obj->getProperty("type").toString().toStdString();
-        if (obj->hasProperty("mime_type"))
-            info.mimeType = obj->getProperty("mime_type").toString().toStdString();
-        if (obj->hasProperty("file_size"))
-            info.fileSize = (int64_t)obj->getProperty("file_size");
-        if (obj->hasProperty("checksum"))
-            info.checksum = obj->getProperty("checksum").toString().toStdString();
-
+        auto info = parseAssetInfo(*obj, assetId);
+        cacheUrl(info.id, info.downloadUrl, info.expiresAt);
         return info;
 #else
         return std::nullopt;
 #endif
     }
 
-    std::string getDownloadUrl(const std::string& assetId) {
-        if (!configured) return "";
-
-#if BEATCONNECT_USE_JUCE
-        juce::URL url(juce::String(config.apiBaseUrl) +
-                      "/content/" + juce::String(assetId) + "/download-url");
-
-        juce::URL::InputStreamOptions options(
-            juce::URL::ParameterHandling::inAddress);
-        options.withConnectionTimeoutMs(config.requestTimeoutMs);
+    std::vector<std::optional<AssetInfo>> getAssetInfoBatch(const std::vector<std::string>& assetIds) {
+        std::vector<std::optional<AssetInfo>> infos(assetIds.size());
+        if (!configured) return infos;
 
-        if (!config.authToken.empty()) {
-            options.withExtraHeaders(
-                "Authorization: Bearer " + juce::String(config.authToken) + "\r\n");
-        }
+        for (size_t start = 0; start < assetIds.size(); start += presignBatchSize) {
+            auto end = std::min(assetIds.size(), start + presignBatchSize);
+            std::vector<std::string> chunk(assetIds.begin() + start, assetIds.begin() + end);
 
-        if (!config.pluginId.empty()) {
-            url = url.withParameter("plugin_id", config.pluginId);
+            auto fetched = chunk.size() > 1 ? fetchAssetInfoChunk(chunk) : std::nullopt;
+            for (size_t i = start; i < end; ++i) {
+                if (!fetched) {
+                    infos[i] = getAssetInfo(assetIds[i]);
+                } else if (auto it = fetched->find(assetIds[i]); it != fetched->end()) {
+                    infos[i] = it->second;
+                }
+            }
         }
+        return infos;
+    }
 
-        auto stream = url.createInputStream(options);
-        if (!stream) return "";
+    std::string getDownloadUrl(const std::string& assetId) {
+        if (!configured) return "";
+        if (auto cached = cachedUrl(assetId)) return *cached;
+        return fetchDownloadUrl(assetId);
+    }
 
-        auto response = stream->readEntireStreamAsString();
-        auto json = juce::JSON::parse(response);
+    std::vector<std::string> getDownloadUrlBatch(const std::vector<std::string>& assetIds) {
+        std::vector<std::string> urls(assetIds.size());
+        if (!configured) return urls;
 
-        if (json.isVoid() || !json.getDynamicObject()) {
-            return "";
+        // Only presign what the cache can't answer
+        std::vector<size_t> missing;
+        for (size_t i = 0; i < assetIds.size(); ++i) {
+            if (auto cached = cachedUrl(assetIds[i])) urls[i] = *cached;
+            else missing.push_back(i);
         }
 
-        auto* obj = json.getDynamicObject();
-        if (obj->hasProperty("url")) {
-            return obj->getProperty("url").toString().toStdString();
+        for (size_t start = 0; start < missing.size(); start += presignBatchSize) {
+            auto end = std::min(missing.size(), start + presignBatchSize);
+            std::vector<std::string> chunk;
+            for (size_t j = start; j < end; ++j) {
+                chunk.push_back(assetIds[missing[j]]);
+            }
+
+            auto fetched = chunk.size() > 1 ? fetchDownloadUrlChunk(chunk) : std::nullopt;
+            for (size_t j = start; j < end; ++j) {
+                const auto& assetId = assetIds[missing[j]];
+                if (!fetched) {
+                    urls[missing[j]] = fetchDownloadUrl(assetId);
+                } else if (auto it = fetched->find(assetId); it != fetched->end()) {
+                    urls[missing[j]] = it->second;
+                }
+            }
         }
-#endif
-        return "";
+        return urls;
     }
 
     std::pair<DownloadStatus, std::string> download(
         const std::string& assetId,
-        ProgressCallback progressCallback
+        ProgressCallback progressCallback,
+        DownloadPriority priority
     ) {
         if (!configured) {
             return {DownloadStatus::NetworkError, ""};
         }
 
         // Check if already downloading
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            if (activeDownloads.find(assetId) != activeDownloads.end()) {
-                return {DownloadStatus::Success, ""}; // Already in progress
-            }
-            activeDownloads.insert(assetId);
-        }
-
-        // Get asset info for filename
-        auto info = getAssetInfo(assetId);
-        std::string fileName = info ? info->name : assetId;
-
-#if BEATCONNECT_USE_JUCE
-        auto localPath = downloadDir.getChildFile(fileName).getFullPathName()
-            .toStdString();
-
-        // Check if already exists
-        if (config.skipExisting && juce::File(localPath).existsAsFile()) {
-            std::lock_guard<std::mutex> lock(mutex);
-            activeDownloads.erase(assetId);
-            downloadedAssets[assetId] = localPath;
-            return {DownloadStatus::AlreadyExists, localPath};
-        }
-
-        // Get download URL
-        auto downloadUrl = getDownloadUrl(assetId);
-        if (downloadUrl.empty()) {
-            std::lock_guard<std::mutex> lock(mutex);
-            activeDownloads.erase(assetId);
-            return {DownloadStatus::NotFound, ""};
-        }
-
-        // Download the file
-        auto result = downloadFromUrlInternal(downloadUrl, fileName,
-                                               assetId, progressCallback);
-
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            activeDownloads.erase(assetId);
-            if (result.first == DownloadStatus::Success) {
-                downloadedAssets[assetId] = result.second;
-            }
+        if (!beginDownload(assetId)) {
+            return {DownloadStatus::Success, ""}; // Already in progress
         }
 
+        ScopedOperation operation(*this);
+        auto result = transferResolved(resolveAsset(assetId), publishing(progressCallback), priority);
+        endDownload(assetId);
         return result;
-#else
-        std::lock_guard<std::mutex> lock(mutex);
-        activeDownloads.erase(assetId);
-        return {DownloadStatus::NetworkError, ""};
-#endif
     }
 
     void downloadAsync(
         const std::string& assetId,
         ProgressCallback progressCallback,
-        CompletionCallback completionCallback
+        CompletionCallback completionCallback,
+        DownloadPriority priority
     ) {
-        std::thread([this, assetId, progressCallback, completionCallback]() {
-            auto result = download(assetId, progressCallback);
+        launchWorker([this, assetId, progressCallback, completionCallback, priority]() {
+            auto result = download(assetId, progressCallback, priority);
             if (completionCallback) {
                 completionCallback(result.first, result.second);
             }
-        }).detach();
+        });
     }
 
     void downloadBatch(
         const std::vector<std::string>& assetIds,
         ProgressCallback progressCallback,
-        BatchCompletionCallback completionCallback
+        BatchCompletionCallback completionCallback,
+        DownloadPriority priority
     ) {
-        std::thread([this, assetIds, progressCallback, completionCallback]() {
-            std::atomic<int> succeeded{0};
-            std::atomic<int> failed{0};
-            std::atomic<int> current{0};
-
-            // Simple sequential for now
-            // TODO: Implement concurrent downloads
-            for (const auto& assetId : assetIds) {
-                if (cancelRequested) break;
-
-                int idx = ++current;
-
-                auto wrappedProgress = [&, idx](const DownloadProgress& p) {
-                    if (progressCallback) {
-                        DownloadProgress bp = p;
-                        bp.currentFile = idx;
-                        bp.totalFiles = (int)assetIds.size();
-                        progressCallback(bp);
-                    }
-                };
-
-                auto result = download(assetId, wrappedProgress);
-                if (result.first == DownloadStatus::Success ||
-                    result.first == DownloadStatus::AlreadyExists) {
-                    ++succeeded;
-                } else {
-                    ++failed;
-                }
-            }
-
-            if (completionCallback) {
-                completionCallback(succeeded, failed);
-            }
-        }).detach();
+        launchWorker([this, assetIds, progressCallback, completionCallback, priority]() {
+            runBatch(assetIds, progressCallback, completionCallback, priority);
+        });
     }
 
     std::pair<DownloadStatus, std::string> downloadFromUrl(
         const std::string& url,
         const std::string& fileName,
-        ProgressCallback progressCallback
+        ProgressCallback progressCallback,
+        DownloadPriority priority
+    ) {
+        TransferRequest request;
+        request.url = url;
+        request.fileName = fileName;
+        request.cancelGeneration = cancelGeneration.load();
+
+        ScopedOperation operation(*this);
+        ScopedTransferSlot slot(slots(), priority);
+        return downloadFromUrlInternal(request, publishing(progressCallback));
+    }
+
+    std::optional<PackSyncPlan> planPackSync(const std::string& packId) {
+        if (!configured) return std::nullopt;
+
+#if BEATCONNECT_USE_JUCE
+        auto dir = getPackDirectory(packId);
+        auto remote = fetchPackManifest(packId, dir);
+        if (remote.status != DownloadStatus::Success) return std::nullopt;
+
+        // Adoptions only land in this copy, which is never saved
+        PackManifest local;
+        local.load(dir.getFullPathName().toStdString());
+        return planPack(packId, remote, dir, local);
+#else
+        return std::nullopt;
+#endif
+    }
+
+    void syncPack(
+        const std::string& packId,
+        ProgressCallback progressCallback,
+        PackSyncCallback completionCallback,
+        DownloadPriority priority
     ) {
-        return downloadFromUrlInternal(url, fileName, "", progressCallback);
+        launchWorker([this, packId, progressCallback, completionCallback, priority]() {
+            auto result = runPackSync(packId, progressCallback, priority);
+            if (completionCallback) {
+                completionCallback(result);
+            }
+        });
     }
 
     void cancel(const std::string& assetId) {
@@ -287,7 +331,7 @@ public:
     }
 
     void cancelAll() {
-        cancelRequested = true;
+        ++cancelGeneration;
         std::lock_guard<std::mutex> lock(mutex);
         for (const auto& id : activeDownloads) {
             cancelledDownloads.insert(id);
@@ -299,223 +343,2090 @@ public:
         return !activeDownloads.empty();
     }
 
+    DownloadProgressSnapshot getProgressSnapshot() const {
+        auto snapshot = progressSnapshot.read();
+        snapshot.active = activeOperations.load() > 0;
+        return snapshot;
+    }
+
+    void setHostTransportActive(bool playingOrRecording) {
+        transportActive->store(playingOrRecording, std::memory_order_relaxed);
+    }
+
     bool isDownloaded(const std::string& assetId) const {
-        std::lock_guard<std::mutex> lock(mutex);
-        auto it = downloadedAssets.find(assetId);
-        if (it != downloadedAssets.end()) {
-#if BEATCONNECT_USE_JUCE
-            return juce::File(it->second).existsAsFile();
-#endif
-        }
-        return false;
+        return assetManifest()->find(assetId).has_value();
     }
 
     std::string getLocalPath(const std::string& assetId) const {
-        std::lock_guard<std::mutex> lock(mutex);
-        auto it = downloadedAssets.find(assetId);
-        if (it != downloadedAssets.end()) {
-            return it->second;
-        }
-        return "";
+        auto entry = assetManifest()->find(assetId);
+        return entry ? entry->path : "";
     }
 
     bool deleteDownload(const std::string& assetId) {
-        std::lock_guard<std::mutex> lock(mutex);
-        auto it = downloadedAssets.find(assetId);
-        if (it != downloadedAssets.end()) {
+        auto downloads = assetManifest();
+        auto entry = downloads->find(assetId);
+        if (!entry) return false;
 #if BEATCONNECT_USE_JUCE
-            juce::File file(it->second);
-            if (file.deleteFile()) {
-                downloadedAssets.erase(it);
-                return true;
-            }
-#endif
+        if (juce::File(entry->path).deleteFile()) {
+            downloads->remove(assetId);
+            downloads->flush();
+            return true;
         }
+#endif
         return false;
     }
 
     int64_t getTotalDownloadedSize() const {
-        int64_t total = 0;
-#if BEATCONNECT_USE_JUCE
-        std::lock_guard<std::mutex> lock(mutex);
-        for (const auto& pair : downloadedAssets) {
-            juce::File file(pair.second);
-            if (file.existsAsFile()) {
-                total += file.getSize();
-            }
-        }
-#endif
-        return total;
+        return assetManifest()->getTotalSize();
     }
 
 private:
-    std::pair<DownloadStatus, std::string> downloadFromUrlInternal(
-        const std::string& url,
-        const std::string& fileName,
-        const std::string& assetId,
-        ProgressCallback progressCallback
-    ) {
-#if BEATCONNECT_USE_JUCE
-        juce::URL downloadUrl(url);
-
-        auto targetFile = downloadDir.getChildFile(fileName);
-        auto tempFile = targetFile.getSiblingFile(fileName + ".download");
+    // =========================================================================
+    // Single Asset Pipeline
+    // =========================================================================
+
+    // Runs an async operation on a detached background thread. The count is
+    // taken before the thread starts so ~Impl cannot miss one that has not
+    // been scheduled yet, and released under the lock it waits on.
+    void launchWorker(std::function<void()> body) {
+        {
+            std::lock_guard<std::mutex> lock(workersMutex);
+            ++runningWorkers;
+        }
 
-        // Create input stream
-        int statusCode = 0;
-        auto stream = downloadUrl.createInputStream(
-            juce::URL::InputStreamOptions(juce::URL::ParameterHandling::inAddress)
-                .withConnectionTimeoutMs(config.requestTimeoutMs)
-                .withStatusCode(&statusCode));
+        std::thread([this, body]() {
+            enterBackgroundPriority();
+            body();
 
-        if (!stream) {
-            if (statusCode == 401 || statusCode == 403) {
-                return {DownloadStatus::Unauthorized, ""};
+            std::lock_guard<std::mutex> lock(workersMutex);
+            if (--runningWorkers == 0) {
+                workersIdle.notify_all();
             }
-            if (statusCode == 404) {
-                return {DownloadStatus::NotFound, ""};
-            }
-            return {DownloadStatus::NetworkError, ""};
+        }).detach();
+    }
+
+    // Counts a top-level download for DownloadProgressSnapshot::active, and
+    // writes whatever it left unsaved in the asset manifest when it ends
+    class ScopedOperation {
+    public:
+        explicit ScopedOperation(Impl& o) : owner(o) { ++owner.activeOperations; }
+
+        ~ScopedOperation() {
+            owner.assetManifest()->flush();
+            --owner.activeOperations;
         }
 
-        // Get content length
-        int64_t contentLength = stream->getTotalLength();
+        ScopedOperation(const ScopedOperation&) = delete;
+        ScopedOperation& operator=(const ScopedOperation&) = delete;
+
+    private:
+        Impl& owner;
+    };
+
+    // Wraps a top-level progress callback so every report also lands in
+    // the snapshot polled by getProgressSnapshot()
+    ProgressCallback publishing(ProgressCallback progressCallback) {
+        return [this, progressCallback](const DownloadProgress& p) {
+            DownloadProgressSnapshot snapshot;
+            snapshot.bytesDownloaded = p.bytesDownloaded;
+            snapshot.totalBytes = p.totalBytes;
+            snapshot.percent = p.percent;
+            snapshot.speedBytesPerSec = p.speedBytesPerSec;
+            snapshot.etaSeconds = p.etaSeconds;
+            snapshot.currentFile = p.currentFile;
+            snapshot.totalFiles = p.totalFiles;
+            progressSnapshot.publish(snapshot);
+
+            if (progressCallback) progressCallback(p);
+        };
+    }
 
-        // Create output file
-        auto output = tempFile.createOutputStream();
-        if (!output) {
-            return {DownloadStatus::DiskError, ""};
+    // Marks an asset as active. Returns false if it is already downloading.
+    bool beginDownload(const std::string& assetId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return activeDownloads.insert(assetId).second;
+    }
+
+    // Finished transfers are recorded in the manifest by finishTransfer.
+    // A cancel that arrived too late to stop this one doesn't carry over
+    // to the next download of the same asset.
+    void endDownload(const std::string& assetId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        activeDownloads.erase(assetId);
+        cancelledDownloads.erase(assetId);
+    }
+
+    // cancelAll stops the operations running at the time by moving the
+    // generation on; each one compares against the generation it started in,
+    // so whatever starts afterwards runs normally
+    bool cancelledSince(uint64_t generation) const {
+        return cancelGeneration.load() != generation;
+    }
+
+    void enterBackgroundPriority() const {
+        if (config.backgroundPriority) {
+            lowerCurrentThreadPriority();
         }
+    }
 
-        // Download with progress
-        const int bufferSize = 65536;
-        juce::HeapBlock<char> buffer(bufferSize);
-        int64_t bytesRead = 0;
-        auto startTime = juce::Time::getMillisecondCounter();
+    // =========================================================================
+    // Asset Info & Presigned URLs
+    // =========================================================================
+    // Batch calls go to /content/batch/info and /content/batch/download-url
+    // with {"asset_ids": [...]}. A server without them (404/405/501) is
+    // remembered, and the per-asset endpoints are used from then on.
 
-        while (!stream->isExhausted()) {
-            // Check for cancellation
-            if (!assetId.empty()) {
-                std::lock_guard<std::mutex> lock(mutex);
-                if (cancelledDownloads.find(assetId) != cancelledDownloads.end()) {
-                    cancelledDownloads.erase(assetId);
-                    output.reset();
-                    tempFile.deleteFile();
-                    return {DownloadStatus::Cancelled, ""};
-                }
-            }
+    std::optional<std::string> cachedUrl(const std::string& assetId) {
+#if BEATCONNECT_USE_JUCE
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = presignedUrls.find(assetId);
+        if (it == presignedUrls.end()) return std::nullopt;
 
-            int read = stream->read(buffer, bufferSize);
-            if (read <= 0) break;
+        // Leave room for the request to start before the signature lapses
+        if (it->second.expiresAtMs - presignMarginMs <= juce::Time::currentTimeMillis()) {
+            presignedUrls.erase(it);
+            return std::nullopt;
+        }
+        return it->second.url;
+#else
+        (void)assetId;
+        return std::nullopt;
+#endif
+    }
 
-            if (!output->write(buffer, read)) {
-                output.reset();
-                tempFile.deleteFile();
-                return {DownloadStatus::DiskError, ""};
-            }
+    // expiresAt is Unix seconds as sent by the server, 0 if it didn't say
+    void cacheUrl(const std::string& assetId, const std::string& url, int64_t expiresAt) {
+#if BEATCONNECT_USE_JUCE
+        if (url.empty()) return;
+        auto expiresAtMs = expiresAt > 0
+            ? expiresAt * 1000
+            : juce::Time::currentTimeMillis() + presignDefaultTtlMs;
 
-            bytesRead += read;
+        std::lock_guard<std::mutex> lock(mutex);
+        presignedUrls[assetId] = {url, expiresAtMs};
+#else
+        (void)assetId; (void)url; (void)expiresAt;
+#endif
+    }
 
-            // Report progress
-            if (progressCallback) {
-                DownloadProgress progress;
-                progress.assetId = assetId;
-                progress.fileName = fileName;
-                progress.bytesDownloaded = bytesRead;
-                progress.totalBytes = contentLength;
-                progress.percent = contentLength > 0
-                    ? (float)bytesRead / contentLength * 100.0f
-                    : 0.0f;
-
-                auto elapsed = juce::Time::getMillisecondCounter() - startTime;
-                if (elapsed > 0) {
-                    progress.speedBytesPerSec = (float)bytesRead / elapsed * 1000.0f;
-                }
+    void evictUrl(const std::string& assetId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        presignedUrls.erase(assetId);
+    }
 
-                progressCallback(progress);
-            }
+    // Presigns one asset, bypassing the cache (but refreshing it).
+    std::string fetchDownloadUrl(const std::string& assetId) {
+#if BEATCONNECT_USE_JUCE
+        auto request = HttpRequest::get("/content/" + assetId + "/download-url");
+        if (!config.pluginId.empty()) {
+            request.query.emplace_back("plugin_id", config.pluginId);
         }
 
-        output.reset();
+        auto response = apiClient()->send(request);
+        if (!response.connected()) return "";
 
-        // Move temp file to final location
-        if (!tempFile.moveFileTo(targetFile)) {
-            tempFile.deleteFile();
-            return {DownloadStatus::DiskError, ""};
+        auto json = response.json();
+
+        if (json.isVoid() || !json.getDynamicObject()) {
+            return "";
         }
 
-        return {DownloadStatus::Success, targetFile.getFullPathName().toStdString()};
+        auto* obj = json.getDynamicObject();
+        if (obj->hasProperty("url")) {
+            auto url = obj->getProperty("url").toString().toStdString();
+            cacheUrl(assetId, url, parseExpiry(obj->getProperty("expires_at")));
+            return url;
+        }
 #else
-        return {DownloadStatus::NetworkError, ""};
+        (void)assetId;
 #endif
+        return "";
     }
 
-    mutable std::mutex mutex;
-    DownloaderConfig config;
-    bool configured = false;
-    std::atomic<bool> cancelRequested{false};
+    // One /content/batch/info call. nullopt means the endpoint isn't there.
+    std::optional<std::unordered_map<std::string, AssetInfo>> fetchAssetInfoChunk(
+        const std::vector<std::string>& assetIds
+    ) {
+        if (batchInfoUnsupported) return std::nullopt;
 
+        std::unordered_map<std::string, AssetInfo> infos;
 #if BEATCONNECT_USE_JUCE
-    juce::File downloadDir;
+        auto response = apiClient()->send(HttpRequest::post("/content/batch/info", makeBatchBody(assetIds)));
+        if (isMissingEndpoint(response)) {
+            batchInfoUnsupported = true;
+            return std::nullopt;
+        }
+
+        auto json = response.json();
+        if (auto* assets = json.getProperty("assets", juce::var()).getArray()) {
+            for (const auto& item : *assets) {
+                auto* obj = item.getDynamicObject();
+                if (!obj || obj->hasProperty("error")) continue;
+
+                auto info = parseAssetInfo(*obj, batchItemId(*obj));
+                if (info.id.empty()) continue;
+                cacheUrl(info.id, info.downloadUrl, info.expiresAt);
+                infos[info.id] = std::move(info);
+            }
+        }
 #endif
+        return infos;
+    }
 
-    std::unordered_set<std::string> activeDownloads;
-    std::unordered_set<std::string> cancelledDownloads;
-    std::unordered_map<std::string, std::string> downloadedAssets;
-};
+    // One /content/batch/download-url call. nullopt means the endpoint isn't there.
+    std::optional<std::unordered_map<std::string, std::string>> fetchDownloadUrlChunk(
+        const std::vector<std::string>& assetIds
+    ) {
+        if (batchUrlsUnsupported) return std::nullopt;
 
-// ==============================================================================
-// AssetDownloader Public API
-// ==============================================================================
+        std::unordered_map<std::string, std::string> urls;
+#if BEATCONNECT_USE_JUCE
+        auto response = apiClient()->send(HttpRequest::post("/content/batch/download-url", makeBatchBody(assetIds)));
+        if (isMissingEndpoint(response)) {
+            batchUrlsUnsupported = true;
+            return std::nullopt;
+        }
 
-AssetDownloader::AssetDownloader() : pImpl(std::make_unique<Impl>()) {}
-AssetDownloader::~AssetDownloader() = default;
+        auto json = response.json();
+        if (auto* items = json.getProperty("urls", juce::var()).getArray()) {
+            for (const auto& item : *items) {
+                auto* obj = item.getDynamicObject();
+                if (!obj || !obj->hasProperty("url")) continue;
+
+                auto assetId = batchItemId(*obj);
+                auto url = obj->getProperty("url").toString().toStdString();
+                if (assetId.empty() || url.empty()) continue;
+                cacheUrl(assetId, url, parseExpiry(obj->getProperty("expires_at")));
+                urls[assetId] = std::move(url);
+            }
+        }
+#endif
+        return urls;
+    }
 
-void AssetDownloader::configure(const DownloaderConfig& config) {
-    pImpl->configure(config);
-}
+#if BEATCONNECT_USE_JUCE
+    std::string makeBatchBody(const std::vector<std::string>& assetIds) const {
+        juce::Array<juce::var> ids;
+        ids.ensureStorageAllocated((int)assetIds.size());
+        for (const auto& id : assetIds) {
+            ids.add(juce::String(id));
+        }
 
-void AssetDownloader::setAuthToken(const std::string& token) {
-    pImpl->setAuthToken(token);
-}
+        juce::DynamicObject::Ptr body = new juce::DynamicObject();
+        body->setProperty("asset_ids", ids);
+        if (!config.pluginId.empty()) {
+            body->setProperty("plugin_id", juce::String(config.pluginId));
+        }
+        return juce::JSON::toString(juce::var(body.get())).toStdString();
+    }
 
-std::optional<AssetInfo> AssetDownloader::getAssetInfo(const std::string& assetId) {
-    return pImpl->getAssetInfo(assetId);
-}
+    static bool isMissingEndpoint(const HttpResponse& response) {
+        return response.statusCode == 404 || response.statusCode == 405 || response.statusCode == 501;
+    }
 
-std::string AssetDownloader::getDownloadUrl(const std::string& assetId) {
-    return pImpl->getDownloadUrl(assetId);
-}
+    static std::string batchItemId(const juce::DynamicObject& obj) {
+        auto id = obj.hasProperty("id") ? obj.getProperty("id") : obj.getProperty("asset_id");
+        return id.toString().toStdString();
+    }
 
-std::pair<DownloadStatus, std::string> AssetDownloader::download(
-    const std::string& assetId,
-    ProgressCallback progressCallback
-) {
-    return pImpl->download(assetId, progressCallback);
-}
+    // Unix seconds, or an ISO 8601 string
+    static int64_t parseExpiry(const juce::var& value) {
+        if (value.isString()) {
+            return juce::Time::fromISO8601(value.toString()).toMilliseconds() / 1000;
+        }
+        return (int64_t)value;
+    }
 
-void AssetDownloader::downloadAsync(
-    const std::string& assetId,
+    static AssetInfo parseAssetInfo(const juce::DynamicObject& obj, const std::string& assetId) {
+        AssetInfo info;
+        info.id = assetId;
+        if (obj.hasProperty("name"))
+            info.name = obj.getProperty("name").toString().toStdString();
+        if (obj.hasProperty("type"))
+            info.type = obj.getProperty("type").toString().toStdString();
+        if (obj.hasProperty("mime_type"))
+            info.mimeType = obj.getProperty("mime_type").toString().toStdString();
+        if (obj.hasProperty("file_size"))
+            info.fileSize = (int64_t)obj.getProperty("file_size");
+        if (obj.hasProperty("checksum"))
+            info.checksum = obj.getProperty("checksum").toString().toStdString();
+        if (obj.hasProperty("download_url"))
+            info.downloadUrl = obj.getProperty("download_url").toString().toStdString();
+        if (obj.hasProperty("expires_at"))
+            info.expiresAt = parseExpiry(obj.getProperty("expires_at"));
+        return info;
+    }
+#endif
+
+    // Fetches info and a presigned URL for an asset (no transfer).
+    ResolvedAsset resolveAsset(const std::string& assetId) {
+        return resolveAssets({assetId}).front();
+    }
+
+    // Same for several assets, with one info and one presign round trip per
+    // presignBatchSize assets. Assets already on disk aren't presigned.
+    std::vector<ResolvedAsset> resolveAssets(const std::vector<std::string>& assetIds) {
+        std::vector<ResolvedAsset> resolved(assetIds.size());
+        auto infos = getAssetInfoBatch(assetIds);
+
+        std::vector<std::string> needUrls;
+        std::vector<size_t> needUrlIndices;
+        for (size_t i = 0; i < assetIds.size(); ++i) {
+            auto& r = resolved[i];
+            const auto& info = infos[i];
+            r.assetId = assetIds[i];
+
+            // Get asset info for filename
+            r.fileName = info ? info->name : assetIds[i];
+            if (info) {
+                r.fileSize = info->fileSize;
+                r.checksum = info->checksum;
+            }
+            if (r.fileName.empty()) r.fileName = assetIds[i];
+
+#if BEATCONNECT_USE_JUCE
+            auto localPath = downloadDir.getChildFile(r.fileName)
+                .getFullPathName().toStdString();
+
+            // Check if already exists
+            if (config.skipExisting && hasCurrentCopy(r, localPath)) {
+                r.status = DownloadStatus::AlreadyExists;
+                r.localPath = localPath;
+                continue;
+            }
+#endif
+            needUrls.push_back(assetIds[i]);
+            needUrlIndices.push_back(i);
+        }
+
+        // Get download URLs
+        auto urls = getDownloadUrlBatch(needUrls);
+        for (size_t j = 0; j < urls.size(); ++j) {
+            auto& r = resolved[needUrlIndices[j]];
+            r.downloadUrl = urls[j];
+            r.status = r.downloadUrl.empty()
+                ? DownloadStatus::NotFound
+                : DownloadStatus::Success;
+        }
+        return resolved;
+    }
+
+#if BEATCONNECT_USE_JUCE
+    // True if the manifest (or, failing that, the file on disk) already holds
+    // this version of the asset. Files that predate the manifest are adopted
+    // once their size and checksum check out.
+    bool hasCurrentCopy(const ResolvedAsset& resolved, const std::string& localPath) {
+        if (auto entry = assetManifest()->find(resolved.assetId)) {
+            return entry->path == localPath
+                && (resolved.fileSize <= 0 || entry->size == resolved.fileSize)
+                && (resolved.checksum.empty() || entry->checksum == resolved.checksum);
+        }
+
+        juce::File file(localPath);
+        if (!file.existsAsFile()) return false;
+        if (resolved.fileSize > 0 && file.getSize() != resolved.fileSize) return false;
+
+        TransferRequest request;
+        request.checksum = resolved.checksum;
+        if (auto digest = createDigest(request)) {
+            if (!hashFileRange(file, 0, file.getSize(), *digest)
+                || !Digest::matchesChecksum(digest->finishHex(), resolved.checksum)) {
+                return false;
+            }
+        }
+
+        auto entry = AssetManifest::describeFile(resolved.assetId, localPath, resolved.checksum, "");
+        if (!entry) return false;
+        assetManifest()->put(*entry);
+        return true;
+    }
+#endif
+
+    // Runs the transfer for a resolved asset inside a transfer slot.
+    std::pair<DownloadStatus, std::string> transferResolved(
+        const ResolvedAsset& resolved,
+        ProgressCallback progressCallback,
+        DownloadPriority priority
+    ) {
+        if (resolved.status == DownloadStatus::AlreadyExists) {
+            return {DownloadStatus::AlreadyExists, resolved.localPath};
+        }
+        if (resolved.status != DownloadStatus::Success) {
+            return {resolved.status, ""};
+        }
+
+        // A URL presigned ahead of time may have expired while the transfer
+        // waited its turn; the cache knows, and re-presigns only if so
+        ResolvedAsset current = resolved;
+        current.downloadUrl = getDownloadUrl(resolved.assetId);
+        if (current.downloadUrl.empty()) {
+            return {DownloadStatus::NotFound, ""};
+        }
+
+        auto result = transferCurrent(current, progressCallback, priority);
+        if (result.first == DownloadStatus::Unauthorized) {
+            // Storage rejected the signature before its stated expiry
+            evictUrl(resolved.assetId);
+            current.downloadUrl = fetchDownloadUrl(resolved.assetId);
+            if (!current.downloadUrl.empty()) {
+                result = transferCurrent(current, progressCallback, priority);
+            }
+        }
+        return result;
+    }
+
+    std::pair<DownloadStatus, std::string> transferCurrent(
+        const ResolvedAsset& resolved,
+        ProgressCallback progressCallback,
+        DownloadPriority priority
+    ) {
+        if (auto coordinator = sharedCoordinator()) {
+            return coordinator->runCoalesced(resolved.assetId, progressCallback,
+                [this, &resolved, priority](ProgressCallback fanOut) {
+                    return transferShared(resolved, fanOut, priority);
+                });
+        }
+
+        ScopedTransferSlot slot(slots(), priority);
+        return downloadFromUrlInternal(makeTransferRequest(resolved), progressCallback);
+    }
+
+    TransferRequest makeTransferRequest(const ResolvedAsset& resolved) const {
+        TransferRequest request;
+        request.url = resolved.downloadUrl;
+        request.fileName = resolved.fileName;
+        request.assetId = resolved.assetId;
+        request.expectedSize = resolved.fileSize;
+        request.checksum = resolved.checksum;
+        request.cancelGeneration = cancelGeneration.load();
+        return request;
+    }
+
+    // Shared-mode transfer: holds a cross-process lock on the target file,
+    // then re-checks it, since another host may have just finished it.
+    std::pair<DownloadStatus, std::string> transferShared(
+        const ResolvedAsset& resolved,
+        ProgressCallback progressCallback,
+        DownloadPriority priority
+    ) {
+#if BEATCONNECT_USE_JUCE
+        auto localPath = downloadDir.getChildFile(resolved.fileName)
+            .getFullPathName().toStdString();
+
+        juce::InterProcessLock fileLock(DownloadCoordinator::fileLockName(localPath));
+        juce::InterProcessLock::ScopedLockType lock(fileLock);
+
+        if (config.skipExisting && hasCurrentCopy(resolved, localPath)) {
+            return {DownloadStatus::AlreadyExists, localPath};
+        }
+#endif
+        ScopedTransferSlot slot(slots(), priority);
+        return downloadFromUrlInternal(makeTransferRequest(resolved), progressCallback);
+    }
+
+    // =========================================================================
+    // Batch Pipeline
+    // =========================================================================
+    // Workers claim assets in order and run up to maxConcurrent transfers.
+    // A prefetch thread resolves info + presigned URLs ahead of the workers,
+    // up to presignBatchSize assets per round trip, so transfers don't wait
+    // on a request each. Per-file progress is folded into one aggregate
+    // DownloadProgress for the batch.
+
+    struct BatchItem {
+        enum class State { Pending, Resolving, Ready };
+
+        std::string assetId;
+        State state = State::Pending;
+        ResolvedAsset resolved;
+        int64_t bytesDownloaded = 0;
+        int64_t countedTotal = 0;   // Size contributed to Batch::totalBytes
+    };
+
+    struct Batch {
+        Batch(int progressIntervalMs, float progressStepPercent)
+            : meter(progressIntervalMs, progressStepPercent) {}
+
+        std::vector<BatchItem> items;
+        size_t lookahead = 0;
+        DownloadPriority priority = DownloadPriority::Normal;
+        uint64_t cancelGeneration = 0;  // See cancelledSince
+
+        // Items arrive with file name, size and checksum filled in (pack
+        // files), so resolving them only presigns
+        bool presignOnly = false;
+
+        // Called on the worker as each claimed item finishes
+        std::function<void(size_t index, const std::pair<DownloadStatus, std::string>& result)> itemFinished;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        size_t nextToClaim = 0;
+        size_t numResolved = 0;
+        int completed = 0;
+        int succeeded = 0;
+        int failed = 0;
+        int64_t bytesDownloaded = 0;
+        int64_t totalBytes = 0;
+        ProgressMeter meter;        // Rate-limits and times the aggregate reports
+
+        // Serializes user callbacks so they never run concurrently
+        std::mutex callbackMutex;
+    };
+
+    void runBatch(
+        const std::vector<std::string>& assetIds,
+        ProgressCallback progressCallback,
+        BatchCompletionCallback completionCallback,
+        DownloadPriority priority
+    ) {
+        ScopedOperation operation(*this);
+        auto reportProgress = publishing(progressCallback);
+
+        Batch batch(config.progressIntervalMs, config.progressStepPercent);
+        batch.priority = priority;
+        batch.cancelGeneration = cancelGeneration.load();
+        batch.items.resize(assetIds.size());
+        for (size_t i = 0; i < assetIds.size(); ++i) {
+            batch.items[i].assetId = assetIds[i];
+        }
+
+        if (configured && !batch.items.empty()) {
+            runBatchItems(batch, reportProgress);
+        } else {
+            batch.failed = (int)batch.items.size();
+        }
+
+        if (completionCallback) {
+            completionCallback(batch.succeeded, batch.failed);
+        }
+    }
+
+    // Runs the prefetcher and workers over a non-empty batch until every
+    // item has been claimed and finished (or the downloader is cancelled).
+    void runBatchItems(Batch& batch, const ProgressCallback& reportProgress) {
+        const auto numWorkers = (size_t)std::clamp(
+            config.maxConcurrent, 1, (int)batch.items.size());
+        batch.lookahead = std::max(numWorkers * 2, presignBatchSize / 2);
+
+        std::thread prefetcher([this, &batch]() {
+            enterBackgroundPriority();
+            prefetchBatch(batch);
+        });
+
+        std::vector<std::thread> workers;
+        workers.reserve(numWorkers);
+        for (size_t i = 0; i < numWorkers; ++i) {
+            workers.emplace_back([this, &batch, &reportProgress]() {
+                enterBackgroundPriority();
+                runBatchWorker(batch, reportProgress);
+            });
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        {
+            // Release the prefetcher if it is waiting for the workers
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            batch.nextToClaim = batch.items.size();
+        }
+        batch.changed.notify_all();
+        prefetcher.join();
+    }
+
+    void prefetchBatch(Batch& batch) {
+        size_t i = 0;
+        while (true) {
+            std::vector<size_t> chunk;
+            {
+                std::unique_lock<std::mutex> lock(batch.mutex);
+                batch.changed.wait(lock, [&] {
+                    return cancelledSince(batch.cancelGeneration)
+                        || batch.nextToClaim >= batch.items.size()
+                        || i < batch.nextToClaim + batch.lookahead;
+                });
+                if (cancelledSince(batch.cancelGeneration) || batch.nextToClaim >= batch.items.size()) {
+                    return;
+                }
+
+                // Workers that got ahead resolve their own items
+                i = std::max(i, batch.nextToClaim);
+                for (; i < batch.items.size() && chunk.size() < presignBatchSize; ++i) {
+                    auto& item = batch.items[i];
+                    if (item.state == BatchItem::State::Pending) {
+                        item.state = BatchItem::State::Resolving;
+                        chunk.push_back(i);
+                    }
+                }
+                if (chunk.empty()) {
+                    if (i >= batch.items.size()) return;
+                    continue;
+                }
+            }
+            resolveItems(batch, chunk);
+        }
+    }
+
+    // Resolves an item, or waits for whichever thread is already resolving it.
+    void ensureResolved(Batch& batch, size_t index) {
+        auto& item = batch.items[index];
+        {
+            std::unique_lock<std::mutex> lock(batch.mutex);
+            if (item.state == BatchItem::State::Resolving) {
+                batch.changed.wait(lock, [&] {
+                    return item.state == BatchItem::State::Ready;
+                });
+            }
+            if (item.state == BatchItem::State::Ready) {
+                return;
+            }
+            item.state = BatchItem::State::Resolving;
+        }
+
+        resolveItems(batch, {index});
+    }
+
+    // Resolves items the caller has marked Resolving, in one round trip.
+    void resolveItems(Batch& batch, const std::vector<size_t>& indices) {
+        std::vector<std::string> assetIds;
+        assetIds.reserve(indices.size());
+        for (auto index : indices) {
+            assetIds.push_back(batch.items[index].assetId);
+        }
+
+        auto resolved = batch.presignOnly
+            ? presignItems(batch, indices, assetIds)
+            : resolveAssets(assetIds);
+
+        {
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            for (size_t j = 0; j < indices.size(); ++j) {
+                auto& item = batch.items[indices[j]];
+                item.resolved = std::move(resolved[j]);
+                item.state = BatchItem::State::Ready;
+                ++batch.numResolved;
+                if (item.resolved.status == DownloadStatus::Success) {
+                    item.countedTotal = item.resolved.fileSize;
+                    batch.totalBytes += item.countedTotal;
+                }
+            }
+        }
+        batch.changed.notify_all();
+    }
+
+    // Presigns items whose file name, size and checksum came with them
+    std::vector<ResolvedAsset> presignItems(
+        Batch& batch,
+        const std::vector<size_t>& indices,
+        const std::vector<std::string>& assetIds
+    ) {
+        auto urls = getDownloadUrlBatch(assetIds);
+
+        std::vector<ResolvedAsset> resolved;
+        resolved.reserve(indices.size());
+        for (size_t j = 0; j < indices.size(); ++j) {
+            auto r = batch.items[indices[j]].resolved;
+            r.downloadUrl = urls[j];
+            r.status = r.downloadUrl.empty()
+                ? DownloadStatus::NotFound
+                : DownloadStatus::Success;
+            resolved.push_back(std::move(r));
+        }
+        return resolved;
+    }
+
+    void runBatchWorker(Batch& batch, const ProgressCallback& progressCallback) {
+        while (!cancelledSince(batch.cancelGeneration)) {
+            size_t index;
+            {
+                std::lock_guard<std::mutex> lock(batch.mutex);
+                if (batch.nextToClaim >= batch.items.size()) {
+                    return;
+                }
+                index = batch.nextToClaim++;
+            }
+            batch.changed.notify_all();
+
+            auto& item = batch.items[index];
+            std::pair<DownloadStatus, std::string> result;
+
+            if (!beginDownload(item.assetId)) {
+                result = {DownloadStatus::Success, ""}; // Already in progress
+            } else {
+                ensureResolved(batch, index);
+
+                auto fileProgress = [&, index](const DownloadProgress& p) {
+                    reportBatchProgress(batch, index, p, false, progressCallback);
+                };
+
+                result = transferResolved(item.resolved, fileProgress, batch.priority);
+                endDownload(item.assetId);
+            }
+
+            if (batch.itemFinished) {
+                batch.itemFinished(index, result);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(batch.mutex);
+                ++batch.completed;
+                if (result.first == DownloadStatus::Success ||
+                    result.first == DownloadStatus::AlreadyExists) {
+                    ++batch.succeeded;
+                } else {
+                    ++batch.failed;
+                }
+            }
+
+            DownloadProgress done;
+            done.assetId = item.assetId;
+            done.fileName = item.resolved.fileName;
+            reportBatchProgress(batch, index, done, true, progressCallback);
+        }
+    }
+
+    // Folds one file's progress into the batch totals and reports the
+    // aggregate, coalesced to the configured rate (a file finishing always
+    // reports, so currentFile never lags).
+    void reportBatchProgress(
+        Batch& batch,
+        size_t index,
+        const DownloadProgress& fileProgress,
+        bool fileFinished,
+        const ProgressCallback& progressCallback
+    ) {
+        if (!progressCallback) return;
+
+        DownloadProgress progress;
+        progress.assetId = fileProgress.assetId;
+        progress.fileName = fileProgress.fileName;
+
+        {
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            auto& item = batch.items[index];
+
+            if (fileProgress.bytesDownloaded > item.bytesDownloaded) {
+                batch.bytesDownloaded += fileProgress.bytesDownloaded - item.bytesDownloaded;
+                item.bytesDownloaded = fileProgress.bytesDownloaded;
+            }
+
+            // Server didn't report a size up front - use Content-Length
+            if (item.countedTotal == 0 && fileProgress.totalBytes > 0) {
+                item.countedTotal = fileProgress.totalBytes;
+                batch.totalBytes += item.countedTotal;
+            }
+
+            progress.bytesDownloaded = batch.bytesDownloaded;
+            progress.totalBytes = batch.totalBytes;
+            progress.currentFile = batch.completed;
+            progress.totalFiles = (int)batch.items.size();
+
+            // Byte-weighted once every size is known, file-weighted until then
+            if (batch.numResolved == batch.items.size() && batch.totalBytes > 0) {
+                progress.percent = (float)batch.bytesDownloaded / batch.totalBytes * 100.0f;
+            } else {
+                progress.percent = (float)batch.completed / batch.items.size() * 100.0f;
+            }
+            progress.percent = std::min(progress.percent, 100.0f);
+
+            if (!batch.meter.update(batch.bytesDownloaded, batch.totalBytes, fileFinished)) {
+                return;
+            }
+            progress.speedBytesPerSec = batch.meter.getSpeed();
+            progress.etaSeconds = batch.meter.getEtaSeconds();
+        }
+
+        std::lock_guard<std::mutex> lock(batch.callbackMutex);
+        progressCallback(progress);
+    }
+
+    // =========================================================================
+    // Asset Packs
+    // =========================================================================
+    // GET /content/packs/<packId>/manifest returns
+    //   {"version": "1.1.0", "files": [{"path": "Kicks/Kick 01.wav",
+    //    "size": ..., "checksum": ..., "asset_id": ...}, ...]}
+    // Each file is an ordinary asset to the presign endpoints (entries may
+    // also carry "download_url" / "expires_at"), so the transfers run through
+    // the batch pipeline with the remote manifest standing in for /info.
+
+#if BEATCONNECT_USE_JUCE
+    struct RemotePack {
+        DownloadStatus status = DownloadStatus::NetworkError;
+        std::string version;
+        std::vector<PackFile> files;
+    };
+
+    juce::File getPackDirectory(const std::string& packId) const {
+        return downloadDir.getChildFile(juce::File::createLegalFileName(juce::String(packId)));
+    }
+
+    RemotePack fetchPackManifest(const std::string& packId, const juce::File& dir) {
+        RemotePack remote;
+
+        // The id is one path segment; "." and ".." would walk out of /packs
+        if (packId.empty() || packId == "." || packId == "..") {
+            remote.status = DownloadStatus::NotFound;
+            return remote;
+        }
+
+        auto request = HttpRequest::get("/content/packs/"
+            + juce::URL::addEscapeChars(packId, false).toStdString() + "/manifest");
+        if (!config.pluginId.empty()) {
+            request.query.emplace_back("plugin_id", config.pluginId);
+        }
+
+        auto response = apiClient()->send(request);
+        if (response.statusCode == 401 || response.statusCode == 403) {
+            remote.status = DownloadStatus::Unauthorized;
+            return remote;
+        }
+        if (response.statusCode == 404) {
+            remote.status = DownloadStatus::NotFound;
+            return remote;
+        }
+        if (!response.ok()) return remote;
+
+        auto json = response.json();
+        auto* files = json.getProperty("files", juce::var()).getArray();
+        if (!files) return remote;
+
+        remote.version = json.getProperty("version", "").toString().toStdString();
+        remote.files.reserve((size_t)files->size());
+        for (const auto& item : *files) {
+            PackFile file;
+            file.path = item.getProperty("path", "").toString().toStdString();
+            file.size = (juce::int64)item.getProperty("size", 0);
+            file.checksum = item.getProperty("checksum", "").toString().toStdString();
+            file.assetId = item.getProperty("asset_id", "").toString().toStdString();
+
+            // Nothing outside the pack directory, and nothing we can't presign
+            if (file.assetId.empty()
+                || !PackManifest::isPackPath(dir.getFullPathName().toStdString(), file.path)) {
+                continue;
+            }
+
+            cacheUrl(file.assetId, item.getProperty("download_url", "").toString().toStdString(),
+                     parseExpiry(item.getProperty("expires_at", 0)));
+            remote.files.push_back(std::move(file));
+        }
+
+        remote.status = DownloadStatus::Success;
+        return remote;
+    }
+
+    PackSyncPlan planPack(
+        const std::string& packId,
+        const RemotePack& remote,
+        const juce::File& dir,
+        PackManifest& local
+    ) {
+        auto plan = diffPack(remote.files, local);
+        plan.packId = packId;
+        plan.version = remote.version;
+
+        // Files the manifest doesn't list (installed by hand, or finished
+        // just before a crash) are kept once their checksum checks out.
+        // Size alone isn't enough here: an edited sample often keeps it.
+        auto keep = std::remove_if(plan.toDownload.begin(), plan.toDownload.end(),
+            [&](const PackFile& file) {
+                if (local.find(file.path)) return false;
+
+                auto algorithm = Digest::algorithmForChecksum(file.checksum);
+                auto localFile = dir.getChildFile(juce::String(file.path));
+                if (!algorithm || !localFile.existsAsFile() || localFile.getSize() != file.size) {
+                    return false;
+                }
+
+                Digest digest(*algorithm);
+                if (!hashFileRange(localFile, 0, file.size, digest)
+                    || !Digest::matchesChecksum(digest.finishHex(), file.checksum)
+                    || !local.put(file)) {
+                    return false;
+                }
+
+                plan.bytesToDownload -= file.size;
+                ++plan.unchanged;
+                return true;
+            });
+        plan.toDownload.erase(keep, plan.toDownload.end());
+        return plan;
+    }
+
+    PackSyncResult runPackSync(
+        const std::string& packId,
+        ProgressCallback progressCallback,
+        DownloadPriority priority
+    ) {
+        PackSyncResult result;
+        if (!configured) return result;
+
+        auto dir = getPackDirectory(packId);
+        result.localPath = dir.getFullPathName().toStdString();
+
+        const auto syncKey = "pack/" + packId;
+        if (!beginDownload(syncKey)) {
+            result.status = DownloadStatus::InProgress;
+            return result;
+        }
+        ScopedOperation operation(*this);
+
+        // Another host process may be syncing the same pack
+        juce::InterProcessLock packLock(DownloadCoordinator::fileLockName(
+            dir.getChildFile(PackManifest::fileName).getFullPathName().toStdString()));
+        juce::InterProcessLock::ScopedLockType lock(packLock);
+
+        auto remote = fetchPackManifest(packId, dir);
+        if (remote.status != DownloadStatus::Success) {
+            result.status = remote.status;
+            endDownload(syncKey);
+            return result;
+        }
+
+        PackManifest local;
+        local.load(result.localPath);
+        auto plan = planPack(packId, remote, dir, local);
+
+        result.moved = movePackFiles(dir, remote, plan, local);
+        local.save();
+
+        auto downloadStatus = DownloadStatus::Success;
+        if (!plan.toDownload.empty()) {
+            result.downloaded = downloadPackFiles(dir, plan.toDownload, local,
+                                                  publishing(progressCallback), priority, downloadStatus);
+            result.failed = (int)plan.toDownload.size() - result.downloaded;
+        }
+
+        // Leave the old files (and version) for the next sync unless this
+        // one got every new file in place
+        if (result.failed == 0) {
+            result.deleted = deletePackFiles(dir, plan.toDelete, local);
+            local.setVersion(remote.version);
+            result.status = DownloadStatus::Success;
+        } else {
+            result.status = downloadStatus;
+        }
+        local.save();
+
+        endDownload(syncKey);
+        return result;
+    }
+
+    // Moves in two passes, through a temporary name beside each source, so
+    // chains and swaps (a -> b, b -> a) never overwrite a file that has yet
+    // to move. Moves that fail become downloads.
+    int movePackFiles(
+        const juce::File& dir,
+        const RemotePack& remote,
+        PackSyncPlan& plan,
+        PackManifest& local
+    ) {
+        std::unordered_map<std::string, const PackFile*> remoteByPath;
+        for (const auto& file : remote.files) {
+            remoteByPath.emplace(file.path, &file);
+        }
+
+        struct Staged {
+            juce::File temp;
+            const PackFile* target;
+        };
+        std::vector<Staged> staged;
+
+        for (const auto& [from, to] : plan.toMove) {
+            const auto* target = remoteByPath[to];
+            auto source = dir.getChildFile(juce::String(from));
+            auto temp = source.getSiblingFile(source.getFileName() + ".beatconnect-move");
+            auto entry = local.find(from);
+
+            if (!entry || !source.moveFileTo(temp)) {
+                plan.toDownload.push_back(*target);
+                continue;
+            }
+            local.remove(from);
+            forgetAsset(entry->file.assetId, source);
+            staged.push_back({temp, target});
+        }
+
+        int moved = 0;
+        for (const auto& [temp, target] : staged) {
+            auto destination = dir.getChildFile(juce::String(target->path));
+            destination.getParentDirectory().createDirectory();
+
+            if (!temp.moveFileTo(destination) || !local.put(*target)) {
+                temp.deleteFile();
+                plan.toDownload.push_back(*target);
+                continue;
+            }
+            recordAsset(*target, destination);
+            ++moved;
+        }
+        return moved;
+    }
+
+    // Returns how many files landed. Each is recorded in the local manifest
+    // as it finishes, saved at most once per packSaveIntervalMs.
+    int downloadPackFiles(
+        const juce::File& dir,
+        const std::vector<PackFile>& files,
+        PackManifest& local,
+        const ProgressCallback& reportProgress,
+        DownloadPriority priority,
+        DownloadStatus& firstFailure
+    ) {
+        Batch batch(config.progressIntervalMs, config.progressStepPercent);
+        batch.priority = priority;
+        batch.cancelGeneration = cancelGeneration.load();
+        batch.presignOnly = true;
+        batch.items.resize(files.size());
+        for (size_t i = 0; i < files.size(); ++i) {
+            auto& item = batch.items[i];
+            item.assetId = files[i].assetId;
+            item.resolved.assetId = files[i].assetId;
+            item.resolved.fileName = dir.getFileName().toStdString() + "/" + files[i].path;
+            item.resolved.fileSize = files[i].size;
+            item.resolved.checksum = files[i].checksum;
+
+            dir.getChildFile(juce::String(files[i].path)).getParentDirectory().createDirectory();
+        }
+
+        std::mutex recordMutex;
+        int landed = 0;
+        bool failed = false;
+        auto lastSave = juce::Time::currentTimeMillis();
+
+        batch.itemFinished = [&](size_t index, const std::pair<DownloadStatus, std::string>& result) {
+            const bool ok = (result.first == DownloadStatus::Success
+                             || result.first == DownloadStatus::AlreadyExists)
+                && local.put(files[index]);
+
+            std::lock_guard<std::mutex> lock(recordMutex);
+            if (!ok) {
+                if (!failed) {
+                    failed = true;
+                    firstFailure = result.first == DownloadStatus::Success
+                        ? DownloadStatus::DiskError  // Reported done, but not on disk
+                        : result.first;
+                }
+                return;
+            }
+
+            ++landed;
+            auto now = juce::Time::currentTimeMillis();
+            if (now - lastSave >= packSaveIntervalMs) {
+                local.save();
+                lastSave = now;
+            }
+        };
+
+        runBatchItems(batch, reportProgress);
+
+        if (landed < (int)files.size() && !failed) {
+            firstFailure = DownloadStatus::Cancelled;  // Workers stopped early
+        }
+        return landed;
+    }
+
+    int deletePackFiles(const juce::File& dir, const std::vector<std::string>& paths, PackManifest& local) {
+        int deleted = 0;
+        for (const auto& path : paths) {
+            auto file = dir.getChildFile(juce::String(path));
+            auto entry = local.find(path);
+            if (!file.deleteFile()) continue;
+
+            if (entry) forgetAsset(entry->file.assetId, file);
+            local.remove(path);
+            ++deleted;
+
+            // Drop directories the pack no longer uses
+            for (auto parent = file.getParentDirectory();
+                 parent.isAChildOf(dir) && parent.getNumberOfChildFiles(juce::File::findFilesAndDirectories) == 0;
+                 parent = parent.getParentDirectory()) {
+                parent.deleteFile();
+            }
+        }
+        return deleted;
+    }
+
+    // Keep the asset manifest in step with pack files that moved or went away
+    void forgetAsset(const std::string& assetId, const juce::File& file) {
+        if (assetId.empty()) return;
+        auto downloads = assetManifest();
+        auto entry = downloads->find(assetId);
+        if (entry && entry->path == file.getFullPathName().toStdString()) {
+            downloads->remove(assetId);
+        }
+    }
+
+    void recordAsset(const PackFile& packFile, const juce::File& file) {
+        auto entry = AssetManifest::describeFile(
+            packFile.assetId, file.getFullPathName().toStdString(), packFile.checksum, "");
+        if (entry) assetManifest()->put(*entry);
+    }
+#endif
+
+    // =========================================================================
+    // Transfer
+    // =========================================================================
+
+    // Retries interrupted transfers; with resumeDownloads each retry (and
+    // each later download of the same file) continues from the bytes already
+    // on disk instead of starting over. Large files of known size can be
+    // fetched as several parallel byte ranges (segmentedDownloads).
+    std::pair<DownloadStatus, std::string> downloadFromUrlInternal(
+        const TransferRequest& request,
+        ProgressCallback progressCallback
+    ) {
+#if BEATCONNECT_USE_JUCE
+        const int maxAttempts = 1 + std::max(0, config.maxRetries);
+
+        bool segmented = config.segmentedDownloads
+            && config.segmentsPerFile > 1
+            && request.expectedSize > 0
+            && request.expectedSize >= config.segmentThresholdBytes;
+
+        for (int attempt = 1;; ++attempt) {
+            auto outcome = segmented
+                ? transferSegmented(request, progressCallback)
+                : transferOnce(request, progressCallback);
+
+            if (outcome.rangesUnsupported) {
+                // Server ignored Range - fall back to one stream, same attempt
+                segmented = false;
+                --attempt;
+                continue;
+            }
+
+            if (!outcome.retryable || attempt >= maxAttempts
+                || cancelledSince(request.cancelGeneration)) {
+                return {outcome.status, outcome.filePath};
+            }
+
+            // Back off 1s, 2s, 4s... before reconnecting
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(1000 << std::min(attempt - 1, 5)));
+
+            if (consumeCancellation(request.assetId)) {
+                discardPartial(downloadDir.getChildFile(request.fileName));
+                return {DownloadStatus::Cancelled, ""};
+            }
+        }
+#else
+        return {DownloadStatus::NetworkError, ""};
+#endif
+    }
+
+#if BEATCONNECT_USE_JUCE
+    struct TransferOutcome {
+        DownloadStatus status = DownloadStatus::NetworkError;
+        std::string filePath;
+        bool retryable = false;
+        bool rangesUnsupported = false;
+    };
+
+    // One byte range of a segmented download. [start, end] is inclusive, as
+    // in the Range header; next is the first byte not yet written.
+    struct Segment {
+        int64_t start = 0;
+        int64_t end = 0;
+        int64_t next = 0;
+
+        bool isComplete() const { return next > end; }
+    };
+
+    // Sidecar stored next to a partial .download file. It records what the
+    // partial bytes belong to so a later Range request can continue them.
+    // Single-stream partials are a contiguous prefix and have no segments.
+    struct PartialInfo {
+        int64_t totalBytes = 0;
+        juce::String etag;
+        std::vector<Segment> segments;
+    };
+
+    static juce::File getTempFile(const juce::File& targetFile) {
+        return targetFile.getSiblingFile(targetFile.getFileName() + ".download");
+    }
+
+    static juce::File getPartialInfoFile(const juce::File& targetFile) {
+        return targetFile.getSiblingFile(targetFile.getFileName() + ".download.json");
+    }
+
+    static std::optional<PartialInfo> loadPartialInfo(const juce::File& targetFile) {
+        auto infoFile = getPartialInfoFile(targetFile);
+        if (!infoFile.existsAsFile()) return std::nullopt;
+
+        auto json = juce::JSON::parse(infoFile.loadFileAsString());
+        auto* obj = json.getDynamicObject();
+        if (!obj) return std::nullopt;
+
+        PartialInfo info;
+        info.totalBytes = (juce::int64)obj->getProperty("total_bytes");
+        info.etag = obj->getProperty("etag").toString();
+
+        if (auto* segments = obj->getProperty("segments").getArray()) {
+            for (const auto& s : *segments) {
+                Segment segment;
+                segment.start = (juce::int64)s.getProperty("start", 0);
+                segment.end = (juce::int64)s.getProperty("end", 0);
+                segment.next = (juce::int64)s.getProperty("next", 0);
+                info.segments.push_back(segment);
+            }
+        }
+        return info;
+    }
+
+    static void savePartialInfo(const juce::File& targetFile, const PartialInfo& info) {
+        juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+        obj->setProperty("total_bytes", (juce::int64)info.totalBytes);
+        obj->setProperty("etag", info.etag);
+
+        if (!info.segments.empty()) {
+            juce::Array<juce::var> segments;
+            for (const auto& segment : info.segments) {
+                juce::DynamicObject::Ptr s = new juce::DynamicObject();
+                s->setProperty("start", (juce::int64)segment.start);
+                s->setProperty("end", (juce::int64)segment.end);
+                s->setProperty("next", (juce::int64)segment.next);
+                segments.add(juce::var(s.get()));
+            }
+            obj->setProperty("segments", segments);
+        }
+
+        getPartialInfoFile(targetFile).replaceWithText(
+            juce::JSON::toString(juce::var(obj.get())));
+    }
+
+    static void discardPartial(const juce::File& targetFile) {
+        getTempFile(targetFile).deleteFile();
+        getPartialInfoFile(targetFile).deleteFile();
+    }
+
+    // "bytes 100-199/1000" -> 1000 (0 if unknown)
+    static int64_t parseContentRangeTotal(const juce::String& contentRange) {
+        auto total = contentRange.fromLastOccurrenceOf("/", false, false).trim();
+        return total == "*" ? 0 : total.getLargeIntValue();
+    }
+
+    // Digest for the request's checksum, or nullopt when not verifying
+    std::optional<Digest> createDigest(const TransferRequest& request) const {
+        if (!config.verifyChecksums) return std::nullopt;
+        auto algorithm = Digest::algorithmForChecksum(request.checksum);
+        if (!algorithm) return std::nullopt;
+        return Digest(*algorithm);
+    }
+
+    static bool hashFileRange(const juce::File& file, int64_t start, int64_t end, Digest& digest) {
+        if (end <= start) return true;
+
+        auto input = file.createInputStream();
+        if (!input || !input->setPosition(start)) return false;
+
+        const int bufferSize = 65536;
+        juce::HeapBlock<char> buffer(bufferSize);
+        for (auto position = start; position < end;) {
+            auto wanted = (int)std::min<int64_t>(bufferSize, end - position);
+            int read = input->read(buffer, wanted);
+            if (read <= 0) return false;
+            digest.update(buffer, (size_t)read);
+            position += read;
+        }
+        return true;
+    }
+
+    bool consumeCancellation(const std::string& assetId) {
+        if (assetId.empty()) return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        return cancelledDownloads.erase(assetId) > 0;
+    }
+
+    bool isCancellationPending(const std::string& assetId) const {
+        if (assetId.empty()) return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        return cancelledDownloads.count(assetId) > 0;
+    }
+
+    // Rate cap and host-transport pause, applied after each chunk is written
+    void throttle(int64_t bytes, const std::string& assetId) {
+        bandwidthLimiter()->consume(bytes, [this, &assetId] { return isCancellationPending(assetId); });
+    }
+
+    // One HTTP request. Appends to an existing partial file when the server
+    // honors the Range request, otherwise (re)writes it from the start.
+    TransferOutcome transferOnce(
+        const TransferRequest& request,
+        const ProgressCallback& progressCallback
+    ) {
+        TransferOutcome outcome;
+        const auto& fileName = request.fileName;
+        const auto& assetId = request.assetId;
+
+        auto targetFile = downloadDir.getChildFile(fileName);
+        auto tempFile = getTempFile(targetFile);
+
+        // Pick up where a previous attempt stopped, if we know what it was
+        int64_t resumeFrom = 0;
+        PartialInfo partial;
+        if (config.resumeDownloads && tempFile.existsAsFile()) {
+            auto saved = loadPartialInfo(targetFile);
+            if (saved && saved->segments.empty()) {
+                partial = *saved;
+                resumeFrom = tempFile.getSize();
+                if (partial.totalBytes > 0 && resumeFrom > partial.totalBytes) {
+                    resumeFrom = 0;
+                }
+            }
+        }
+        if (resumeFrom == 0) {
+            discardPartial(targetFile);
+            partial = PartialInfo{};
+        } else if (resumeFrom == partial.totalBytes) {
+            // Every byte arrived last time; only the rename was missed
+            auto digest = createDigest(request);
+            if (digest && !hashFileRange(tempFile, 0, resumeFrom, *digest)) {
+                discardPartial(targetFile);
+                outcome.status = DownloadStatus::DiskError;
+                return outcome;
+            }
+            return finishTransfer(targetFile, request, digest, partial.etag);
+        }
+
+        auto get = HttpRequest::get(request.url);
+        if (resumeFrom > 0) {
+            get.headers = "Range: bytes=" + std::to_string(resumeFrom) + "-\r\n";
+            if (partial.etag.isNotEmpty()) {
+                get.headers += "If-Range: " + partial.etag.toStdString() + "\r\n";
+            }
+        }
+
+        // Create input stream
+        HttpResponse head;
+        auto stream = storageClient()->openStream(get, head);
+        const int statusCode = head.statusCode;
+
+        if (statusCode == 401 || statusCode == 403) {
+            outcome.status = DownloadStatus::Unauthorized;
+            return outcome;
+        }
+        if (statusCode == 404) {
+            outcome.status = DownloadStatus::NotFound;
+            return outcome;
+        }
+        if (statusCode == 416) {
+            // Our partial no longer matches the remote file - start over
+            discardPartial(targetFile);
+            outcome.retryable = true;
+            return outcome;
+        }
+        if (!stream || statusCode >= 400) {
+            outcome.retryable = statusCode == 0 || statusCode == 408 || statusCode >= 500;
+            return outcome;
+        }
+
+        // 206 continues our partial; anything else is the whole file again
+        const bool appending = resumeFrom > 0 && statusCode == 206;
+        if (!appending) {
+            resumeFrom = 0;
+            tempFile.deleteFile();
+        }
+
+        // Get content length
+        int64_t contentLength = appending
+            ? parseContentRangeTotal(juce::String(head.header("Content-Range")))
+            : stream->getTotalLength();
+        if (contentLength <= 0 && appending) {
+            contentLength = partial.totalBytes;
+        }
+
+        if (config.resumeDownloads) {
+            partial.totalBytes = contentLength;
+            partial.etag = juce::String(head.header("ETag"));
+            savePartialInfo(targetFile, partial);
+        }
+
+        // Create output file (FileOutputStream appends to an existing file)
+        auto output = tempFile.createOutputStream();
+        if (!output) {
+            discardPartial(targetFile);
+            outcome.status = DownloadStatus::DiskError;
+            return outcome;
+        }
+
+        // Hash while the bytes stream in. A resumed partial's existing prefix is
+        // the only part that has to be read back from disk.
+        auto digest = createDigest(request);
+        if (digest && appending && !hashFileRange(tempFile, 0, resumeFrom, *digest)) {
+            output.reset();
+            discardPartial(targetFile);
+            outcome.status = DownloadStatus::DiskError;
+            return outcome;
+        }
+
+        // Download with progress
+        const int bufferSize = 65536;
+        juce::HeapBlock<char> buffer(bufferSize);
+        int64_t bytesRead = resumeFrom;
+
+        ProgressMeter meter(config.progressIntervalMs, config.progressStepPercent);
+        int64_t reportedBytes = -1;
+        auto reportProgress = [&](bool force) {
+            if (!progressCallback || !meter.update(bytesRead, contentLength, force)) return;
+
+            DownloadProgress progress;
+            progress.assetId = assetId;
+            progress.fileName = fileName;
+            progress.bytesDownloaded = bytesRead;
+            progress.totalBytes = contentLength;
+            progress.percent = meter.getPercent();
+            progress.speedBytesPerSec = meter.getSpeed();
+            progress.etaSeconds = meter.getEtaSeconds();
+
+            progressCallback(progress);
+            reportedBytes = bytesRead;
+        };
+
+        while (!stream->isExhausted()) {
+            // Check for cancellation
+            if (consumeCancellation(assetId)) {
+                output.reset();
+                discardPartial(targetFile);
+                outcome.status = DownloadStatus::Cancelled;
+                return outcome;
+            }
+
+            int read = stream->read(buffer, bufferSize);
+            if (read <= 0) break;
+
+            if (!output->write(buffer, read)) {
+                output.reset();
+                discardPartial(targetFile);
+                outcome.status = DownloadStatus::DiskError;
+                return outcome;
+            }
+
+            if (digest) {
+                digest->update(buffer, (size_t)read);
+            }
+
+            bytesRead += read;
+
+            // Report progress
+            reportProgress(contentLength > 0 && bytesRead >= contentLength);
+
+            throttle(read, assetId);
+        }
+
+        // Whatever was coalesced away since the last report
+        if (bytesRead != reportedBytes) {
+            reportProgress(true);
+        }
+
+        output.reset();
+
+        // Connection dropped before the end - keep the partial for a resume
+        if (contentLength > 0 && bytesRead < contentLength) {
+            if (!config.resumeDownloads) {
+                discardPartial(targetFile);
+            }
+            outcome.retryable = true;
+            return outcome;
+        }
+
+        auto finished = finishTransfer(targetFile, request, digest, partial.etag);
+
+        // A bad splice onto an old partial can be fixed by a clean retry
+        finished.retryable = finished.status == DownloadStatus::Corrupted && appending;
+        return finished;
+    }
+
+    // Shared state for the range requests of one segmented transfer.
+    struct SegmentedTransfer {
+        SegmentedTransfer(int progressIntervalMs, float progressStepPercent)
+            : meter(progressIntervalMs, progressStepPercent) {}
+
+        std::mutex mutex;          // Guards output, partial and the fields below
+        juce::FileOutputStream* output = nullptr;
+        PartialInfo partial;
+        int64_t bytesDone = 0;
+        ProgressMeter meter;
+
+        std::atomic<bool> abort{false};
+        DownloadStatus failure = DownloadStatus::Success;
+        bool retryable = true;
+        bool cancelled = false;
+        bool rangesUnsupported = false;
+        bool staleRanges = false;  // Remote file changed under us
+
+        // Checksum verification runs on its own thread, hashing the file's
+        // contiguous written prefix while the ranges are still downloading
+        Digest* digest = nullptr;
+        std::condition_variable prefixGrew;
+        bool writersDone = false;
+        bool hashFailed = false;
+
+        std::mutex callbackMutex;
+
+        // Records the first failure; fatal ones stop the other ranges too
+        void fail(DownloadStatus status, bool canRetry) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (failure == DownloadStatus::Success) {
+                failure = status;
+                retryable = canRetry;
+            }
+            if (!canRetry) abort = true;
+        }
+    };
+
+    // End of the leading run of bytes that are all on disk
+    static int64_t contiguousPrefix(const PartialInfo& partial) {
+        for (const auto& segment : partial.segments) {
+            if (!segment.isComplete()) return segment.next;
+        }
+        return partial.totalBytes;
+    }
+
+    static std::vector<Segment> planSegments(int64_t totalBytes, int maxSegments) {
+        // Don't split below 1 MB per range - the request overhead dominates
+        const int64_t minSegmentBytes = 1024 * 1024;
+        auto count = std::clamp<int64_t>((totalBytes + minSegmentBytes - 1) / minSegmentBytes,
+                                         1, std::max(1, maxSegments));
+        auto segmentBytes = (totalBytes + count - 1) / count;
+
+        std::vector<Segment> segments;
+        for (int64_t start = 0; start < totalBytes; start += segmentBytes) {
+            Segment segment;
+            segment.start = start;
+            segment.end = std::min(start + segmentBytes, totalBytes) - 1;
+            segment.next = start;
+            segments.push_back(segment);
+        }
+        return segments;
+    }
+
+    // Creates the file at its final size so ranges can be written in place
+    static bool preallocate(const juce::File& file, int64_t size) {
+        file.deleteFile();
+        auto output = file.createOutputStream();
+        if (!output) return false;
+
+        const char zero = 0;
+        return output->setPosition(size - 1) && output->write(&zero, 1);
+    }
+
+    // Fetches a file of known size as parallel byte ranges written at their
+    // offsets into a preallocated .download file. Range progress is kept in
+    // the sidecar, so a retry only refetches what each range is missing.
+    // The whole file occupies a single transfer slot.
+    TransferOutcome transferSegmented(
+        const TransferRequest& request,
+        const ProgressCallback& progressCallback
+    ) {
+        TransferOutcome outcome;
+        const int64_t totalBytes = request.expectedSize;
+
+        auto targetFile = downloadDir.getChildFile(request.fileName);
+        auto tempFile = getTempFile(targetFile);
+
+        SegmentedTransfer transfer(config.progressIntervalMs, config.progressStepPercent);
+        auto& partial = transfer.partial;
+
+        // Continue the previous attempt's ranges if they describe this file
+        if (config.resumeDownloads && tempFile.existsAsFile()) {
+            auto saved = loadPartialInfo(targetFile);
+            if (saved && !saved->segments.empty()
+                && saved->totalBytes == totalBytes
+                && tempFile.getSize() == totalBytes) {
+                partial = *saved;
+            }
+        }
+
+        if (partial.segments.empty()) {
+            discardPartial(targetFile);
+            partial.totalBytes = totalBytes;
+            partial.segments = planSegments(totalBytes, config.segmentsPerFile);
+
+            if (!preallocate(tempFile, totalBytes)) {
+                discardPartial(targetFile);
+                outcome.status = DownloadStatus::DiskError;
+                return outcome;
+            }
+        }
+
+        auto output = tempFile.createOutputStream();
+        if (!output) {
+            discardPartial(targetFile);
+            outcome.status = DownloadStatus::DiskError;
+            return outcome;
+        }
+        transfer.output = output.get();
+
+        for (const auto& segment : partial.segments) {
+            transfer.bytesDone += segment.next - segment.start;
+        }
+
+        auto digest = createDigest(request);
+        std::thread hasher;
+        if (digest) {
+            transfer.digest = &*digest;
+            hasher = std::thread([this, &tempFile, &transfer]() {
+                enterBackgroundPriority();
+                hashWrittenPrefix(tempFile, transfer);
+            });
+        }
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < partial.segments.size(); ++i) {
+            if (!partial.segments[i].isComplete()) {
+                workers.emplace_back([this, &request, &transfer, &progressCallback, i]() {
+                    enterBackgroundPriority();
+                    fetchSegment(request, transfer, i, progressCallback);
+                });
+            }
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        output->flush();
+        if (hasher.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(transfer.mutex);
+                transfer.writersDone = true;
+            }
+            transfer.prefixGrew.notify_one();
+            hasher.join();
+        }
+        output.reset();
+
+        if (transfer.cancelled) {
+            discardPartial(targetFile);
+            outcome.status = DownloadStatus::Cancelled;
+            return outcome;
+        }
+        if (transfer.rangesUnsupported) {
+            discardPartial(targetFile);
+            outcome.rangesUnsupported = true;
+            return outcome;
+        }
+        if (transfer.staleRanges) {
+            discardPartial(targetFile);
+            outcome.retryable = true;
+            return outcome;
+        }
+
+        bool complete = std::all_of(partial.segments.begin(), partial.segments.end(),
+                                    [](const Segment& s) { return s.isComplete(); });
+
+        if (complete && transfer.hashFailed) {
+            discardPartial(targetFile);
+            outcome.status = DownloadStatus::DiskError;
+            return outcome;
+        }
+
+        if (!complete || transfer.failure != DownloadStatus::Success) {
+            if (transfer.retryable && config.resumeDownloads) {
+                savePartialInfo(targetFile, partial);
+            } else {
+                discardPartial(targetFile);
+            }
+            outcome.status = transfer.failure == DownloadStatus::Success
+                ? DownloadStatus::NetworkError
+                : transfer.failure;
+            outcome.retryable = transfer.retryable;
+            return outcome;
+        }
+
+        return finishTransfer(targetFile, request, digest, transfer.partial.etag);
+    }
+
+    // Feeds the digest from disk as the contiguous written prefix grows.
+    // Writers flush whenever they extend the prefix, so this only reads
+    // bytes that were just written (usually still in the OS cache).
+    static void hashWrittenPrefix(const juce::File& tempFile, SegmentedTransfer& transfer) {
+        auto input = tempFile.createInputStream();
+
+        const int bufferSize = 65536;
+        juce::HeapBlock<char> buffer(bufferSize);
+        int64_t hashed = 0;
+
+        while (true) {
+            int64_t available;
+            {
+                std::unique_lock<std::mutex> lock(transfer.mutex);
+                transfer.prefixGrew.wait(lock, [&] {
+                    return transfer.writersDone || transfer.abort
+                        || contiguousPrefix(transfer.partial) > hashed;
+                });
+                available = contiguousPrefix(transfer.partial);
+                if (transfer.abort || available <= hashed) return;
+            }
+
+            if (!input || !input->setPosition(hashed)) {
+                std::lock_guard<std::mutex> lock(transfer.mutex);
+                transfer.hashFailed = true;
+                return;
+            }
+
+            while (hashed < available) {
+                auto wanted = (int)std::min<int64_t>(bufferSize, available - hashed);
+                int read = input->read(buffer, wanted);
+                if (read <= 0) {
+                    std::lock_guard<std::mutex> lock(transfer.mutex);
+                    transfer.hashFailed = true;
+                    return;
+                }
+                transfer.digest->update(buffer, (size_t)read);
+                hashed += read;
+            }
+        }
+    }
+
+    void fetchSegment(
+        const TransferRequest& request,
+        SegmentedTransfer& transfer,
+        size_t index,
+        const ProgressCallback& progressCallback
+    ) {
+        int64_t next, end;
+        juce::String etag;
+        {
+            std::lock_guard<std::mutex> lock(transfer.mutex);
+            next = transfer.partial.segments[index].next;
+            end = transfer.partial.segments[index].end;
+            etag = transfer.partial.etag;
+        }
+
+        auto get = HttpRequest::get(request.url);
+        get.headers = "Range: bytes=" + std::to_string(next) + "-" + std::to_string(end) + "\r\n";
+        if (etag.isNotEmpty()) {
+            get.headers += "If-Range: " + etag.toStdString() + "\r\n";
+        }
+
+        HttpResponse head;
+        auto stream = storageClient()->openStream(get, head);
+        const int statusCode = head.statusCode;
+
+        if (statusCode == 401 || statusCode == 403) {
+            transfer.fail(DownloadStatus::Unauthorized, false);
+            return;
+        }
+        if (statusCode == 404) {
+            transfer.fail(DownloadStatus::NotFound, false);
+            return;
+        }
+        if (stream && statusCode == 200) {
+            // Whole file instead of our range (or If-Range no longer matched)
+            std::lock_guard<std::mutex> lock(transfer.mutex);
+            if (etag.isNotEmpty()) transfer.staleRanges = true;
+            else transfer.rangesUnsupported = true;
+            transfer.abort = true;
+            return;
+        }
+        if (statusCode == 416) {
+            std::lock_guard<std::mutex> lock(transfer.mutex);
+            transfer.staleRanges = true;
+            transfer.abort = true;
+            return;
+        }
+        if (!stream || statusCode != 206) {
+            transfer.fail(DownloadStatus::NetworkError,
+                          statusCode == 0 || statusCode == 408 || statusCode >= 500);
+            return;
+        }
+
+        // All ranges must come from the same version of the file
+        {
+            std::lock_guard<std::mutex> lock(transfer.mutex);
+            auto responseEtag = juce::String(head.header("ETag"));
+            if (transfer.partial.etag.isEmpty()) {
+                transfer.partial.etag = responseEtag;
+            } else if (responseEtag.isNotEmpty() && responseEtag != transfer.partial.etag) {
+                transfer.staleRanges = true;
+                transfer.abort = true;
+                return;
+            }
+        }
+
+        const int bufferSize = 65536;
+        juce::HeapBlock<char> buffer(bufferSize);
+
+        while (next <= end && !transfer.abort && !stream->isExhausted()) {
+            if (consumeCancellation(request.assetId)) {
+                std::lock_guard<std::mutex> lock(transfer.mutex);
+                transfer.cancelled = true;
+                transfer.abort = true;
+                return;
+            }
+
+            auto wanted = (int)std::min<int64_t>(bufferSize, end - next + 1);
+            int read = stream->read(buffer, wanted);
+            if (read <= 0) break;
+
+            DownloadProgress progress;
+            bool prefixGrew = false;
+            bool reportDue = false;
+            {
+                std::lock_guard<std::mutex> lock(transfer.mutex);
+                if (!transfer.output->setPosition(next)
+                    || !transfer.output->write(buffer, (size_t)read)) {
+                    transfer.failure = DownloadStatus::DiskError;
+                    transfer.retryable = false;
+                    transfer.abort = true;
+                    transfer.prefixGrew.notify_one();
+                    return;
+                }
+
+                auto prefixBefore = contiguousPrefix(transfer.partial);
+                next += read;
+                transfer.partial.segments[index].next = next;
+                transfer.bytesDone += read;
+
+                if (transfer.digest && contiguousPrefix(transfer.partial) > prefixBefore) {
+                    transfer.output->flush();
+                    prefixGrew = true;
+                }
+
+                // One meter for all ranges, so the file reports at the
+                // configured rate however many ranges are running
+                reportDue = transfer.meter.update(transfer.bytesDone, request.expectedSize,
+                                                  transfer.bytesDone >= request.expectedSize);
+                if (reportDue) {
+                    progress.bytesDownloaded = transfer.bytesDone;
+                    progress.percent = transfer.meter.getPercent();
+                    progress.speedBytesPerSec = transfer.meter.getSpeed();
+                    progress.etaSeconds = transfer.meter.getEtaSeconds();
+                }
+            }
+            if (prefixGrew) {
+                transfer.prefixGrew.notify_one();
+            }
+
+            // Report progress
+            if (progressCallback && reportDue) {
+                progress.assetId = request.assetId;
+                progress.fileName = request.fileName;
+                progress.totalBytes = request.expectedSize;
+
+                std::lock_guard<std::mutex> lock(transfer.callbackMutex);
+                progressCallback(progress);
+            }
+
+            throttle(read, request.assetId);
+        }
+
+        // Connection dropped before the end of the range
+        if (next <= end && !transfer.abort) {
+            transfer.fail(DownloadStatus::NetworkError, true);
+        }
+    }
+
+    // Verifies the finished digest (if any), then moves the temp file to its
+    // final location. A mismatch discards the partial and reports Corrupted.
+    TransferOutcome finishTransfer(
+        const juce::File& targetFile,
+        const TransferRequest& request,
+        std::optional<Digest>& digest,
+        const juce::String& etag
+    ) {
+        TransferOutcome outcome;
+        auto tempFile = getTempFile(targetFile);
+
+        if (digest && !Digest::matchesChecksum(digest->finishHex(), request.checksum)) {
+            discardPartial(targetFile);
+            outcome.status = DownloadStatus::Corrupted;
+            return outcome;
+        }
+
+        getPartialInfoFile(targetFile).deleteFile();
+        if (!tempFile.moveFileTo(targetFile)) {
+            tempFile.deleteFile();
+            outcome.status = DownloadStatus::DiskError;
+            return outcome;
+        }
+
+        outcome.status = DownloadStatus::Success;
+        outcome.filePath = targetFile.getFullPathName().toStdString();
+
+        if (!request.assetId.empty()) {
+            auto entry = AssetManifest::describeFile(
+                request.assetId, outcome.filePath, request.checksum, etag.toStdString());
+            if (entry) assetManifest()->put(*entry);
+        }
+        return outcome;
+    }
+#endif
+
+    // Rebuilt when the config or token changes (caller holds mutex), so the
+    // auth header is formatted once rather than per request
+    void rebuildClients() {
+        auto apiHttp = std::make_shared<HttpClient>(config.apiBaseUrl, config.requestTimeoutMs);
+        if (!config.authToken.empty()) {
+            apiHttp->setDefaultHeader("Authorization", "Bearer " + config.authToken);
+        }
+        api = std::move(apiHttp);
+
+        // Presigned URLs carry their own auth
+        storage = std::make_shared<HttpClient>("", config.requestTimeoutMs);
+    }
+
+    std::shared_ptr<const HttpClient> apiClient() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return api;
+    }
+
+    std::shared_ptr<const HttpClient> storageClient() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return storage;
+    }
+
+    // configure() swaps these under the mutex (joining or leaving the shared
+    // service), so everything else works on a snapshot
+    std::shared_ptr<AssetManifest> assetManifest() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return manifest;
+    }
+
+    std::shared_ptr<TransferSlots> slots() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return transferSlots;
+    }
+
+    std::shared_ptr<DownloadCoordinator> sharedCoordinator() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return coordinator;
+    }
+
+    std::shared_ptr<BandwidthLimiter> bandwidthLimiter() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return bandwidth;
+    }
+
+    mutable std::mutex mutex;
+    DownloaderConfig config;
+    bool configured = false;
+    std::shared_ptr<const HttpClient> api = std::make_shared<HttpClient>();
+    std::shared_ptr<const HttpClient> storage = std::make_shared<HttpClient>();
+    std::atomic<uint64_t> cancelGeneration{0};  // Moved on by cancelAll
+    std::shared_ptr<TransferSlots> transferSlots = std::make_shared<TransferSlots>();
+    std::shared_ptr<AssetManifest> manifest = std::make_shared<AssetManifest>();
+    std::shared_ptr<DownloadCoordinator> coordinator;  // Set in shared mode
+
+    // Own limiter, or the coordinator's in shared mode
+    std::shared_ptr<BandwidthLimiter> ownBandwidth = std::make_shared<BandwidthLimiter>();
+    std::shared_ptr<BandwidthLimiter> bandwidth = ownBandwidth;
+    std::shared_ptr<std::atomic<bool>> transportActive = std::make_shared<std::atomic<bool>>(false);
+
+    ProgressSnapshotCell progressSnapshot;
+    std::atomic<int> activeOperations{0};
+
+    // Detached threads started by launchWorker, waited for by ~Impl
+    std::mutex workersMutex;
+    std::condition_variable workersIdle;
+    int runningWorkers = 0;
+
+#if BEATCONNECT_USE_JUCE
+    juce::File downloadDir;
+#endif
+
+    std::unordered_set<std::string> activeDownloads;
+    std::unordered_set<std::string> cancelledDownloads;
+
+    // Presigned URLs by assetId, reused until shortly before they expire
+    struct PresignedUrl {
+        std::string url;
+        int64_t expiresAtMs = 0;
+    };
+    std::unordered_map<std::string, PresignedUrl> presignedUrls;
+    std::atomic<bool> batchInfoUnsupported{false};
+    std::atomic<bool> batchUrlsUnsupported{false};
+
+    static constexpr size_t presignBatchSize = 100;
+    static constexpr int64_t presignMarginMs = 60 * 1000;
+    static constexpr int64_t presignDefaultTtlMs = 5 * 60 * 1000;  // When the server gives no expiry
+
+    static constexpr const char* manifestFileName = ".beatconnect-manifest.json";
+    static constexpr int64_t packSaveIntervalMs = 1000;
+};
+
+// ==============================================================================
+// AssetDownloader Public API
+// ==============================================================================
+
+AssetDownloader::AssetDownloader() : pImpl(std::make_unique<Impl>()) {}
+AssetDownloader::~AssetDownloader() = default;
+
+void AssetDownloader::configure(const DownloaderConfig& config) {
+    pImpl->configure(config);
+}
+
+void AssetDownloader::setAuthToken(const std::string& token) {
+    pImpl->setAuthToken(token);
+}
+
+std::optional<AssetInfo> AssetDownloader::getAssetInfo(const std::string& assetId) {
+    return pImpl->getAssetInfo(assetId);
+}
+
+std::string AssetDownloader::getDownloadUrl(const std::string& assetId) {
+    return pImpl->getDownloadUrl(assetId);
+}
+
+std::vector<std::optional<AssetInfo>> AssetDownloader::getAssetInfoBatch(
+    const std::vector<std::string>& assetIds
+) {
+    return pImpl->getAssetInfoBatch(assetIds);
+}
+
+std::vector<std::string> AssetDownloader::getDownloadUrlBatch(const std::vector<std::string>& assetIds) {
+    return pImpl->getDownloadUrlBatch(assetIds);
+}
+
+std::pair<DownloadStatus, std::string> AssetDownloader::download(
+    const std::string& assetId,
+    ProgressCallback progressCallback,
+    DownloadPriority priority
+) {
+    return pImpl->download(assetId, progressCallback, priority);
+}
+
+void AssetDownloader::downloadAsync(
+    const std::string& assetId,
     ProgressCallback progressCallback,
-    CompletionCallback completionCallback
+    CompletionCallback completionCallback,
+    DownloadPriority priority
 ) {
-    pImpl->downloadAsync(assetId, progressCallback, completionCallback);
+    pImpl->downloadAsync(assetId, progressCallback, completionCallback, priority);
 }
 
 void AssetDownloader::downloadBatch(
     const std::vector<std::string>& assetIds,
     ProgressCallback progressCallback,
-    BatchCompletionCallback completionCallback
+    BatchCompletionCallback completionCallback,
+    DownloadPriority priority
 ) {
-    pImpl->downloadBatch(assetIds, progressCallback, completionCallback);
+    pImpl->downloadBatch(assetIds, progressCallback, completionCallback, priority);
 }
 
 std::pair<DownloadStatus, std::string> AssetDownloader::downloadFromUrl(
     const std::string& url,
     const std::string& fileName,
-    ProgressCallback progressCallback
+    ProgressCallback progressCallback,
+    DownloadPriority priority
+) {
+    return pImpl->downloadFromUrl(url, fileName, progressCallback, priority);
+}
+
+std::optional<PackSyncPlan> AssetDownloader::planPackSync(const std::string& packId) {
+    return pImpl->planPackSync(packId);
+}
+
+void AssetDownloader::syncPack(
+    const std::string& packId,
+    ProgressCallback progressCallback,
+    PackSyncCallback completionCallback,
+    DownloadPriority priority
 ) {
-    return pImpl->downloadFromUrl(url, fileName, progressCallback);
+    pImpl->syncPack(packId, progressCallback, completionCallback, priority);
 }
 
 void AssetDownloader::cancel(const std::string& assetId) {
@@ -530,6 +2441,14 @@ bool AssetDownloader::isDownloading() const {
     return pImpl->isDownloading();
 }
 
+DownloadProgressSnapshot AssetDownloader::getProgressSnapshot() const {
+    return pImpl->getProgressSnapshot();
+}
+
+void AssetDownloader::setHostTransportActive(bool playingOrRecording) {
+    pImpl->setHostTransportActive(playingOrRecording);
+}
+
 bool AssetDownloader::isDownloaded(const std::string& assetId) const {
     return pImpl->isDownloaded(assetId);
 }
@@ -0,0 +1,200 @@
+/**
+ * Asset Manifest - Implementation
+ */
+
+#include "AssetManifest.h"
+
+#if BEATCONNECT_USE_JUCE
+    #include <juce_core/juce_core.h>
+#endif
+
+namespace beatconnect {
+
+AssetManifest::~AssetManifest() {
+    flush();
+}
+
+void AssetManifest::load(const std::string& path) {
+    flush();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    manifestPath = path;
+    entries.clear();
+    totalSize = 0;
+    dirty = false;
+
+#if BEATCONNECT_USE_JUCE
+    juce::File file(manifestPath);
+    if (!file.existsAsFile()) return;
+
+    auto json = juce::JSON::parse(file.loadFileAsString());
+    auto* assets = json.getProperty("assets", juce::var()).getArray();
+    if (!assets) return;
+
+    bool pruned = false;
+    for (const auto& item : *assets) {
+        AssetManifestEntry entry;
+        entry.assetId = item.getProperty("asset_id", "").toString().toStdString();
+        entry.path = item.getProperty("path", "").toString().toStdString();
+        entry.size = (juce::int64)item.getProperty("size", 0);
+        entry.checksum = item.getProperty("checksum", "").toString().toStdString();
+        entry.etag = item.getProperty("etag", "").toString().toStdString();
+        entry.modifiedTime = (juce::int64)item.getProperty("modified_time", 0);
+
+        if (entry.assetId.empty() || entry.path.empty()) {
+            pruned = true;
+            continue;
+        }
+
+        // Deleted or replaced behind our back
+        juce::File assetFile(entry.path);
+        if (!assetFile.existsAsFile()
+            || assetFile.getSize() != entry.size
+            || assetFile.getLastModificationTime().toMilliseconds() != entry.modifiedTime) {
+            pruned = true;
+            continue;
+        }
+
+        totalSize += entry.size;
+        entries[entry.assetId] = std::move(entry);
+    }
+
+    if (pruned) {
+        dirty = true;
+        lock.unlock();
+        flush();
+    }
+#endif
+}
+
+std::optional<AssetManifestEntry> AssetManifest::find(const std::string& assetId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(assetId);
+    if (it == entries.end()) return std::nullopt;
+    return it->second;
+}
+
+void AssetManifest::put(const AssetManifestEntry& entry) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = entries.find(entry.assetId);
+    if (it != entries.end()) {
+        totalSize -= it->second.size;
+    }
+    entries[entry.assetId] = entry;
+    totalSize += entry.size;
+    dirty = true;
+    lock.unlock();
+
+    flushIfDue();
+}
+
+bool AssetManifest::remove(const std::string& assetId) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = entries.find(assetId);
+    if (it == entries.end()) return false;
+
+    totalSize -= it->second.size;
+    entries.erase(it);
+    dirty = true;
+    lock.unlock();
+
+    flushIfDue();
+    return true;
+}
+
+int64_t AssetManifest::getTotalSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalSize;
+}
+
+std::optional<AssetManifestEntry> AssetManifest::describeFile(
+    const std::string& assetId,
+    const std::string& path,
+    const std::string& checksum,
+    const std::string& etag
+) {
+#if BEATCONNECT_USE_JUCE
+    juce::File file(path);
+    if (!file.existsAsFile()) return std::nullopt;
+
+    AssetManifestEntry entry;
+    entry.assetId = assetId;
+    entry.path = path;
+    entry.size = file.getSize();
+    entry.checksum = checksum;
+    entry.etag = etag;
+    entry.modifiedTime = file.getLastModificationTime().toMilliseconds();
+    return entry;
+#else
+    (void)assetId; (void)path; (void)checksum; (void)etag;
+    return std::nullopt;
+#endif
+}
+
+void AssetManifest::flushIfDue() {
+#if BEATCONNECT_USE_JUCE
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!dirty || juce::Time::currentTimeMillis() - lastSaveMs < saveIntervalMs) return;
+    }
+    flush();
+#endif
+}
+
+void AssetManifest::flush() {
+#if BEATCONNECT_USE_JUCE
+    std::lock_guard<std::mutex> writing(saveMutex);
+
+    std::string path;
+    std::vector<AssetManifestEntry> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!dirty || manifestPath.empty()) return;
+
+        path = manifestPath;
+        snapshot.reserve(entries.size());
+        for (const auto& pair : entries) {
+            snapshot.push_back(pair.second);
+        }
+        dirty = false;
+        lastSaveMs = juce::Time::currentTimeMillis();
+    }
+
+    if (!write(path, snapshot)) {
+        // Try again with the next change or flush
+        std::lock_guard<std::mutex> lock(mutex);
+        if (manifestPath == path) dirty = true;
+    }
+#endif
+}
+
+bool AssetManifest::write(const std::string& path, const std::vector<AssetManifestEntry>& snapshot) {
+#if BEATCONNECT_USE_JUCE
+    juce::Array<juce::var> assets;
+    assets.ensureStorageAllocated((int)snapshot.size());
+    for (const auto& entry : snapshot) {
+        juce::DynamicObject::Ptr item = new juce::DynamicObject();
+        item->setProperty("asset_id", juce::String(entry.assetId));
+        item->setProperty("path", juce::String(entry.path));
+        item->setProperty("size", (juce::int64)entry.size);
+        item->setProperty("checksum", juce::String(entry.checksum));
+        item->setProperty("etag", juce::String(entry.etag));
+        item->setProperty("modified_time", (juce::int64)entry.modifiedTime);
+        assets.add(juce::var(item.get()));
+    }
+
+    juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+    obj->setProperty("version", 1);
+    obj->setProperty("assets", assets);
+
+    // Write beside the manifest and swap, so a crash never leaves half a file
+    juce::TemporaryFile temp { juce::File(path) };
+    return temp.getFile().replaceWithText(juce::JSON::toString(juce::var(obj.get())))
+        && temp.overwriteTargetFileWithTemporary();
+#else
+    (void)path; (void)snapshot;
+    return false;
+#endif
+}
+
+} // namespace beatconnect
@@ -0,0 +1,89 @@
+#pragma once
+
+/**
+ * Asset Manifest
+ *
+ * Internal on-disk index of downloaded assets, stored as JSON in the download
+ * directory. AssetDownloader loads it once when configured; after that,
+ * "is it downloaded", "where is it" and "how much is on disk" are answered
+ * from memory instead of touching the filesystem.
+ *
+ * Changes are written at most once per saveIntervalMs (and by flush() and
+ * the destructor), from a snapshot taken under the lock, so a batch of
+ * thousands of assets doesn't re-serialize the whole index once per file.
+ */
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace beatconnect {
+
+struct AssetManifestEntry {
+    std::string assetId;
+    std::string path;           // Full local path
+    int64_t size = 0;           // Bytes on disk
+    std::string checksum;       // Server checksum the file was verified against
+    std::string etag;           // ETag of the response that produced the file
+    int64_t modifiedTime = 0;   // File mtime (ms since epoch) when recorded
+};
+
+class AssetManifest {
+public:
+    AssetManifest() = default;
+    ~AssetManifest();
+
+    AssetManifest(const AssetManifest&) = delete;
+    AssetManifest& operator=(const AssetManifest&) = delete;
+
+    /**
+     * Load the manifest at manifestPath, replacing anything in memory.
+     * Entries whose file is gone, or whose size / mtime no longer match,
+     * are dropped (one stat per entry, no hashing). Unsaved changes to the
+     * previous manifest are written first.
+     */
+    void load(const std::string& manifestPath);
+
+    std::optional<AssetManifestEntry> find(const std::string& assetId) const;
+
+    /** Add or replace an entry. Written once saveIntervalMs has passed. */
+    void put(const AssetManifestEntry& entry);
+
+    /** Remove an entry, written as for put. Returns false if absent. */
+    bool remove(const std::string& assetId);
+
+    /** Write the manifest now if anything changed since the last save. */
+    void flush();
+
+    /** Sum of all entry sizes, kept up to date on put/remove. */
+    int64_t getTotalSize() const;
+
+    /** Build an entry for a file that already exists on disk. */
+    static std::optional<AssetManifestEntry> describeFile(
+        const std::string& assetId,
+        const std::string& path,
+        const std::string& checksum,
+        const std::string& etag
+    );
+
+    static constexpr int64_t saveIntervalMs = 1000;
+
+private:
+    void flushIfDue();
+    static bool write(const std::string& path, const std::vector<AssetManifestEntry>& snapshot);
+
+    mutable std::mutex mutex;
+    std::string manifestPath;
+    std::unordered_map<std::string, AssetManifestEntry> entries;
+    int64_t totalSize = 0;
+    bool dirty = false;
+    int64_t lastSaveMs = 0;
+
+    // Held across a whole flush, so snapshots reach the disk in order
+    std::mutex saveMutex;
+};
+
+} // namespace beatconnect
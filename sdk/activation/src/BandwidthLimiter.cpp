@@ -0,0 +1,115 @@
+/**
+ * Bandwidth Limiter - Implementation
+ */
+
+#include "BandwidthLimiter.h"
+
+#include <algorithm>
+
+#if _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#elif __APPLE__
+    #include <sys/resource.h>
+#elif __linux__
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace beatconnect {
+
+namespace {
+
+// Pause sources are plain atomics flipped from the audio thread without a
+// notify, so waiters poll at this interval
+constexpr std::chrono::milliseconds pollInterval{100};
+
+} // namespace
+
+void BandwidthLimiter::setRate(int64_t bytesPerSecond) {
+    std::lock_guard<std::mutex> lock(mutex);
+    refill(std::chrono::steady_clock::now());
+    rate = std::max<int64_t>(0, bytesPerSecond);
+    tokens = std::min(tokens, (double)rate);
+    changed.notify_all();
+}
+
+void BandwidthLimiter::addPauseSource(PauseSource source) {
+    std::lock_guard<std::mutex> lock(mutex);
+    pauseSources.push_back(std::move(source));
+}
+
+void BandwidthLimiter::removePauseSource(const PauseSource& source) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = std::find(pauseSources.begin(), pauseSources.end(), source);
+    if (it != pauseSources.end()) pauseSources.erase(it);
+    changed.notify_all();
+}
+
+bool BandwidthLimiter::consume(int64_t bytes, const std::function<bool()>& cancelled) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        refill(std::chrono::steady_clock::now());
+        if (rate > 0) tokens -= (double)bytes;
+    }
+
+    while (true) {
+        std::chrono::milliseconds wait = pollInterval;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            refill(std::chrono::steady_clock::now());
+
+            const bool inDebt = rate > 0 && tokens < 0.0;
+            const bool paused = isPaused();
+            if (!inDebt && !paused) return true;
+
+            if (inDebt && !paused) {
+                auto untilCredit = std::chrono::milliseconds((int64_t)(-tokens * 1000.0 / rate) + 1);
+                wait = std::min(wait, untilCredit);
+            }
+        }
+
+        // Checked without our lock held; the callback takes the downloader's
+        if (cancelled && cancelled()) return false;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait_for(lock, wait);
+    }
+}
+
+bool BandwidthLimiter::isPaused() const {
+    return std::any_of(pauseSources.begin(), pauseSources.end(),
+        [](const PauseSource& source) { return source->load(std::memory_order_relaxed); });
+}
+
+void BandwidthLimiter::refill(std::chrono::steady_clock::time_point now) {
+    if (rate > 0) {
+        std::chrono::duration<double> elapsed = now - lastRefill;
+        // At most one second of burst
+        tokens = std::min(tokens + elapsed.count() * (double)rate, (double)rate);
+    } else {
+        tokens = 0.0;
+    }
+    lastRefill = now;
+}
+
+void lowerCurrentThreadPriority() {
+#if _WIN32
+    // Lowers CPU, I/O and memory priority together
+    SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#elif __APPLE__
+    // Darwin background band: low CPU priority plus throttled disk and network I/O
+    setpriority(PRIO_DARWIN_THREAD, 0, PRIO_DARWIN_BG);
+#elif __linux__
+    // Nice value and I/O priority are per thread here. Lowest best-effort
+    // I/O rather than the idle class, which can starve under constant
+    // disk streaming.
+    auto tid = (id_t)syscall(SYS_gettid);
+    setpriority(PRIO_PROCESS, tid, 10);
+    constexpr int ioprioWhoProcess = 1, ioprioClassBestEffort = 2, ioprioClassShift = 13;
+    syscall(SYS_ioprio_set, ioprioWhoProcess, (int)tid, (ioprioClassBestEffort << ioprioClassShift) | 7);
+#endif
+}
+
+} // namespace beatconnect
@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * Bandwidth Limiter
+ *
+ * Internal throttle shared by every transfer on a downloader (or on a
+ * coordinator in shared mode). A token bucket caps the combined read rate,
+ * and registered pause sources - typically "the host transport is running"
+ * flags set from the audio thread - hold all transfers until they clear.
+ *
+ * Transfers call consume() after each chunk they read, so a pause or an
+ * exhausted bucket blocks between reads rather than mid-write. A long pause
+ * may let the server drop the connection; the downloader's retry/resume
+ * logic picks the transfer back up afterwards.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace beatconnect {
+
+class BandwidthLimiter {
+public:
+    using PauseSource = std::shared_ptr<const std::atomic<bool>>;
+
+    /** Combined cap in bytes per second, 0 = unlimited. */
+    void setRate(int64_t bytesPerSecond);
+
+    /** Transfers wait while any registered source is true. */
+    void addPauseSource(PauseSource source);
+    void removePauseSource(const PauseSource& source);
+
+    /**
+     * Charge bytes just read, then wait until the bucket is back in credit
+     * and nothing is pausing. Returns false early if cancelled() turns true.
+     */
+    bool consume(int64_t bytes, const std::function<bool()>& cancelled);
+
+private:
+    bool isPaused() const;  // Caller holds mutex
+    void refill(std::chrono::steady_clock::time_point now);
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    int64_t rate = 0;
+    double tokens = 0.0;
+    std::chrono::steady_clock::time_point lastRefill = std::chrono::steady_clock::now();
+    std::vector<PauseSource> pauseSources;
+};
+
+/**
+ * Lower the calling thread to background CPU and I/O priority, for threads
+ * the downloader owns. Not reversible on every platform, so never called on
+ * a caller's thread.
+ */
+void lowerCurrentThreadPriority();
+
+} // namespace beatconnect
@@ -0,0 +1,213 @@
+/**
+ * Incremental SHA-256 / MD5 - Implementation
+ *
+ * Straightforward FIPS 180-4 (SHA-256) and RFC 1321 (MD5) block functions.
+ */
+
+#include "Digest.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace beatconnect {
+
+namespace {
+
+constexpr std::array<uint32_t, 64> sha256K = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+constexpr std::array<uint32_t, 64> md5K = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+constexpr std::array<uint32_t, 64> md5Shift = {
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+};
+
+inline uint32_t rotr(uint32_t x, uint32_t n) { return (x >> n) | (x << (32 - n)); }
+inline uint32_t rotl(uint32_t x, uint32_t n) { return (x << n) | (x >> (32 - n)); }
+
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return (char)std::tolower(c); });
+    return s;
+}
+
+// Strips an optional "sha256:" / "md5:" prefix
+std::string checksumHex(const std::string& checksum) {
+    auto colon = checksum.find(':');
+    return toLower(colon == std::string::npos ? checksum : checksum.substr(colon + 1));
+}
+
+} // namespace
+
+Digest::Digest(Algorithm a) : algorithm(a) {
+    if (algorithm == Algorithm::SHA256) {
+        state = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                  0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+    } else {
+        state = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0, 0, 0, 0 };
+    }
+}
+
+void Digest::update(const void* data, size_t size) {
+    auto* bytes = static_cast<const uint8_t*>(data);
+    totalBytes += size;
+
+    if (bufferSize > 0) {
+        auto take = std::min(size, buffer.size() - bufferSize);
+        std::memcpy(buffer.data() + bufferSize, bytes, take);
+        bufferSize += take;
+        bytes += take;
+        size -= take;
+
+        if (bufferSize < buffer.size()) return;
+        processBlock(buffer.data());
+        bufferSize = 0;
+    }
+
+    for (; size >= 64; bytes += 64, size -= 64) {
+        processBlock(bytes);
+    }
+
+    std::memcpy(buffer.data(), bytes, size);
+    bufferSize = size;
+}
+
+std::string Digest::finishHex() {
+    const uint64_t bitLength = totalBytes * 8;
+
+    // Padding: 0x80, zeros, then the 64-bit message length
+    uint8_t padding[72] = { 0x80 };
+    size_t padLength = (bufferSize < 56 ? 56 : 120) - bufferSize;
+
+    for (int i = 0; i < 8; ++i) {
+        padding[padLength + i] = algorithm == Algorithm::SHA256
+            ? (uint8_t)(bitLength >> (56 - 8 * i))    // Big-endian
+            : (uint8_t)(bitLength >> (8 * i));        // Little-endian
+    }
+    update(padding, padLength + 8);
+
+    static const char* hexDigits = "0123456789abcdef";
+    std::string hex;
+
+    const int words = algorithm == Algorithm::SHA256 ? 8 : 4;
+    for (int w = 0; w < words; ++w) {
+        for (int b = 0; b < 4; ++b) {
+            auto shift = algorithm == Algorithm::SHA256 ? 24 - 8 * b : 8 * b;
+            auto byte = (uint8_t)(state[w] >> shift);
+            hex += hexDigits[byte >> 4];
+            hex += hexDigits[byte & 0x0f];
+        }
+    }
+    return hex;
+}
+
+std::optional<Digest::Algorithm> Digest::algorithmForChecksum(const std::string& checksum) {
+    auto lower = toLower(checksum);
+    if (lower.rfind("sha256:", 0) == 0 || lower.rfind("sha-256:", 0) == 0) return Algorithm::SHA256;
+    if (lower.rfind("md5:", 0) == 0) return Algorithm::MD5;
+
+    bool isHex = !lower.empty() && std::all_of(lower.begin(), lower.end(),
+                                               [](unsigned char c) { return std::isxdigit(c); });
+    if (isHex && lower.size() == 64) return Algorithm::SHA256;
+    if (isHex && lower.size() == 32) return Algorithm::MD5;
+    return std::nullopt;
+}
+
+bool Digest::matchesChecksum(const std::string& hexDigest, const std::string& checksum) {
+    return toLower(hexDigest) == checksumHex(checksum);
+}
+
+std::string Digest::normalizeChecksum(const std::string& checksum) {
+    return checksumHex(checksum);
+}
+
+std::string Digest::sha256Hex(const std::string& data) {
+    Digest digest(Algorithm::SHA256);
+    digest.update(data.data(), data.size());
+    return digest.finishHex();
+}
+
+void Digest::processBlock(const uint8_t* block) {
+    if (algorithm == Algorithm::SHA256) processSha256Block(block);
+    else processMd5Block(block);
+}
+
+void Digest::processSha256Block(const uint8_t* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (uint32_t)block[i * 4] << 24 | (uint32_t)block[i * 4 + 1] << 16
+             | (uint32_t)block[i * 4 + 2] << 8 | (uint32_t)block[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; ++i) {
+        auto s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        auto s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    auto a = state[0], b = state[1], c = state[2], d = state[3];
+    auto e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int i = 0; i < 64; ++i) {
+        auto s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        auto ch = (e & f) ^ (~e & g);
+        auto t1 = h + s1 + ch + sha256K[i] + w[i];
+        auto s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        auto maj = (a & b) ^ (a & c) ^ (b & c);
+        auto t2 = s0 + maj;
+
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+void Digest::processMd5Block(const uint8_t* block) {
+    uint32_t m[16];
+    for (int i = 0; i < 16; ++i) {
+        m[i] = (uint32_t)block[i * 4] | (uint32_t)block[i * 4 + 1] << 8
+             | (uint32_t)block[i * 4 + 2] << 16 | (uint32_t)block[i * 4 + 3] << 24;
+    }
+
+    auto a = state[0], b = state[1], c = state[2], d = state[3];
+
+    for (uint32_t i = 0; i < 64; ++i) {
+        uint32_t f, g;
+        if (i < 16)      { f = (b & c) | (~b & d); g = i; }
+        else if (i < 32) { f = (d & b) | (~d & c); g = (5 * i + 1) % 16; }
+        else if (i < 48) { f = b ^ c ^ d;          g = (3 * i + 5) % 16; }
+        else             { f = c ^ (b | ~d);       g = (7 * i) % 16; }
+
+        auto temp = d;
+        d = c;
+        c = b;
+        b = b + rotl(a + f + md5K[i] + m[g], md5Shift[i]);
+        a = temp;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+}
+
+} // namespace beatconnect
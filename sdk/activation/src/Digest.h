@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * Incremental SHA-256 / MD5
+ *
+ * Internal helper shared by MachineId (fingerprint hashing) and
+ * AssetDownloader (checksum verification while a download streams in).
+ * Portable C++ so every platform and build configuration hashes the same way.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace beatconnect {
+
+class Digest {
+public:
+    enum class Algorithm { SHA256, MD5 };
+
+    explicit Digest(Algorithm algorithm);
+
+    /** Feed the next chunk of data. */
+    void update(const void* data, size_t size);
+
+    /** Finish and return the lowercase hex digest. Call once. */
+    std::string finishHex();
+
+    Algorithm getAlgorithm() const { return algorithm; }
+
+    /**
+     * Pick the algorithm for a server checksum string: "sha256:<hex>",
+     * "md5:<hex>", or bare hex (64 chars = SHA-256, 32 chars = MD5).
+     * Returns nullopt for anything else.
+     */
+    static std::optional<Algorithm> algorithmForChecksum(const std::string& checksum);
+
+    /** Case-insensitive compare of a digest against a server checksum string. */
+    static bool matchesChecksum(const std::string& hexDigest, const std::string& checksum);
+
+    /** A server checksum string as lowercase hex, without its prefix. */
+    static std::string normalizeChecksum(const std::string& checksum);
+
+    /** One-shot SHA-256 of a string as lowercase hex. */
+    static std::string sha256Hex(const std::string& data);
+
+private:
+    void processBlock(const uint8_t* block);
+    void processSha256Block(const uint8_t* block);
+    void processMd5Block(const uint8_t* block);
+
+    Algorithm algorithm;
+    std::array<uint32_t, 8> state{};
+    std::array<uint8_t, 64> buffer{};
+    size_t bufferSize = 0;
+    uint64_t totalBytes = 0;
+};
+
+} // namespace beatconnect
@@ -0,0 +1,135 @@
+/**
+ * Download Coordinator - Implementation
+ */
+
+#include "DownloadCoordinator.h"
+#include "Digest.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace beatconnect {
+
+// ==============================================================================
+// TransferSlots
+// ==============================================================================
+
+void TransferSlots::setLimit(int newLimit) {
+    std::lock_guard<std::mutex> lock(mutex);
+    limit = std::max(1, newLimit);
+    available.notify_all();
+}
+
+void TransferSlots::acquire(DownloadPriority priority) {
+    std::unique_lock<std::mutex> lock(mutex);
+    const Ticket ticket{-static_cast<int>(priority), nextArrival++};
+    waiting.insert(ticket);
+
+    available.wait(lock, [&] { return inUse < limit && *waiting.begin() == ticket; });
+    waiting.erase(waiting.begin());
+    ++inUse;
+
+    // The next waiter in line may fit as well
+    available.notify_all();
+}
+
+void TransferSlots::release() {
+    std::lock_guard<std::mutex> lock(mutex);
+    --inUse;
+    available.notify_all();
+}
+
+// ==============================================================================
+// DownloadCoordinator
+// ==============================================================================
+
+std::shared_ptr<DownloadCoordinator> DownloadCoordinator::getShared(
+    const std::string& pluginId,
+    const std::string& downloadPath,
+    const std::string& manifestPath
+) {
+    static std::mutex registryMutex;
+    static std::unordered_map<std::string, std::weak_ptr<DownloadCoordinator>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto key = pluginId + '\n' + downloadPath;
+
+    if (auto existing = registry[key].lock()) {
+        return existing;
+    }
+
+    auto coordinator = std::make_shared<DownloadCoordinator>();
+    coordinator->manifest->load(manifestPath);
+    registry[key] = coordinator;
+    return coordinator;
+}
+
+DownloadCoordinator::Result DownloadCoordinator::runCoalesced(
+    const std::string& assetId,
+    ProgressCallback progressCallback,
+    const Transfer& transfer
+) {
+    std::shared_ptr<InFlight> entry;
+    std::shared_future<Result> running;
+    std::promise<Result> promise;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = inFlight.find(assetId);
+        if (it != inFlight.end()) {
+            if (progressCallback) {
+                it->second->listeners.push_back(progressCallback);
+            }
+            running = it->second->result;
+        } else {
+            entry = std::make_shared<InFlight>();
+            entry->result = promise.get_future().share();
+            if (progressCallback) {
+                entry->listeners.push_back(progressCallback);
+            }
+            inFlight[assetId] = entry;
+        }
+    }
+
+    // Someone else is fetching it; wait for their result
+    if (running.valid()) {
+        return running.get();
+    }
+
+    auto fanOut = [this, entry](const DownloadProgress& progress) {
+        std::vector<ProgressCallback> listeners;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            listeners = entry->listeners;
+        }
+        for (const auto& listener : listeners) {
+            listener(progress);
+        }
+    };
+
+    // Unregister before publishing, so late callers start a fresh transfer
+    // (and find the file already on disk) rather than join a finished one
+    auto unregister = [this, &assetId] {
+        std::lock_guard<std::mutex> lock(mutex);
+        inFlight.erase(assetId);
+    };
+
+    Result result;
+    try {
+        result = transfer(fanOut);
+    } catch (...) {
+        // Waiters get the same exception instead of blocking forever
+        unregister();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    unregister();
+    promise.set_value(result);
+    return result;
+}
+
+std::string DownloadCoordinator::fileLockName(const std::string& targetPath) {
+    return "beatconnect-dl-" + Digest::sha256Hex(targetPath).substr(0, 32);
+}
+
+} // namespace beatconnect
@@ -0,0 +1,116 @@
+#pragma once
+
+/**
+ * Download Coordinator
+ *
+ * Internal, process-wide state shared by AssetDownloader instances that opt
+ * in with DownloaderConfig::sharedService. One coordinator exists per
+ * pluginId + download directory; it owns the manifest and transfer slots for
+ * that directory and coalesces identical in-flight downloads, so eight
+ * plugin instances asking for the same asset cause one transfer.
+ */
+
+#include "beatconnect/AssetDownloader.h"
+#include "AssetManifest.h"
+#include "BandwidthLimiter.h"
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace beatconnect {
+
+// Counting semaphore that bounds how many transfers run at once, shared by
+// single, async and batch downloads (and by every downloader on a
+// coordinator in shared mode). Freed slots go to the highest-priority
+// waiter, first come first served within a priority.
+class TransferSlots {
+public:
+    void setLimit(int newLimit);
+    void acquire(DownloadPriority priority);
+    void release();
+
+private:
+    using Ticket = std::pair<int, uint64_t>;  // (-priority, arrival)
+
+    std::mutex mutex;
+    std::condition_variable available;
+    std::set<Ticket> waiting;
+    uint64_t nextArrival = 0;
+    int limit = 1;
+    int inUse = 0;
+};
+
+// Holds a slot for its lifetime. Keeps the slots alive too, in case the
+// downloader is reconfigured onto different slots mid-transfer.
+class ScopedTransferSlot {
+public:
+    ScopedTransferSlot(std::shared_ptr<TransferSlots> s, DownloadPriority priority)
+        : slots(std::move(s)) { slots->acquire(priority); }
+    ~ScopedTransferSlot() { slots->release(); }
+
+    ScopedTransferSlot(const ScopedTransferSlot&) = delete;
+    ScopedTransferSlot& operator=(const ScopedTransferSlot&) = delete;
+
+private:
+    std::shared_ptr<TransferSlots> slots;
+};
+
+class DownloadCoordinator {
+public:
+    using Result = std::pair<DownloadStatus, std::string>;
+    using ProgressCallback = AssetDownloader::ProgressCallback;
+    using Transfer = std::function<Result(ProgressCallback)>;
+
+    /**
+     * Coordinator for a plugin's download directory, created (and its
+     * manifest loaded) on first use. Kept alive by the downloaders using it.
+     */
+    static std::shared_ptr<DownloadCoordinator> getShared(
+        const std::string& pluginId,
+        const std::string& downloadPath,
+        const std::string& manifestPath
+    );
+
+    /**
+     * Run transfer for assetId, or join the one already running. Every
+     * caller gets the same result (or exception, if the transfer throws);
+     * progress is forwarded to all of them.
+     */
+    Result runCoalesced(
+        const std::string& assetId,
+        ProgressCallback progressCallback,
+        const Transfer& transfer
+    );
+
+    /**
+     * Name for a juce::InterProcessLock guarding one target file, so host
+     * processes sharing a download directory take turns on it.
+     */
+    static std::string fileLockName(const std::string& targetPath);
+
+    const std::shared_ptr<AssetManifest>& getManifest() const { return manifest; }
+    const std::shared_ptr<TransferSlots>& getTransferSlots() const { return transferSlots; }
+    const std::shared_ptr<BandwidthLimiter>& getBandwidthLimiter() const { return bandwidth; }
+
+private:
+    struct InFlight {
+        std::shared_future<Result> result;
+        std::vector<ProgressCallback> listeners;
+    };
+
+    std::shared_ptr<AssetManifest> manifest = std::make_shared<AssetManifest>();
+    std::shared_ptr<TransferSlots> transferSlots = std::make_shared<TransferSlots>();
+    std::shared_ptr<BandwidthLimiter> bandwidth = std::make_shared<BandwidthLimiter>();
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<InFlight>> inFlight;
+};
+
+} // namespace beatconnect
@@ -0,0 +1,184 @@
+/**
+ * HTTP Client - Implementation
+ */
+
+#include "HttpClient.h"
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+
+namespace beatconnect {
+
+namespace {
+
+// Bounds concurrent send() calls to one host, so a burst queues for one of
+// a few connections instead of opening (and handshaking) them all at once
+class HostGate {
+public:
+    static std::shared_ptr<HostGate> forHost(const std::string& host) {
+        static std::mutex registryMutex;
+        static std::unordered_map<std::string, std::shared_ptr<HostGate>> gates;
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto& gate = gates[host];
+        if (!gate) gate = std::make_shared<HostGate>();
+        return gate;
+    }
+
+    void acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        available.wait(lock, [this] { return inUse < HttpClient::maxConnectionsPerHost; });
+        ++inUse;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --inUse;
+        }
+        available.notify_one();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable available;
+    int inUse = 0;
+};
+
+class ScopedHostGate {
+public:
+    explicit ScopedHostGate(std::shared_ptr<HostGate> g) : gate(std::move(g)) { gate->acquire(); }
+    ~ScopedHostGate() { gate->release(); }
+
+    ScopedHostGate(const ScopedHostGate&) = delete;
+    ScopedHostGate& operator=(const ScopedHostGate&) = delete;
+
+private:
+    std::shared_ptr<HostGate> gate;
+};
+
+bool equalsIgnoreCase(const std::string& a, const std::string& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+        [](unsigned char x, unsigned char y) { return std::tolower(x) == std::tolower(y); });
+}
+
+} // namespace
+
+// ==============================================================================
+// Request / Response
+// ==============================================================================
+
+HttpRequest HttpRequest::get(std::string url) {
+    HttpRequest request;
+    request.url = std::move(url);
+    return request;
+}
+
+HttpRequest HttpRequest::post(std::string url, std::string jsonBody) {
+    HttpRequest request;
+    request.method = "POST";
+    request.url = std::move(url);
+    request.body = std::move(jsonBody);
+    return request;
+}
+
+std::string HttpResponse::header(const std::string& name) const {
+    for (const auto& h : headers) {
+        if (equalsIgnoreCase(h.first, name)) return h.second;
+    }
+    return "";
+}
+
+#if BEATCONNECT_USE_JUCE
+juce::var HttpResponse::json() const {
+    if (body.empty()) return {};
+    return juce::JSON::parse(juce::String::fromUTF8(body.data(), static_cast<int>(body.size())));
+}
+#endif
+
+// ==============================================================================
+// Client
+// ==============================================================================
+
+HttpClient::HttpClient(std::string base, int timeout)
+    : baseUrl(std::move(base)), timeoutMs(timeout) {}
+
+void HttpClient::setDefaultHeader(const std::string& name, const std::string& value) {
+    defaultHeaders += name + ": " + value + "\r\n";
+}
+
+HttpResponse HttpClient::send(const HttpRequest& request) const {
+    HttpResponse response;
+#if BEATCONNECT_USE_JUCE
+    auto host = juce::URL(juce::String(request.url.find("://") != std::string::npos ? request.url : baseUrl))
+        .getDomain().toStdString();
+    ScopedHostGate hold(HostGate::forHost(host));
+
+    auto stream = connect(request, response);
+    if (!stream) return response;
+
+    // Read to the end and drop the stream before releasing the gate, so
+    // the backend can close or keep the connection before the next call
+    juce::MemoryBlock block;
+    stream->readIntoMemoryBlock(block);
+    response.body.assign(static_cast<const char*>(block.getData()), block.getSize());
+#else
+    (void)request;
+#endif
+    return response;
+}
+
+#if BEATCONNECT_USE_JUCE
+std::unique_ptr<juce::InputStream> HttpClient::openStream(const HttpRequest& request, HttpResponse& head) const {
+    return connect(request, head);
+}
+
+std::unique_ptr<juce::WebInputStream> HttpClient::connect(const HttpRequest& request, HttpResponse& head) const {
+    head = HttpResponse{};
+
+    juce::String address(request.url.find("://") != std::string::npos ? request.url : baseUrl + request.url);
+    for (size_t i = 0; i < request.query.size(); ++i) {
+        address << (i == 0 && !address.contains("?") ? "?" : "&")
+                << juce::URL::addEscapeChars(request.query[i].first, true)
+                << "=" << juce::URL::addEscapeChars(request.query[i].second, true);
+    }
+
+    juce::URL url(address);
+    const bool usePost = request.method != "GET" || !request.body.empty();
+    if (!request.body.empty()) {
+        url = url.withPOSTData(juce::MemoryBlock(request.body.data(), request.body.size()));
+    }
+
+    juce::String headers(defaultHeaders);
+    if (!request.body.empty()) {
+        headers << "Content-Type: "
+                << (request.contentType.empty() ? juce::String("application/json") : juce::String(request.contentType))
+                << "\r\n";
+    }
+    headers << request.headers;
+
+    auto stream = std::make_unique<juce::WebInputStream>(url, usePost);
+    stream->withExtraHeaders(headers)
+        .withConnectionTimeout(request.timeoutMs > 0 ? request.timeoutMs : timeoutMs)
+        .withNumRedirectsToFollow(request.maxRedirects);
+    if (request.method != "GET" && request.method != "POST") {
+        stream->withCustomRequestCommand(request.method);
+    }
+
+    if (!stream->connect(nullptr)) return nullptr;
+
+    head.statusCode = stream->getStatusCode();
+    auto responseHeaders = stream->getResponseHeaders();
+    auto keys = responseHeaders.getAllKeys();
+    auto values = responseHeaders.getAllValues();
+    for (int i = 0; i < keys.size(); ++i) {
+        head.headers.emplace_back(keys[i].toStdString(), values[i].toStdString());
+    }
+    return stream;
+}
+#endif
+
+} // namespace beatconnect
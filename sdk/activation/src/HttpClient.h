@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * HTTP Client
+ *
+ * Internal request/response layer used by Activation and AssetDownloader for
+ * every network call, on top of juce::WebInputStream.
+ *
+ * A client is built once per configuration: base URL, timeout and the auth
+ * headers are formatted at that point instead of on every request.
+ *
+ * There is no connection pooling here: every call opens its own
+ * juce::WebInputStream, since JUCE doesn't expose a connection to hand from
+ * one stream to the next. Whether the platform backend keeps the socket
+ * alive behind the scenes (WinINet and NSURLSession may; JUCE's Linux
+ * socket backend never does) is up to it. What send() does bound is
+ * concurrency: API calls are capped per host, process-wide, so a burst of a
+ * few hundred presign requests runs a few at a time instead of opening a few
+ * hundred connections (and TLS handshakes) at once.
+ *
+ * The cap never holds up file transfers. openStream(), which every download
+ * and each byte range of a segmented download goes through, isn't gated;
+ * those are bounded by the downloader's transfer slots and segmentsPerFile
+ * instead. The API calls a transfer depends on (info, presign) each hold a
+ * gate slot only for their own round trip, never while waiting on another
+ * call, so a full gate means queueing, not a stall.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if BEATCONNECT_USE_JUCE
+    #include <juce_core/juce_core.h>
+#endif
+
+namespace beatconnect {
+
+struct HttpRequest {
+    std::string method = "GET";
+    std::string url;            // Relative to the client's base URL, or absolute
+    std::vector<std::pair<std::string, std::string>> query;
+    std::string body;           // Sent as-is; non-empty makes a GET a POST
+    std::string contentType;    // Defaults to application/json when body is set
+    std::string headers;        // Extra "Name: value\r\n" lines for this call
+    int timeoutMs = 0;          // 0 = client default
+    int maxRedirects = 5;
+
+    static HttpRequest get(std::string url);
+    static HttpRequest post(std::string url, std::string jsonBody);
+};
+
+struct HttpResponse {
+    int statusCode = 0;         // 0 = no response (connection failed)
+    std::string body;
+    std::vector<std::pair<std::string, std::string>> headers;
+
+    bool connected() const { return statusCode != 0; }
+    bool ok() const { return statusCode >= 200 && statusCode < 300; }
+
+    /** Response header value, matched case-insensitively ("" if absent). */
+    std::string header(const std::string& name) const;
+
+#if BEATCONNECT_USE_JUCE
+    /** Body parsed as JSON (void if empty or not JSON). */
+    juce::var json() const;
+#endif
+};
+
+class HttpClient {
+public:
+    /** Simultaneous send() calls allowed per host, across the process. */
+    static constexpr int maxConnectionsPerHost = 4;
+
+    HttpClient() = default;
+    HttpClient(std::string baseUrl, int timeoutMs);
+
+    /** Send with every request, e.g. Authorization. Formatted once, here. */
+    void setDefaultHeader(const std::string& name, const std::string& value);
+
+    /**
+     * Perform the request and read the whole response body. Never throws;
+     * a failed connection comes back with statusCode 0.
+     */
+    HttpResponse send(const HttpRequest& request) const;
+
+#if BEATCONNECT_USE_JUCE
+    /**
+     * Start the request and hand back the body as a stream, for downloads.
+     * head receives the status code and headers; the stream is null if the
+     * connection failed. Not subject to the per-host cap (transfers are
+     * bounded by the downloader's own slots).
+     */
+    std::unique_ptr<juce::InputStream> openStream(const HttpRequest& request, HttpResponse& head) const;
+#endif
+
+    const std::string& getBaseUrl() const { return baseUrl; }
+
+private:
+#if BEATCONNECT_USE_JUCE
+    std::unique_ptr<juce::WebInputStream> connect(const HttpRequest& request, HttpResponse& head) const;
+#endif
+
+    std::string baseUrl;
+    int timeoutMs = 30000;
+    std::string defaultHeaders;  // Preformatted "Name: value\r\n" lines
+};
+
+} // namespace beatconnect
@@ -0,0 +1,286 @@
+/**
+ * Log Writer - Implementation
+ */
+
+#include "LogWriter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#if BEATCONNECT_USE_JUCE
+    #include <juce_core/juce_core.h>
+#endif
+
+namespace beatconnect {
+
+namespace {
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::error:   return "error";
+        case LogLevel::warning: return "warn";
+        case LogLevel::info:    return "info";
+        case LogLevel::debug:   return "debug";
+    }
+    return "";
+}
+
+std::string formatLine(int64_t timeMs, LogLevel level, const std::string& message) {
+#if BEATCONNECT_USE_JUCE
+    auto timestamp = juce::Time(timeMs).toString(false, true, true, true).toStdString();
+#else
+    auto timestamp = std::to_string(timeMs);
+#endif
+    return "[" + timestamp + "] [" + levelName(level) + "] " + message + "\n";
+}
+
+} // namespace
+
+// ==============================================================================
+// Sink
+// ==============================================================================
+
+// Only ever touched by the writer thread, apart from construction
+class LogWriter::Sink {
+public:
+    Sink(std::string filePath, int64_t maxBytes, int keep)
+        : path(std::move(filePath)), maxFileBytes(maxBytes), keepFiles(std::max(0, keep)) {}
+
+    void append(const std::string& line) {
+        if (!opened) {
+            opened = true;
+            rotate();  // Keep the previous session's log, start a fresh one
+            reopen();
+        }
+        if (!isOpen()) return;
+
+        const auto length = static_cast<int64_t>(line.size());
+        if (size > 0 && size + length > maxFileBytes) {
+            rotate();
+            reopen();
+            if (!isOpen()) return;
+        }
+
+#if BEATCONNECT_USE_JUCE
+        out->write(line.data(), line.size());
+#else
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+#endif
+        size += length;
+    }
+
+    void flush() {
+        if (!isOpen()) return;
+#if BEATCONNECT_USE_JUCE
+        out->flush();
+#else
+        out.flush();
+#endif
+    }
+
+private:
+    std::string rotatedPath(int index) const {
+        return index == 0 ? path : path + "." + std::to_string(index);
+    }
+
+    bool isOpen() const {
+#if BEATCONNECT_USE_JUCE
+        return out != nullptr;
+#else
+        return out.is_open();
+#endif
+    }
+
+    // debug.log -> debug.log.1 -> ... -> debug.log.<keepFiles>, oldest dropped
+    void rotate() {
+#if BEATCONNECT_USE_JUCE
+        out.reset();
+
+        juce::File current(path);
+        if (!current.existsAsFile() || current.getSize() == 0) return;
+
+        juce::File(rotatedPath(keepFiles)).deleteFile();
+        for (int i = keepFiles; i > 0; --i) {
+            juce::File from(rotatedPath(i - 1));
+            if (from.existsAsFile()) from.moveFileTo(juce::File(rotatedPath(i)));
+        }
+#else
+        out.close();
+
+        std::remove(rotatedPath(keepFiles).c_str());
+        for (int i = keepFiles; i > 0; --i) {
+            std::rename(rotatedPath(i - 1).c_str(), rotatedPath(i).c_str());
+        }
+#endif
+    }
+
+    void reopen() {
+        size = 0;
+#if BEATCONNECT_USE_JUCE
+        juce::File file(path);
+        file.getParentDirectory().createDirectory();
+
+        auto stream = std::make_unique<juce::FileOutputStream>(file);
+        if (stream->openedOk()) {
+            size = stream->getPosition();
+            out = std::move(stream);
+        }
+#else
+        out.open(path, std::ios::app | std::ios::binary);
+        if (out.is_open()) size = static_cast<int64_t>(out.tellp());
+#endif
+    }
+
+    const std::string path;
+    const int64_t maxFileBytes;
+    const int keepFiles;
+
+    bool opened = false;
+    int64_t size = 0;
+#if BEATCONNECT_USE_JUCE
+    std::unique_ptr<juce::FileOutputStream> out;
+#else
+    std::ofstream out;
+#endif
+};
+
+// ==============================================================================
+// Writer
+// ==============================================================================
+
+std::shared_ptr<LogWriter> LogWriter::acquire() {
+    static std::mutex registryMutex;
+    static std::weak_ptr<LogWriter> shared;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (auto existing = shared.lock()) {
+        return existing;
+    }
+
+    auto writer = std::make_shared<LogWriter>();
+    shared = writer;
+    return writer;
+}
+
+LogWriter::LogWriter() : thread(&LogWriter::run, this) {}
+
+LogWriter::~LogWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    thread.join();
+}
+
+std::shared_ptr<LogWriter::Sink> LogWriter::open(const std::string& path, int64_t maxFileBytes, int keepFiles) {
+    std::lock_guard<std::mutex> lock(sinksMutex);
+    if (auto existing = sinks[path].lock()) {
+        return existing;
+    }
+
+    auto sink = std::make_shared<Sink>(path, maxFileBytes, keepFiles);
+    sinks[path] = sink;
+    return sink;
+}
+
+void LogWriter::write(const std::shared_ptr<Sink>& sink, LogLevel level, std::string message) {
+    if (sink == nullptr) return;
+
+    auto* node = new Node();
+    node->sink = sink;
+    node->timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    node->level = level;
+    node->message = std::move(message);
+
+    // node belongs to the writer as soon as it's pushed; only the local
+    // copy of the previous head is safe to look at afterwards
+    auto* previous = head.load(std::memory_order_relaxed);
+    do {
+        node->next = previous;
+    } while (!head.compare_exchange_weak(previous, node, std::memory_order_release, std::memory_order_relaxed));
+    queued.fetch_add(1, std::memory_order_relaxed);
+
+    // Only the first line into an empty queue needs to wake the writer; the
+    // rest ride along in the same batch. Passing through the mutex orders
+    // the notify after the writer's check, so the wake-up can't be missed.
+    if (previous == nullptr) {
+        { std::lock_guard<std::mutex> lock(mutex); }
+        wake.notify_one();
+    }
+}
+
+void LogWriter::flush() {
+    const auto target = queued.load(std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    written.wait(lock, [&] { return writtenCount >= target || stopping; });
+}
+
+LogWriter::Node* LogWriter::takeAll() {
+    auto* node = head.exchange(nullptr, std::memory_order_acquire);
+
+    // Newest first -> oldest first
+    Node* reversed = nullptr;
+    while (node != nullptr) {
+        auto* next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+    return reversed;
+}
+
+void LogWriter::writeBatch(Node* oldestFirst) {
+    std::vector<std::shared_ptr<Sink>> touched;
+    uint64_t count = 0;
+
+    auto* node = oldestFirst;
+    while (node != nullptr) {
+        node->sink->append(formatLine(node->timeMs, node->level, node->message));
+#if BEATCONNECT_USE_JUCE
+        DBG(juce::String("[BeatConnect] " + node->message));
+#endif
+        if (std::find(touched.begin(), touched.end(), node->sink) == touched.end()) {
+            touched.push_back(node->sink);
+        }
+
+        auto* next = node->next;
+        delete node;
+        node = next;
+        ++count;
+    }
+
+    // One flush per file per batch, not per line
+    for (auto& sink : touched) sink->flush();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        writtenCount += count;
+    }
+    written.notify_all();
+}
+
+void LogWriter::run() {
+    while (true) {
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] {
+                return stopping || head.load(std::memory_order_relaxed) != nullptr;
+            });
+            stop = stopping;
+        }
+
+        if (auto* batch = takeAll()) {
+            writeBatch(batch);
+        } else if (stop) {
+            return;  // Stopping and drained
+        }
+    }
+}
+
+} // namespace beatconnect
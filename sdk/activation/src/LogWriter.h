@@ -0,0 +1,121 @@
+#pragma once
+
+/**
+ * Log Writer
+ *
+ * Background writer behind Activation's debug log. Callers push messages
+ * onto a lock-free queue and return; one thread shared by every instance in
+ * the process drains it, formats timestamps, writes each batch to files it
+ * keeps open and flushes once per batch. Files are rotated by size
+ * (debug.log -> debug.log.1 -> ...), and a fresh file is started the first
+ * time a path is opened in the process.
+ *
+ * Messages above BEATCONNECT_LOG_LEVEL compile away entirely at call sites
+ * that check isCompiledIn() (see BEATCONNECT_ACTIVATION_LOG in
+ * Activation.cpp), so field builds can keep logging enabled for errors and
+ * warnings without paying for request/response dumps.
+ *
+ * Like TaskExecutor, the writer lives as long as someone holds it; the last
+ * holder drains the queue and joins the thread from ordinary code.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// 0 = off, 1 = errors, 2 = + warnings, 3 = + info, 4 = + debug (request and
+// response bodies). Defaults to everything in debug builds, info in release.
+#ifndef BEATCONNECT_LOG_LEVEL
+    #if defined(NDEBUG) && !defined(JUCE_DEBUG)
+        #define BEATCONNECT_LOG_LEVEL 3
+    #else
+        #define BEATCONNECT_LOG_LEVEL 4
+    #endif
+#endif
+
+namespace beatconnect {
+
+enum class LogLevel : int {
+    error = 1,
+    warning = 2,
+    info = 3,
+    debug = 4
+};
+
+class LogWriter {
+public:
+    /** Rotate once a file would grow past this. */
+    static constexpr int64_t defaultMaxFileBytes = 1024 * 1024;
+
+    /** Rotated files kept beside the current one. */
+    static constexpr int defaultKeepFiles = 2;
+
+    static constexpr bool isCompiledIn(LogLevel level) {
+        return static_cast<int>(level) <= BEATCONNECT_LOG_LEVEL;
+    }
+
+    /** One open log file. Shared by everyone logging to the same path. */
+    class Sink;
+
+    /** Shared writer, started on first acquire. */
+    static std::shared_ptr<LogWriter> acquire();
+
+    LogWriter();
+
+    /** Writes everything still queued, then joins the writer thread. */
+    ~LogWriter();
+
+    LogWriter(const LogWriter&) = delete;
+    LogWriter& operator=(const LogWriter&) = delete;
+
+    /**
+     * Sink for path. The file itself is opened (and any previous one
+     * rotated) on the writer thread, on the first message.
+     */
+    std::shared_ptr<Sink> open(const std::string& path,
+                               int64_t maxFileBytes = defaultMaxFileBytes,
+                               int keepFiles = defaultKeepFiles);
+
+    /** Queue a line for sink. Lock-free; never touches the file. */
+    void write(const std::shared_ptr<Sink>& sink, LogLevel level, std::string message);
+
+    /** Block until everything queued before this call is on disk. */
+    void flush();
+
+private:
+    struct Node {
+        Node* next = nullptr;
+        std::shared_ptr<Sink> sink;
+        int64_t timeMs = 0;
+        LogLevel level = LogLevel::info;
+        std::string message;
+    };
+
+    void run();
+    Node* takeAll();
+    void writeBatch(Node* oldestFirst);
+
+    // Producers push onto the head; the writer takes the whole list at once
+    // and reverses it into arrival order
+    std::atomic<Node*> head{nullptr};
+    std::atomic<uint64_t> queued{0};
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable written;
+    uint64_t writtenCount = 0;
+    bool stopping = false;
+
+    std::mutex sinksMutex;
+    std::unordered_map<std::string, std::weak_ptr<Sink>> sinks;
+
+    std::thread thread;
+};
+
+} // namespace beatconnect
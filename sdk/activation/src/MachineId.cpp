@@ -6,15 +6,13 @@
  */
 
 #include "beatconnect/MachineId.h"
+#include "Digest.h"
 
-#include <sstream>
-#include <iomanip>
-#include <array>
+#include <mutex>
 
 #if _WIN32
     #define WIN32_LEAN_AND_MEAN
     #include <windows.h>
-    #include <wincrypt.h>
     #pragma comment(lib, "advapi32.lib")
 #elif __APPLE__
     #include <IOKit/IOKitLib.h>
@@ -37,7 +35,7 @@
 namespace beatconnect {
 
 // ==============================================================================
-// SHA-256 Helper (using JUCE or system)
+// SHA-256 Helper (using JUCE or the portable Digest)
 // ==============================================================================
 
 #if BEATCONNECT_USE_JUCE
@@ -47,63 +45,11 @@ std::string MachineId::hashMachineInfo(const std::string& info) {
     return hash.toHexString().toStdString();
 }
 
-#elif _WIN32
-
-// Windows CryptoAPI SHA-256
-std::string MachineId::hashMachineInfo(const std::string& info) {
-    HCRYPTPROV hProv = 0;
-    HCRYPTHASH hHash = 0;
-    std::string result;
-
-    if (!CryptAcquireContext(&hProv, NULL, NULL, PROV_RSA_AES,
-                             CRYPT_VERIFYCONTEXT)) {
-        return "";
-    }
-
-    if (!CryptCreateHash(hProv, CALG_SHA_256, 0, 0, &hHash)) {
-        CryptReleaseContext(hProv, 0);
-        return "";
-    }
-
-    if (!CryptHashData(hHash, (BYTE*)info.c_str(), (DWORD)info.size(), 0)) {
-        CryptDestroyHash(hHash);
-        CryptReleaseContext(hProv, 0);
-        return "";
-    }
-
-    DWORD hashLen = 32;
-    std::array<BYTE, 32> hashData;
-
-    if (CryptGetHashParam(hHash, HP_HASHVAL, hashData.data(), &hashLen, 0)) {
-        std::stringstream ss;
-        for (auto byte : hashData) {
-            ss << std::hex << std::setfill('0') << std::setw(2) << (int)byte;
-        }
-        result = ss.str();
-    }
-
-    CryptDestroyHash(hHash);
-    CryptReleaseContext(hProv, 0);
-
-    return result;
-}
-
 #else
 
-// Fallback: Simple hash (not cryptographic - for build testing only)
+// Portable SHA-256 shared with the asset downloader's checksum verification
 std::string MachineId::hashMachineInfo(const std::string& info) {
-    // TODO: Implement proper SHA-256 for non-JUCE builds
-    unsigned long hash = 5381;
-    for (char c : info) {
-        hash = ((hash << 5) + hash) + c;
-    }
-
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0') << std::setw(16) << hash;
-    // Pad to 64 chars to match SHA-256 format
-    auto h = ss.str();
-    while (h.size() < 64) h += h;
-    return h.substr(0, 64);
+    return Digest::sha256Hex(info);
 }
 
 #endif
@@ -234,7 +180,27 @@ std::string MachineId::getLinuxMachineInfo() {
 // Public API
 // ==============================================================================
 
+namespace {
+    // Process-wide cache. The fingerprint can't change while we're running,
+    // so it's computed on first use and only dropped by invalidateCache().
+    std::mutex cacheMutex;
+    std::string cachedId;
+}
+
 std::string MachineId::generate() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (cachedId.empty()) {
+        cachedId = compute();
+    }
+    return cachedId;
+}
+
+void MachineId::invalidateCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cachedId.clear();
+}
+
+std::string MachineId::compute() {
     std::string machineInfo;
 
 #if _WIN32
@@ -0,0 +1,247 @@
+/**
+ * Pack Manifest - Implementation
+ */
+
+#include "PackManifest.h"
+#include "Digest.h"
+
+#include <unordered_set>
+
+#if BEATCONNECT_USE_JUCE
+    #include <juce_core/juce_core.h>
+#endif
+
+namespace beatconnect {
+
+bool PackManifest::isPackPath(const std::string& directory, const std::string& path) {
+#if BEATCONNECT_USE_JUCE
+    if (path.empty()) return false;
+
+    const juce::String relative(path);
+    if (juce::File::isAbsolutePath(relative)
+        || juce::StringArray::fromTokens(relative, "/\\", "").contains("..")) {
+        return false;
+    }
+
+    juce::File dir(directory);
+    return dir.getChildFile(relative).isAChildOf(dir);
+#else
+    (void)directory;
+    (void)path;
+    return false;
+#endif
+}
+
+void PackManifest::load(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    packDirectory = directory;
+    version.clear();
+    entries.clear();
+    dirty = false;
+
+#if BEATCONNECT_USE_JUCE
+    juce::File dir(packDirectory);
+    auto file = dir.getChildFile(fileName);
+    if (!file.existsAsFile()) return;
+
+    auto json = juce::JSON::parse(file.loadFileAsString());
+    version = json.getProperty("pack_version", "").toString().toStdString();
+
+    auto* files = json.getProperty("files", juce::var()).getArray();
+    if (!files) return;
+
+    for (const auto& item : *files) {
+        PackManifestEntry entry;
+        entry.file.path = item.getProperty("path", "").toString().toStdString();
+        entry.file.size = (juce::int64)item.getProperty("size", 0);
+        entry.file.checksum = item.getProperty("checksum", "").toString().toStdString();
+        entry.file.assetId = item.getProperty("asset_id", "").toString().toStdString();
+        entry.modifiedTime = (juce::int64)item.getProperty("modified_time", 0);
+
+        // A damaged or hand-edited manifest must not point sync at files
+        // outside the pack
+        if (!isPackPath(packDirectory, entry.file.path)) {
+            dirty = true;
+            continue;
+        }
+
+        // Deleted or replaced behind our back
+        auto packFile = dir.getChildFile(juce::String(entry.file.path));
+        if (!packFile.existsAsFile()
+            || packFile.getSize() != entry.file.size
+            || packFile.getLastModificationTime().toMilliseconds() != entry.modifiedTime) {
+            dirty = true;
+            continue;
+        }
+
+        entries[entry.file.path] = std::move(entry);
+    }
+#endif
+}
+
+std::string PackManifest::getVersion() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return version;
+}
+
+void PackManifest::setVersion(const std::string& newVersion) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (version == newVersion) return;
+    version = newVersion;
+    dirty = true;
+}
+
+std::optional<PackManifestEntry> PackManifest::find(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(path);
+    if (it == entries.end()) return std::nullopt;
+    return it->second;
+}
+
+std::vector<PackManifestEntry> PackManifest::getEntries() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<PackManifestEntry> result;
+    result.reserve(entries.size());
+    for (const auto& pair : entries) {
+        result.push_back(pair.second);
+    }
+    return result;
+}
+
+bool PackManifest::put(const PackFile& file) {
+#if BEATCONNECT_USE_JUCE
+    std::lock_guard<std::mutex> lock(mutex);
+    auto packFile = juce::File(packDirectory).getChildFile(juce::String(file.path));
+    if (!packFile.existsAsFile()) return false;
+
+    PackManifestEntry entry;
+    entry.file = file;
+    entry.file.size = packFile.getSize();
+    entry.modifiedTime = packFile.getLastModificationTime().toMilliseconds();
+    entries[file.path] = std::move(entry);
+    dirty = true;
+    return true;
+#else
+    (void)file;
+    return false;
+#endif
+}
+
+bool PackManifest::remove(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entries.erase(path) == 0) return false;
+    dirty = true;
+    return true;
+}
+
+void PackManifest::save() {
+#if BEATCONNECT_USE_JUCE
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!dirty || packDirectory.empty()) return;
+
+    juce::Array<juce::var> files;
+    files.ensureStorageAllocated((int)entries.size());
+    for (const auto& pair : entries) {
+        const auto& entry = pair.second;
+        juce::DynamicObject::Ptr item = new juce::DynamicObject();
+        item->setProperty("path", juce::String(entry.file.path));
+        item->setProperty("size", (juce::int64)entry.file.size);
+        item->setProperty("checksum", juce::String(entry.file.checksum));
+        item->setProperty("asset_id", juce::String(entry.file.assetId));
+        item->setProperty("modified_time", (juce::int64)entry.modifiedTime);
+        files.add(juce::var(item.get()));
+    }
+
+    juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+    obj->setProperty("version", 1);
+    obj->setProperty("pack_version", juce::String(version));
+    obj->setProperty("files", files);
+
+    juce::File dir(packDirectory);
+    dir.createDirectory();
+
+    // Write beside the manifest and swap, so a crash never leaves half a file
+    juce::TemporaryFile temp { dir.getChildFile(fileName) };
+    if (temp.getFile().replaceWithText(juce::JSON::toString(juce::var(obj.get())))
+        && temp.overwriteTargetFileWithTemporary()) {
+        dirty = false;
+    }
+#endif
+}
+
+// ==============================================================================
+// Diff
+// ==============================================================================
+
+namespace {
+
+// Same content as far as the manifests can tell. Without a checksum, the
+// size has to do.
+bool sameContent(const PackFile& a, const PackFile& b) {
+    if (a.size != b.size) return false;
+    if (a.checksum.empty() || b.checksum.empty()) return a.checksum.empty() && b.checksum.empty();
+    return Digest::normalizeChecksum(a.checksum) == Digest::normalizeChecksum(b.checksum);
+}
+
+} // namespace
+
+PackSyncPlan diffPack(const std::vector<PackFile>& remoteFiles, const PackManifest& local) {
+    PackSyncPlan plan;
+    plan.localVersion = local.getVersion();
+
+    // First listing of a path wins
+    std::unordered_map<std::string, const PackFile*> remoteByPath;
+    for (const auto& file : remoteFiles) {
+        remoteByPath.emplace(file.path, &file);
+    }
+
+    // Local files that won't stay where they are: gone from the pack, or
+    // about to be replaced. Their content can still move to a new path.
+    std::unordered_map<std::string, std::vector<PackFile>> leavingByChecksum;
+    std::vector<std::string> leavingPaths;
+    for (const auto& entry : local.getEntries()) {
+        auto it = remoteByPath.find(entry.file.path);
+        if (it != remoteByPath.end() && sameContent(entry.file, *it->second)) continue;
+
+        if (it == remoteByPath.end()) leavingPaths.push_back(entry.file.path);
+        if (!entry.file.checksum.empty()) {
+            leavingByChecksum[Digest::normalizeChecksum(entry.file.checksum)].push_back(entry.file);
+        }
+    }
+
+    std::unordered_set<std::string> movedFrom;
+    for (const auto& remote : remoteFiles) {
+        if (remoteByPath[remote.path] != &remote) continue;
+
+        if (auto entry = local.find(remote.path); entry && sameContent(entry->file, remote)) {
+            ++plan.unchanged;
+            continue;
+        }
+
+        bool moved = false;
+        if (!remote.checksum.empty()) {
+            auto it = leavingByChecksum.find(Digest::normalizeChecksum(remote.checksum));
+            if (it != leavingByChecksum.end()) {
+                for (const auto& candidate : it->second) {
+                    if (movedFrom.count(candidate.path) || !sameContent(candidate, remote)) continue;
+                    movedFrom.insert(candidate.path);
+                    plan.toMove.emplace_back(candidate.path, remote.path);
+                    moved = true;
+                    break;
+                }
+            }
+        }
+
+        if (!moved) {
+            plan.toDownload.push_back(remote);
+            plan.bytesToDownload += remote.size;
+        }
+    }
+
+    for (const auto& path : leavingPaths) {
+        if (!movedFrom.count(path)) plan.toDelete.push_back(path);
+    }
+    return plan;
+}
+
+} // namespace beatconnect
@@ -0,0 +1,82 @@
+#pragma once
+
+/**
+ * Pack Manifest
+ *
+ * Internal record of which files of an asset pack are on disk, and which
+ * content each of them holds, stored as JSON in the pack's directory.
+ * AssetDownloader diffs it against the pack's remote manifest, so an
+ * update only transfers the files that changed.
+ */
+
+#include "beatconnect/AssetDownloader.h"
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace beatconnect {
+
+struct PackManifestEntry {
+    PackFile file;
+    int64_t modifiedTime = 0;   // File mtime (ms since epoch) when recorded
+};
+
+class PackManifest {
+public:
+    static constexpr const char* fileName = ".beatconnect-pack.json";
+
+    /**
+     * True if path is relative and resolves to a file inside packDirectory.
+     * Sync overwrites and deletes the paths either manifest lists, so
+     * anything else is ignored wherever a manifest is read.
+     */
+    static bool isPackPath(const std::string& packDirectory, const std::string& path);
+
+    /**
+     * Load the manifest in packDirectory, replacing anything in memory.
+     * Entries outside the directory, whose file is gone, or whose size /
+     * mtime no longer match, are dropped (one stat per entry, no hashing).
+     */
+    void load(const std::string& packDirectory);
+
+    /** Version of the last sync that completed, empty if none. */
+    std::string getVersion() const;
+    void setVersion(const std::string& version);
+
+    std::optional<PackManifestEntry> find(const std::string& path) const;
+    std::vector<PackManifestEntry> getEntries() const;
+
+    /** Record a file that is now on disk at file.path. False if it isn't there. */
+    bool put(const PackFile& file);
+
+    /** Forget a path. Returns false if absent. */
+    bool remove(const std::string& path);
+
+    /**
+     * Write the manifest if anything changed since it was loaded or last
+     * saved. Changes are only kept in memory until then, so a sync of
+     * thousands of files doesn't rewrite the manifest once per file.
+     */
+    void save();
+
+private:
+    mutable std::mutex mutex;
+    std::string packDirectory;
+    std::string version;
+    std::unordered_map<std::string, PackManifestEntry> entries;
+    bool dirty = false;
+};
+
+/**
+ * Diff a pack's remote file list against the local manifest. A new or
+ * changed file whose content the manifest holds under a path that is being
+ * deleted or overwritten becomes a move instead of a download. Works from
+ * the manifest alone; files it doesn't list are never deleted.
+ */
+PackSyncPlan diffPack(const std::vector<PackFile>& remoteFiles, const PackManifest& local);
+
+} // namespace beatconnect
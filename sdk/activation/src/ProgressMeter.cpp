@@ -0,0 +1,119 @@
+/**
+ * Progress Meter - Implementation
+ */
+
+#include "ProgressMeter.h"
+
+#include <algorithm>
+
+namespace beatconnect {
+
+// ==============================================================================
+// ProgressMeter
+// ==============================================================================
+
+ProgressMeter::ProgressMeter(int intervalMs, float step)
+    : interval(std::max(0, intervalMs)), stepPercent(std::max(0.0f, step)) {}
+
+bool ProgressMeter::update(int64_t bytes, int64_t totalBytes, bool force) {
+    auto now = Clock::now();
+    latestTime = now;
+    latestBytes = bytes;
+    latestTotal = totalBytes;
+
+    if (count == 0 || now - samples[(oldest + count - 1) % maxSamples].time >= sampleInterval) {
+        addSample(now, bytes);
+    }
+
+    auto percent = getPercent();
+    bool due = force || !reported
+        || (interval.count() == 0 && stepPercent == 0.0f)
+        || (interval.count() > 0 && now - lastReportTime >= interval)
+        || (stepPercent > 0.0f && percent - lastReportPercent >= stepPercent);
+
+    if (due) {
+        reported = true;
+        lastReportTime = now;
+        lastReportPercent = percent;
+    }
+    return due;
+}
+
+float ProgressMeter::getSpeed() const {
+    if (count == 0) return 0.0f;
+
+    const auto& first = samples[oldest];
+    std::chrono::duration<double> elapsed = latestTime - first.time;
+    if (elapsed.count() <= 0.0) return 0.0f;
+    return (float)((double)(latestBytes - first.bytes) / elapsed.count());
+}
+
+float ProgressMeter::getEtaSeconds() const {
+    auto speed = getSpeed();
+    if (latestTotal <= 0 || speed <= 0.0f) return -1.0f;
+    return (float)std::max<int64_t>(0, latestTotal - latestBytes) / speed;
+}
+
+float ProgressMeter::getPercent() const {
+    if (latestTotal <= 0) return 0.0f;
+    return std::min(100.0f, (float)latestBytes / (float)latestTotal * 100.0f);
+}
+
+void ProgressMeter::addSample(Clock::time_point now, int64_t bytes) {
+    // Drop samples that have left the window, keeping at least one as the
+    // baseline
+    while (count > 1 && now - samples[(oldest + 1) % maxSamples].time >= window) {
+        oldest = (oldest + 1) % maxSamples;
+        --count;
+    }
+    if (count == maxSamples) {
+        oldest = (oldest + 1) % maxSamples;
+        --count;
+    }
+
+    samples[(oldest + count) % maxSamples] = {now, bytes};
+    ++count;
+}
+
+// ==============================================================================
+// ProgressSnapshotCell
+// ==============================================================================
+
+void ProgressSnapshotCell::publish(const DownloadProgressSnapshot& snapshot) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+
+    auto seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);  // Odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+
+    bytesDownloaded.store(snapshot.bytesDownloaded, std::memory_order_relaxed);
+    totalBytes.store(snapshot.totalBytes, std::memory_order_relaxed);
+    percent.store(snapshot.percent, std::memory_order_relaxed);
+    speedBytesPerSec.store(snapshot.speedBytesPerSec, std::memory_order_relaxed);
+    etaSeconds.store(snapshot.etaSeconds, std::memory_order_relaxed);
+    currentFile.store(snapshot.currentFile, std::memory_order_relaxed);
+    totalFiles.store(snapshot.totalFiles, std::memory_order_relaxed);
+
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+DownloadProgressSnapshot ProgressSnapshotCell::read() const {
+    DownloadProgressSnapshot snapshot;
+    while (true) {
+        auto before = sequence.load(std::memory_order_acquire);
+        if (before & 1u) continue;
+
+        snapshot.bytesDownloaded = bytesDownloaded.load(std::memory_order_relaxed);
+        snapshot.totalBytes = totalBytes.load(std::memory_order_relaxed);
+        snapshot.percent = percent.load(std::memory_order_relaxed);
+        snapshot.speedBytesPerSec = speedBytesPerSec.load(std::memory_order_relaxed);
+        snapshot.etaSeconds = etaSeconds.load(std::memory_order_relaxed);
+        snapshot.currentFile = currentFile.load(std::memory_order_relaxed);
+        snapshot.totalFiles = totalFiles.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) return snapshot;
+    }
+}
+
+} // namespace beatconnect
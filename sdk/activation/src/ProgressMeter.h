@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * Progress Meter
+ *
+ * Internal helpers that keep progress reporting cheap on fast links:
+ *
+ *  - ProgressMeter decides when a transfer (or batch) is due to report, at
+ *    most every DownloaderConfig::progressIntervalMs and/or every
+ *    progressStepPercent, and estimates speed and ETA over a moving window
+ *    rather than averaging since the transfer began. Fixed-size, so feeding
+ *    it every chunk allocates nothing.
+ *
+ *  - ProgressSnapshotCell holds the latest DownloadProgressSnapshot behind a
+ *    sequence lock, so a UI timer can poll it without locking or allocating.
+ */
+
+#include "beatconnect/AssetDownloader.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace beatconnect {
+
+class ProgressMeter {
+public:
+    /** intervalMs / stepPercent of 0 disable that trigger; both 0 = every update. */
+    ProgressMeter(int intervalMs, float stepPercent);
+
+    /**
+     * Record the bytes transferred so far. Returns true when a report is
+     * due: the first update, whenever an interval or step has passed, and
+     * always when force is set (e.g. the transfer finished).
+     */
+    bool update(int64_t bytes, int64_t totalBytes, bool force = false);
+
+    /** Bytes per second over the last few seconds. */
+    float getSpeed() const;
+
+    /** Seconds left at the current speed, or -1 if unknown. */
+    float getEtaSeconds() const;
+
+    /** Percent of the last update (0 if the total is unknown). */
+    float getPercent() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Sample {
+        Clock::time_point time;
+        int64_t bytes = 0;
+    };
+
+    static constexpr int maxSamples = 32;
+    static constexpr std::chrono::milliseconds sampleInterval{200};
+    static constexpr std::chrono::milliseconds window{5000};
+
+    void addSample(Clock::time_point now, int64_t bytes);
+
+    const std::chrono::milliseconds interval;
+    const float stepPercent;
+
+    std::array<Sample, maxSamples> samples{};
+    int oldest = 0;
+    int count = 0;
+
+    Clock::time_point latestTime;
+    int64_t latestBytes = 0;
+    int64_t latestTotal = 0;
+
+    bool reported = false;
+    Clock::time_point lastReportTime;
+    float lastReportPercent = 0.0f;
+};
+
+class ProgressSnapshotCell {
+public:
+    /** Writers may be on any thread; they're serialized among themselves. */
+    void publish(const DownloadProgressSnapshot& snapshot);
+
+    /** Lock-free; retries if it overlaps a publish. */
+    DownloadProgressSnapshot read() const;
+
+private:
+    std::mutex writeMutex;
+    std::atomic<uint32_t> sequence{0};
+
+    std::atomic<int64_t> bytesDownloaded{0};
+    std::atomic<int64_t> totalBytes{0};
+    std::atomic<float> percent{0.0f};
+    std::atomic<float> speedBytesPerSec{0.0f};
+    std::atomic<float> etaSeconds{-1.0f};
+    std::atomic<int> currentFile{0};
+    std::atomic<int> totalFiles{0};
+};
+
+} // namespace beatconnect
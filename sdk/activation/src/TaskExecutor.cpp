@@ -0,0 +1,127 @@
+/**
+ * Task Executor - Implementation
+ */
+
+#include "TaskExecutor.h"
+
+#include <algorithm>
+
+namespace beatconnect {
+
+std::shared_ptr<TaskExecutor> TaskExecutor::acquire() {
+    static std::mutex registryMutex;
+    static std::weak_ptr<TaskExecutor> shared;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (auto existing = shared.lock()) {
+        return existing;
+    }
+
+    // Activation work is a handful of short HTTP calls; two threads keep one
+    // slow request from holding up everything else
+    auto executor = std::make_shared<TaskExecutor>(2);
+    shared = executor;
+    return executor;
+}
+
+TaskExecutor::TaskExecutor(int numThreads) {
+    for (int i = 0; i < std::max(1, numThreads); ++i) {
+        workers.emplace_back(&TaskExecutor::run, state);
+    }
+}
+
+TaskExecutor::~TaskExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->stopping = true;
+    }
+    state->wake.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.get_id() == std::this_thread::get_id()) {
+            // Released from inside our own task; it exits once that returns
+            worker.detach();
+        } else {
+            worker.join();
+        }
+    }
+}
+
+void TaskExecutor::submit(const void* owner, Task task) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->queue.push_back({owner, std::move(task)});
+    state->wake.notify_one();
+}
+
+void TaskExecutor::submitAfter(const void* owner, int64_t delayMs, Task task) {
+    auto due = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max<int64_t>(0, delayMs));
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->delayed.emplace(due, Entry{owner, std::move(task)});
+    state->wake.notify_one();
+}
+
+void TaskExecutor::cancelAndWait(const void* owner) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+
+    auto& queue = state->queue;
+    queue.erase(std::remove_if(queue.begin(), queue.end(),
+        [owner](const Entry& e) { return e.owner == owner; }), queue.end());
+
+    for (auto it = state->delayed.begin(); it != state->delayed.end();) {
+        it = it->second.owner == owner ? state->delayed.erase(it) : std::next(it);
+    }
+
+    auto self = std::this_thread::get_id();
+    state->finished.wait(lock, [&] {
+        return std::none_of(state->running.begin(), state->running.end(),
+            [&](const auto& r) { return r.second == owner && r.first != self; });
+    });
+}
+
+void TaskExecutor::run(std::shared_ptr<State> state) {
+    auto self = std::this_thread::get_id();
+
+    while (true) {
+        Entry entry;
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            while (true) {
+                // Promote delayed tasks that have come due
+                auto now = std::chrono::steady_clock::now();
+                auto& delayed = state->delayed;
+                while (!delayed.empty() && delayed.begin()->first <= now) {
+                    state->queue.push_back(std::move(delayed.begin()->second));
+                    delayed.erase(delayed.begin());
+                }
+
+                if (!state->queue.empty() || state->stopping) break;
+
+                if (delayed.empty()) {
+                    state->wake.wait(lock);
+                } else {
+                    auto nextDue = delayed.begin()->first;  // Copy: the node may go while we wait
+                    state->wake.wait_until(lock, nextDue);
+                }
+            }
+            if (state->queue.empty()) return;  // Stopping and drained
+
+            entry = std::move(state->queue.front());
+            state->queue.pop_front();
+            state->running.emplace_back(self, entry.owner);
+        }
+
+        entry.task();
+        entry.task = nullptr;  // Release captures before reporting done
+
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            auto& running = state->running;
+            running.erase(std::find(running.begin(), running.end(),
+                std::make_pair(self, entry.owner)));
+        }
+        state->finished.notify_all();
+    }
+}
+
+} // namespace beatconnect
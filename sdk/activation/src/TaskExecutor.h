@@ -0,0 +1,87 @@
+#pragma once
+
+/**
+ * Task Executor
+ *
+ * Small worker pool shared by every Activation instance in the process, so
+ * async calls queue onto a couple of long-lived threads instead of spawning
+ * one per call. Tasks are tagged with an owner; an owner going away cancels
+ * its queued tasks and waits for the running ones, so nothing touches a
+ * destroyed instance.
+ *
+ * The pool lives as long as someone holds it (see acquire()). The last
+ * instance to release it joins the threads from ordinary code rather than
+ * from static destruction, which may run under the loader lock on plugin
+ * unload.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace beatconnect {
+
+class TaskExecutor {
+public:
+    using Task = std::function<void()>;
+
+    /** Shared pool, started on first acquire. */
+    static std::shared_ptr<TaskExecutor> acquire();
+
+    explicit TaskExecutor(int numThreads);
+
+    /** Drains any queued tasks, then joins the workers. */
+    ~TaskExecutor();
+
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    /**
+     * Queue a task. Pass owner = nullptr for work that must run even if the
+     * caller goes away (e.g. a request other callers are waiting on).
+     */
+    void submit(const void* owner, Task task);
+
+    /**
+     * Queue a task to run once delayMs has passed. Delayed tasks that are
+     * still waiting when the executor shuts down are dropped.
+     */
+    void submitAfter(const void* owner, int64_t delayMs, Task task);
+
+    /**
+     * Drop the owner's queued tasks and wait for its running ones. Safe to
+     * call from one of the owner's own tasks (that one is not waited for).
+     */
+    void cancelAndWait(const void* owner);
+
+private:
+    struct Entry {
+        const void* owner = nullptr;
+        Task task;
+    };
+
+    // Held by the workers as well, so a worker released from inside its own
+    // task (and therefore detached, not joined) can still finish safely
+    struct State {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        std::deque<Entry> queue;
+        std::multimap<std::chrono::steady_clock::time_point, Entry> delayed;
+        std::vector<std::pair<std::thread::id, const void*>> running;
+        bool stopping = false;
+    };
+
+    static void run(std::shared_ptr<State> state);
+
+    std::shared_ptr<State> state = std::make_shared<State>();
+    std::vector<std::thread> workers;
+};
+
+} // namespace beatconnect
@@ -0,0 +1,101 @@
+#pragma once
+
+/**
+ * Block Smoothing
+ *
+ * Linear parameter smoothing computed once per block instead of once per
+ * sample per channel. next() hands back either a single value (the common
+ * case: the parameter isn't moving) or a ramp buffer filled for the whole
+ * block, which every channel then shares:
+ *
+ *   // prepareToPlay()
+ *   gain.prepare(sampleRate, samplesPerBlock);
+ *   gain.setCurrentAndTargetValue(*apvts.getRawParameterValue("gain"));
+ *
+ *   // processBlock()
+ *   gain.setTargetValue(*apvts.getRawParameterValue("gain"));
+ *   auto block = gain.next(numSamples);
+ *   for (int ch = 0; ch < numChannels; ++ch)
+ *       beatconnect::applyGain(buffer.getWritePointer(ch), numSamples, block);
+ *
+ * The ramp is sized in prepare(), so next() never allocates. Blocks larger
+ * than maxBlockSize must be split (GainMix in MixKernels.h does this).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace beatconnect {
+
+/** One block's worth of a smoothed parameter. */
+struct SmoothedBlock {
+    /** Per-sample values, or nullptr if value holds for the whole block. */
+    const float* ramp = nullptr;
+
+    /** The constant value, or the value at the end of the ramp. */
+    float value = 0.0f;
+
+    bool isConstant() const noexcept { return ramp == nullptr; }
+    float operator[](int i) const noexcept { return ramp != nullptr ? ramp[i] : value; }
+};
+
+class BlockSmoother {
+public:
+    /** Not real-time safe: sizes the ramp buffer. */
+    void prepare(double sampleRate, int maxBlockSize, double rampSeconds = 0.02) {
+        rampLength = std::max(1, (int)(sampleRate * rampSeconds));
+        ramp.assign((size_t)std::max(1, maxBlockSize), 0.0f);
+        setCurrentAndTargetValue(target);
+    }
+
+    int getMaxBlockSize() const noexcept { return (int)ramp.size(); }
+
+    /** Jump to value with no ramp (prepare, bypass, state restore). */
+    void setCurrentAndTargetValue(float value) noexcept {
+        current = target = value;
+        stepsRemaining = 0;
+    }
+
+    /** Ramp to value over the ramp time. Cheap to call every block. */
+    void setTargetValue(float value) noexcept {
+        if (value == target) return;
+        target = value;
+        stepsRemaining = rampLength;
+        step = (target - current) / (float)stepsRemaining;
+    }
+
+    bool isSmoothing() const noexcept { return stepsRemaining > 0; }
+    float getCurrentValue() const noexcept { return current; }
+    float getTargetValue() const noexcept { return target; }
+
+    /** Advance by numSamples (at most getMaxBlockSize()). */
+    SmoothedBlock next(int numSamples) noexcept {
+        if (stepsRemaining == 0) return { nullptr, current };
+
+        const int n = std::min(numSamples, getMaxBlockSize());
+        const int ramped = std::min(n, stepsRemaining);
+        float* out = ramp.data();
+
+        for (int i = 0; i < ramped; ++i) {
+            current += step;
+            out[i] = current;
+        }
+
+        stepsRemaining -= ramped;
+        if (stepsRemaining == 0) current = target;  // no drift from float steps
+        std::fill(out + ramped, out + n, current);
+
+        return { out, current };
+    }
+
+private:
+    std::vector<float> ramp;
+    int rampLength = 1;
+    int stepsRemaining = 0;
+    float current = 0.0f;
+    float target = 0.0f;
+    float step = 0.0f;
+};
+
+} // namespace beatconnect
@@ -0,0 +1,130 @@
+#pragma once
+
+/**
+ * Gain and Mix Kernels
+ *
+ * Block-at-a-time gain and dry/wet kernels built on
+ * juce::FloatVectorOperations (SSE/NEON under the hood), taking constant or
+ * ramped parameters from BlockSmoother:
+ *
+ *   beatconnect::applyGain(channel, numSamples, gainBlock);
+ *   beatconnect::mixDryWet(wet, dry, numSamples, mixBlock);
+ *
+ * GainMix bundles the template processors' gain + dry/wet stage. Since the
+ * wet path is just the dry signal times gain, the whole stage folds into one
+ * coefficient, 1 + mix * (gain - 1), computed once per block and applied
+ * with one multiply per channel:
+ *
+ *   // prepareToPlay()
+ *   gainMix.prepare(sampleRate, samplesPerBlock);
+ *   gainMix.reset(gain, mix);
+ *
+ *   // processBlock()
+ *   gainMix.setTargets(gain, mix);
+ *   gainMix.process(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+ *
+ * Everything here is allocation-free apart from prepare().
+ */
+
+#include "beatconnect/BlockSmoother.h"
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace beatconnect {
+
+// ==============================================================================
+// Kernels
+// ==============================================================================
+
+/** data *= gain */
+inline void applyGain(float* data, int numSamples, const SmoothedBlock& gain) noexcept {
+    if (gain.isConstant()) {
+        if (gain.value != 1.0f) juce::FloatVectorOperations::multiply(data, gain.value, numSamples);
+    } else {
+        juce::FloatVectorOperations::multiply(data, gain.ramp, numSamples);
+    }
+}
+
+/** wet = dry * (1 - mix) + wet * mix, in place on wet. */
+inline void mixDryWet(float* wet, const float* dry, int numSamples, const SmoothedBlock& mix) noexcept {
+    if (mix.isConstant()) {
+        if (mix.value == 1.0f) return;
+        juce::FloatVectorOperations::multiply(wet, mix.value, numSamples);
+        juce::FloatVectorOperations::addWithMultiply(wet, dry, 1.0f - mix.value, numSamples);
+    } else {
+        // dry + (wet - dry) * mix
+        juce::FloatVectorOperations::subtract(wet, dry, numSamples);
+        juce::FloatVectorOperations::multiply(wet, mix.ramp, numSamples);
+        juce::FloatVectorOperations::add(wet, dry, numSamples);
+    }
+}
+
+// ==============================================================================
+// Gain + Dry/Wet Stage
+// ==============================================================================
+
+class GainMix {
+public:
+    /** Not real-time safe. */
+    void prepare(double sampleRate, int maxBlockSize, double rampSeconds = 0.02) {
+        gain.prepare(sampleRate, maxBlockSize, rampSeconds);
+        mix.prepare(sampleRate, maxBlockSize, rampSeconds);
+        coefficients.assign((size_t)gain.getMaxBlockSize(), 0.0f);
+    }
+
+    /** Jump to these values with no ramp (prepare, bypass). */
+    void reset(float gainValue, float mixValue) noexcept {
+        gain.setCurrentAndTargetValue(gainValue);
+        mix.setCurrentAndTargetValue(mixValue);
+    }
+
+    void setTargets(float gainValue, float mixValue) noexcept {
+        gain.setTargetValue(gainValue);
+        mix.setTargetValue(mixValue);
+    }
+
+    void process(float* const* channels, int numChannels, int numSamples) noexcept {
+        const int maxBlock = gain.getMaxBlockSize();
+
+        // Hosts may exceed the block size promised in prepareToPlay()
+        for (int start = 0; start < numSamples; start += maxBlock) {
+            const int n = std::min(maxBlock, numSamples - start);
+            const auto coefficient = nextCoefficient(n);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                applyGain(channels[ch] + start, n, coefficient);
+        }
+    }
+
+private:
+    /** 1 + mix * (gain - 1) for the next n samples. */
+    SmoothedBlock nextCoefficient(int n) noexcept {
+        const auto g = gain.next(n);
+        const auto m = mix.next(n);
+
+        if (g.isConstant() && m.isConstant()) return { nullptr, 1.0f + m.value * (g.value - 1.0f) };
+
+        float* coeff = coefficients.data();
+        if (g.isConstant())
+            juce::FloatVectorOperations::fill(coeff, g.value - 1.0f, n);
+        else
+            juce::FloatVectorOperations::add(coeff, g.ramp, -1.0f, n);
+
+        if (m.isConstant())
+            juce::FloatVectorOperations::multiply(coeff, m.value, n);
+        else
+            juce::FloatVectorOperations::multiply(coeff, m.ramp, n);
+
+        juce::FloatVectorOperations::add(coeff, 1.0f, n);
+        return { coeff, coeff[n - 1] };
+    }
+
+    BlockSmoother gain;
+    BlockSmoother mix;
+    std::vector<float> coefficients;
+};
+
+} // namespace beatconnect
@@ -0,0 +1,220 @@
+#pragma once
+
+/**
+ * Parameter Table
+ *
+ * One compile-time list of a plugin's parameters, from which the APVTS
+ * layout, the audio thread's parameter reads and the editor's WebView
+ * relays (beatconnect/ParameterRelays.h) are all generated, so the three
+ * can't drift apart. The list is an X-macro in the plugin's ParameterIDs.h:
+ *
+ *   #define PLUGIN_PARAMETERS(X)                                         \
+ *       X(gain,   slider("Gain", 0.0f, 1.0f, 0.01f, 0.5f, "dB"))          \
+ *       X(bypass, toggle("Bypass", false))                               \
+ *       X(mode,   comboBox("Mode", "Clean|Warm|Hot", 0))
+ *
+ *   enum class Param : size_t { PLUGIN_PARAMETERS(BEATCONNECT_PARAMETER_ENUMERATOR) };
+ *   namespace ParamIDs { PLUGIN_PARAMETERS(BEATCONNECT_PARAMETER_ID) }
+ *   inline constexpr std::array kParameters { PLUGIN_PARAMETERS(BEATCONNECT_PARAMETER_SPEC) };
+ *
+ * The first column is both the enumerator and the parameter id the web UI
+ * uses (getSliderState("gain")). Then, in the processor:
+ *
+ *   apvts(*this, nullptr, "Parameters", beatconnect::createParameterLayout(kParameters)),
+ *   params(apvts, kParameters)       // member declared after apvts
+ *
+ *   // processBlock: an array index and an atomic load, no string lookup
+ *   auto gain = params.get(Param::gain);
+ *
+ * Parameters are read with relaxed loads; like getRawParameterValue(), a
+ * block sees each value atomically but not a consistent set across them.
+ */
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace beatconnect {
+
+// ==============================================================================
+// Parameter Spec
+// ==============================================================================
+
+enum class ParameterKind {
+    slider,     // AudioParameterFloat   <-> WebSliderRelay
+    toggle,     // AudioParameterBool    <-> WebToggleButtonRelay
+    comboBox    // AudioParameterChoice  <-> WebComboBoxRelay
+};
+
+/** One parameter's definition, built by the factories below. */
+struct ParameterSpec {
+    const char* id = "";
+    const char* name = "";
+    ParameterKind kind = ParameterKind::slider;
+
+    float minValue = 0.0f;
+    float maxValue = 1.0f;
+    float interval = 0.0f;
+    float skew = 1.0f;
+    float defaultValue = 0.0f;
+
+    const char* label = "";
+    const char* choices = "";   // comboBox: "Clean|Warm|Hot"
+    int version = 1;            // juce::ParameterID version hint
+    bool automatable = true;
+
+    static constexpr ParameterSpec slider(const char* displayName, float min, float max,
+                                          float step, float defaultVal, const char* unitLabel = "") {
+        ParameterSpec spec;
+        spec.name = displayName;
+        spec.kind = ParameterKind::slider;
+        spec.minValue = min;
+        spec.maxValue = max;
+        spec.interval = step;
+        spec.defaultValue = defaultVal;
+        spec.label = unitLabel;
+        return spec;
+    }
+
+    static constexpr ParameterSpec toggle(const char* displayName, bool defaultOn) {
+        ParameterSpec spec;
+        spec.name = displayName;
+        spec.kind = ParameterKind::toggle;
+        spec.interval = 1.0f;
+        spec.defaultValue = defaultOn ? 1.0f : 0.0f;
+        return spec;
+    }
+
+    /** options separated by '|'; defaultIndex into them. */
+    static constexpr ParameterSpec comboBox(const char* displayName, const char* options, int defaultIndex) {
+        ParameterSpec spec;
+        spec.name = displayName;
+        spec.kind = ParameterKind::comboBox;
+        spec.interval = 1.0f;
+        spec.defaultValue = (float)defaultIndex;
+        spec.choices = options;
+        return spec;
+    }
+
+    constexpr ParameterSpec withId(const char* newId) const {
+        auto spec = *this;
+        spec.id = newId;
+        return spec;
+    }
+
+    /** Range skew for sliders, e.g. frequencies (see juce::NormalisableRange). */
+    constexpr ParameterSpec withSkew(float newSkew) const {
+        auto spec = *this;
+        spec.skew = newSkew;
+        return spec;
+    }
+
+    constexpr ParameterSpec withVersion(int newVersion) const {
+        auto spec = *this;
+        spec.version = newVersion;
+        return spec;
+    }
+
+    /** Persists with the session, but the host doesn't offer it for automation. */
+    constexpr ParameterSpec notAutomatable() const {
+        auto spec = *this;
+        spec.automatable = false;
+        return spec;
+    }
+};
+
+// X-macro expanders for a PLUGIN_PARAMETERS(X) list (see top of file)
+#define BEATCONNECT_PARAMETER_ENUMERATOR(id, spec) id,
+#define BEATCONNECT_PARAMETER_ID(id, spec) inline constexpr const char* id = #id;
+#define BEATCONNECT_PARAMETER_SPEC(id, spec) beatconnect::ParameterSpec::spec.withId(#id),
+
+// ==============================================================================
+// Layout
+// ==============================================================================
+
+inline std::unique_ptr<juce::RangedAudioParameter> createParameter(const ParameterSpec& spec) {
+    const juce::ParameterID parameterId { spec.id, spec.version };
+
+    switch (spec.kind) {
+        case ParameterKind::toggle:
+            return std::make_unique<juce::AudioParameterBool>(
+                parameterId, spec.name, spec.defaultValue > 0.5f,
+                juce::AudioParameterBoolAttributes().withLabel(spec.label).withAutomatable(spec.automatable));
+
+        case ParameterKind::comboBox:
+            return std::make_unique<juce::AudioParameterChoice>(
+                parameterId, spec.name, juce::StringArray::fromTokens(spec.choices, "|", ""),
+                juce::roundToInt(spec.defaultValue),
+                juce::AudioParameterChoiceAttributes().withLabel(spec.label).withAutomatable(spec.automatable));
+
+        case ParameterKind::slider:
+            break;
+    }
+
+    return std::make_unique<juce::AudioParameterFloat>(
+        parameterId, spec.name,
+        juce::NormalisableRange<float>(spec.minValue, spec.maxValue, spec.interval, spec.skew),
+        spec.defaultValue,
+        juce::AudioParameterFloatAttributes().withLabel(spec.label).withAutomatable(spec.automatable));
+}
+
+/** Layout with one parameter per spec, in list order. */
+template <size_t N>
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout(const std::array<ParameterSpec, N>& specs) {
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
+    parameters.reserve(N);
+    for (const auto& spec : specs) {
+        parameters.push_back(createParameter(spec));
+    }
+    return { parameters.begin(), parameters.end() };
+}
+
+// ==============================================================================
+// Table
+// ==============================================================================
+
+/**
+ * Every parameter's value and object, resolved once at construction and
+ * indexed by the Param enum. get() and friends are real-time safe.
+ */
+template <typename Id, size_t N>
+class ParameterTable {
+public:
+    ParameterTable(juce::AudioProcessorValueTreeState& apvts, const std::array<ParameterSpec, N>& specs) {
+        for (size_t i = 0; i < N; ++i) {
+            parameters[i] = apvts.getParameter(specs[i].id);
+            values[i] = apvts.getRawParameterValue(specs[i].id);
+
+            // Constructed before the APVTS, or a spec missing from its layout
+            jassert(parameters[i] != nullptr && values[i] != nullptr);
+        }
+    }
+
+    /** Plain (not normalised) value. */
+    float get(Id id) const noexcept {
+        return values[index(id)]->load(std::memory_order_relaxed);
+    }
+
+    bool getBool(Id id) const noexcept { return get(id) > 0.5f; }
+
+    /** Choice index for comboBox parameters. */
+    int getIndex(Id id) const noexcept { return (int)get(id); }
+
+    std::atomic<float>& value(Id id) const noexcept { return *values[index(id)]; }
+
+    juce::RangedAudioParameter& parameter(Id id) const noexcept { return *parameters[index(id)]; }
+
+    static constexpr size_t size() noexcept { return N; }
+
+private:
+    static constexpr size_t index(Id id) noexcept { return static_cast<size_t>(id); }
+
+    std::array<std::atomic<float>*, N> values {};
+    std::array<juce::RangedAudioParameter*, N> parameters {};
+};
+
+} // namespace beatconnect
@@ -0,0 +1,360 @@
+#pragma once
+
+/**
+ * Real-Time Checks
+ *
+ * Opt-in QA instrumentation for processBlock(), switched on with the
+ * BEATCONNECT_RT_CHECKS CMake option (cmake/BeatConnectRealtimeChecks.cmake).
+ * Inside a checked scope it reports:
+ *
+ *  - heap allocation and release: operator new/delete on every platform,
+ *    plus malloc/calloc/realloc/free on Linux
+ *  - mutex, condition variable and semaphore waits, sleeps and file I/O
+ *    (Linux, where the linker routes those libc calls through the checks)
+ *  - calls into SDK APIs that block, e.g. Activation::activate()
+ *  - blocks that took more than a set fraction of their deadline
+ *    (numSamples / sampleRate), as a sign of xrun risk
+ *
+ * Each report carries the scope's source location and a backtrace of the
+ * offending call. Reports are logged from the message thread twice a
+ * second, along with a block timing summary; a call site seen before is
+ * counted rather than logged again.
+ *
+ *   // PluginProcessor.h
+ *   beatconnect::RealtimeMonitor rtMonitor;
+ *
+ *   // processBlock()
+ *   BEATCONNECT_RT_SCOPE(rtMonitor, buffer.getNumSamples(), getSampleRate());
+ *
+ * With the option off the macros expand to nothing and RealtimeMonitor is
+ * an empty class with the same interface (no timer, no report queue), so
+ * normal builds pay nothing for it.
+ */
+
+#include "beatconnect/SpscRing.h"
+
+#include <juce_events/juce_events.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+
+#ifndef BEATCONNECT_RT_CHECKS
+    #define BEATCONNECT_RT_CHECKS 0
+#endif
+
+namespace beatconnect {
+
+// ==============================================================================
+// Reports
+// ==============================================================================
+
+enum class RealtimeViolationKind : uint8_t {
+    allocation,
+    deallocation,
+    lock,
+    systemCall,
+    blocking,   // SDK call that may wait on the network, disk or a lock
+    slowBlock   // Block took more than the monitor's load threshold
+};
+
+struct RealtimeViolation {
+    static constexpr int maxFrames = 24;
+
+    RealtimeViolationKind kind = RealtimeViolationKind::allocation;
+    const char* what = "";     // Static string: "operator new", "pthread_mutex_lock", ...
+    const char* scope = "";    // __FILE__:__LINE__ of the BEATCONNECT_RT_SCOPE
+    float load = 0.0f;         // slowBlock: fraction of the deadline used
+    float deadlineMs = 0.0f;   // slowBlock
+    int numFrames = 0;
+    void* frames[maxFrames] = {};
+};
+
+/** Captures the calling thread's stack without allocating (RealtimeChecks.cpp). */
+int captureRealtimeBacktrace(void** frames, int maxFrames) noexcept;
+
+/** One line per frame, symbolized where possible. Message thread. */
+juce::String describeRealtimeBacktrace(void* const* frames, int numFrames);
+
+// ==============================================================================
+// Monitor
+// ==============================================================================
+
+struct RealtimeStats {
+    uint64_t blocks = 0;
+    uint64_t slowBlocks = 0;    // Over the load threshold
+    uint64_t overruns = 0;      // Over the whole deadline
+    uint64_t violations = 0;
+    uint64_t dropped = 0;       // Reports lost because the queue was full
+    float averageLoad = 0.0f;
+    float maxLoad = 0.0f;
+};
+
+#if BEATCONNECT_RT_CHECKS
+
+class RealtimeMonitor : private juce::Timer {
+public:
+    using Stats = RealtimeStats;
+
+    /** Blocks using more than slowBlockLoad of their deadline are reported. */
+    explicit RealtimeMonitor(float slowBlockLoad = 0.7f) : slowLoad(slowBlockLoad) {
+        // The first capture may load the unwinder; do it here, not mid-block
+        void* frames[1];
+        captureRealtimeBacktrace(frames, 1);
+        startTimer(500);
+    }
+
+    ~RealtimeMonitor() override { stopTimer(); }
+
+    /** Where reports go. Defaults to juce::Logger::writeToLog. Message thread. */
+    std::function<void(const juce::String&)> onReport;
+
+    /** Audio thread. */
+    void report(const RealtimeViolation& violation) noexcept {
+        if (violation.kind != RealtimeViolationKind::slowBlock) {
+            violations.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (!reports.push(violation)) dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Audio thread, when a checked scope ends. */
+    void addBlock(double seconds, double deadlineSeconds, const char* scope) noexcept {
+        if (deadlineSeconds <= 0.0) return;
+
+        const auto load = (float)(seconds / deadlineSeconds);
+        const auto loadMicro = (uint64_t)(load * 1.0e6f);
+        blocks.fetch_add(1, std::memory_order_relaxed);
+        loadSumMicro.fetch_add(loadMicro, std::memory_order_relaxed);
+
+        auto previousMax = maxLoadMicro.load(std::memory_order_relaxed);
+        while (loadMicro > previousMax
+               && !maxLoadMicro.compare_exchange_weak(previousMax, loadMicro, std::memory_order_relaxed)) {}
+
+        if (load <= slowLoad) return;
+
+        slowBlocks.fetch_add(1, std::memory_order_relaxed);
+        if (load > 1.0f) overruns.fetch_add(1, std::memory_order_relaxed);
+
+        RealtimeViolation violation;
+        violation.kind = RealtimeViolationKind::slowBlock;
+        violation.what = "block time";
+        violation.scope = scope;
+        violation.load = load;
+        violation.deadlineMs = (float)(deadlineSeconds * 1000.0);
+        report(violation);
+    }
+
+    Stats getStats() const noexcept {
+        Stats stats;
+        stats.blocks = blocks.load(std::memory_order_relaxed);
+        stats.slowBlocks = slowBlocks.load(std::memory_order_relaxed);
+        stats.overruns = overruns.load(std::memory_order_relaxed);
+        stats.violations = violations.load(std::memory_order_relaxed);
+        stats.dropped = dropped.load(std::memory_order_relaxed);
+        stats.maxLoad = (float)maxLoadMicro.load(std::memory_order_relaxed) * 1.0e-6f;
+        if (stats.blocks > 0) {
+            stats.averageLoad = (float)((double)loadSumMicro.load(std::memory_order_relaxed) * 1.0e-6
+                                        / (double)stats.blocks);
+        }
+        return stats;
+    }
+
+private:
+    void timerCallback() override {
+        juce::StringArray lines;
+        int repeats = 0;
+        int slow = 0;
+        RealtimeViolation slowest;
+
+        auto fileOf = [](const char* location) {
+            return juce::String(location).fromLastOccurrenceOf("/", false, false)
+                                         .fromLastOccurrenceOf("\\", false, false);
+        };
+
+        reports.popAll([&](const RealtimeViolation& v) {
+            if (v.kind == RealtimeViolationKind::slowBlock) {
+                if (slow++ == 0 || v.load > slowest.load) slowest = v;
+                return;
+            }
+
+            // Same kind from the same place: log it once
+            uint64_t signature = (uint64_t)v.kind * 0x9E3779B97F4A7C15ull;
+            for (int i = 0; i < v.numFrames; ++i) {
+                signature = (signature ^ (uint64_t)(juce::pointer_sized_uint)v.frames[i]) * 0x100000001B3ull;
+            }
+            if (++seenSites[signature] > 1) {
+                ++repeats;
+                return;
+            }
+
+            lines.add("[RT] " + fileOf(v.scope) + ": " + kindName(v.kind) + " (" + v.what + ")\n"
+                      + describeRealtimeBacktrace(v.frames, v.numFrames));
+        });
+
+        if (repeats > 0) lines.add("[RT] " + juce::String(repeats) + " more at call sites already reported");
+        if (slow > 0) {
+            lines.add("[RT] " + fileOf(slowest.scope) + ": " + juce::String(slow) + " slow blocks, worst used "
+                      + juce::String(juce::roundToInt(slowest.load * 100.0f)) + "% of its "
+                      + juce::String(slowest.deadlineMs, 2) + " ms deadline");
+        }
+
+        const auto stats = getStats();
+        if (lines.isEmpty() && stats.dropped == lastDropped) return;
+        lastDropped = stats.dropped;
+
+        lines.add("[RT] " + juce::String((juce::int64)stats.blocks) + " blocks, load avg "
+                  + juce::String(juce::roundToInt(stats.averageLoad * 100.0f)) + "% max "
+                  + juce::String(juce::roundToInt(stats.maxLoad * 100.0f)) + "%, "
+                  + juce::String((juce::int64)stats.slowBlocks) + " slow, "
+                  + juce::String((juce::int64)stats.overruns) + " overruns, "
+                  + juce::String((juce::int64)stats.violations) + " violations, "
+                  + juce::String((juce::int64)stats.dropped) + " dropped");
+
+        for (auto& line : lines) {
+            if (onReport) onReport(line);
+            else juce::Logger::writeToLog(line);
+        }
+    }
+
+    static const char* kindName(RealtimeViolationKind kind) {
+        switch (kind) {
+            case RealtimeViolationKind::allocation:   return "heap allocation";
+            case RealtimeViolationKind::deallocation: return "heap release";
+            case RealtimeViolationKind::lock:         return "lock or wait";
+            case RealtimeViolationKind::systemCall:   return "system call";
+            case RealtimeViolationKind::blocking:     return "blocking SDK call";
+            case RealtimeViolationKind::slowBlock:    return "slow block";
+        }
+        return "";
+    }
+
+    const float slowLoad;
+    SpscRing<RealtimeViolation, 128> reports;
+
+    std::atomic<uint64_t> blocks{0};
+    std::atomic<uint64_t> slowBlocks{0};
+    std::atomic<uint64_t> overruns{0};
+    std::atomic<uint64_t> violations{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> loadSumMicro{0};
+    std::atomic<uint64_t> maxLoadMicro{0};
+
+    // Message thread
+    std::map<uint64_t, int> seenSites;
+    uint64_t lastDropped = 0;
+};
+
+#else
+
+/** Checks compiled out: nothing is recorded and getStats() stays zero. */
+class RealtimeMonitor {
+public:
+    using Stats = RealtimeStats;
+
+    explicit RealtimeMonitor(float slowBlockLoad = 0.7f) noexcept { (void)slowBlockLoad; }
+
+    std::function<void(const juce::String&)> onReport;
+
+    void report(const RealtimeViolation&) noexcept {}
+    void addBlock(double, double, const char*) noexcept {}
+    Stats getStats() const noexcept { return {}; }
+};
+
+#endif
+
+// ==============================================================================
+// Scope
+// ==============================================================================
+
+/** Marks the calling thread as real-time until destroyed. Use BEATCONNECT_RT_SCOPE. */
+class RealtimeScope {
+public:
+    RealtimeScope(RealtimeMonitor& monitorToReportTo, int numSamples, double sampleRate,
+                  const char* sourceLocation) noexcept
+        : monitor(monitorToReportTo),
+          location(sourceLocation),
+          deadline(sampleRate > 0.0 ? numSamples / sampleRate : 0.0),
+          previous(current()),
+          start(Clock::now()) {
+        current() = this;
+    }
+
+    ~RealtimeScope() {
+        current() = previous;
+        monitor.addBlock(std::chrono::duration<double>(Clock::now() - start).count(), deadline, location);
+    }
+
+    RealtimeScope(const RealtimeScope&) = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+
+    /** The innermost scope on this thread, or nullptr. */
+    static RealtimeScope*& current() noexcept {
+        static thread_local RealtimeScope* scope = nullptr;
+        return scope;
+    }
+
+    /** Report a violation against the current scope, if there is one. */
+    static void report(RealtimeViolationKind kind, const char* what) noexcept {
+        auto* scope = current();
+        if (scope == nullptr || scope->suspended > 0) return;
+
+        // Capturing may allocate the first time; don't report that as well
+        ++scope->suspended;
+        RealtimeViolation violation;
+        violation.kind = kind;
+        violation.what = what;
+        violation.scope = scope->location;
+        violation.numFrames = captureRealtimeBacktrace(violation.frames, RealtimeViolation::maxFrames);
+        scope->monitor.report(violation);
+        --scope->suspended;
+    }
+
+    /** Turns checks off for its lifetime, around a call known to be safe. */
+    class Suspend {
+    public:
+        Suspend() noexcept : scope(current()) { if (scope != nullptr) ++scope->suspended; }
+        ~Suspend() { if (scope != nullptr) --scope->suspended; }
+
+        Suspend(const Suspend&) = delete;
+        Suspend& operator=(const Suspend&) = delete;
+
+    private:
+        RealtimeScope* scope;
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    RealtimeMonitor& monitor;
+    const char* location;
+    const double deadline;
+    RealtimeScope* const previous;
+    const Clock::time_point start;
+    int suspended = 0;
+};
+
+} // namespace beatconnect
+
+// ==============================================================================
+// Macros
+// ==============================================================================
+
+#if BEATCONNECT_RT_CHECKS
+    #define BEATCONNECT_RT_STRINGIFY_(x) #x
+    #define BEATCONNECT_RT_STRINGIFY(x) BEATCONNECT_RT_STRINGIFY_(x)
+
+    /** Check the rest of the enclosing block (typically all of processBlock). */
+    #define BEATCONNECT_RT_SCOPE(monitor, numSamples, sampleRate)                  \
+        beatconnect::RealtimeScope beatconnectRealtimeScope_((monitor), (numSamples), (sampleRate), \
+                                                             __FILE__ ":" BEATCONNECT_RT_STRINGIFY(__LINE__))
+
+    /** Put at the top of functions that must never run on the audio thread. */
+    #define BEATCONNECT_RT_BLOCKING(what) \
+        beatconnect::RealtimeScope::report(beatconnect::RealtimeViolationKind::blocking, what)
+#else
+    #define BEATCONNECT_RT_SCOPE(monitor, numSamples, sampleRate) ((void)0)
+    #define BEATCONNECT_RT_BLOCKING(what) ((void)0)
+#endif
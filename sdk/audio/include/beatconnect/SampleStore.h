@@ -0,0 +1,485 @@
+#pragma once
+
+/**
+ * Sample Store
+ *
+ * Shared, memory-mapped access to the audio files AssetDownloader puts on
+ * disk, so a session with many instances of a plugin holds one copy of a
+ * sample pack rather than one per instance:
+ *
+ *   // Anywhere off the audio thread (preset load, prepareToPlay)
+ *   auto store = beatconnect::SampleStore::getShared();
+ *   auto kick = store->open(juce::File(downloader.getLocalPath(assetId)));
+ *
+ *   // A voice pool, built off the audio thread: one stream per voice, not
+ *   // per sample
+ *   std::vector<std::unique_ptr<beatconnect::SampleStream>> voices;
+ *   voices.push_back(std::make_unique<beatconnect::SampleStream>(store, 2));
+ *
+ *   // processBlock()
+ *   voice.seek(*kick, 0);                             // note on
+ *   voice.read(buffer.getArrayOfWritePointers(), numChannels, numSamples);
+ *
+ * Each file is opened once per process: every open() of the same file
+ * returns the same Sample until the last reference goes. WAV and AIFF files
+ * are memory-mapped, so the OS pages them in on first touch and keeps a
+ * single copy in its cache; samples are converted to float only for the
+ * range being read. Other formats (FLAC, Ogg, MP3) can't be mapped and are
+ * decoded into memory once, still shared by every instance.
+ *
+ * Touching a mapped page may wait on the disk, so the audio thread never
+ * reads the mapping. A SampleStream serves the first preloadSamples of a
+ * sample from a decoded head kept in RAM (shared with the Sample), and the
+ * rest from a ring buffer the store's streaming thread fills ahead of the
+ * play position. If the disk falls behind, the stream outputs silence,
+ * counts an underrun and carries on in time.
+ *
+ * On Windows a mapped file can't be replaced or deleted; drop every
+ * reference to a pack's samples before deleteDownload() or syncPack()
+ * changes its files. Opening a file that has changed on disk since it was
+ * first opened gives a new Sample; holders of the old one keep the old data.
+ *
+ * Header-only; needs juce_audio_formats (the template links it through
+ * juce_audio_utils).
+ */
+
+#include "beatconnect/RealtimeChecks.h"
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace beatconnect {
+
+// ==============================================================================
+// Sample
+// ==============================================================================
+
+/** One audio file, mapped (or decoded) once and shared by everything that opened it. */
+class Sample {
+public:
+    int getNumChannels() const noexcept { return numChannels; }
+    int64_t getLengthInSamples() const noexcept { return lengthInSamples; }
+    double getSampleRate() const noexcept { return sampleRate; }
+    const juce::File& getFile() const noexcept { return file; }
+
+    /** True if served from a memory mapping, false if decoded into memory. */
+    bool isMapped() const noexcept { return mapped != nullptr; }
+
+    /** The first samples, decoded and resident. Read-only, any thread. */
+    const juce::AudioBuffer<float>& getHead() const noexcept { return head; }
+    int getHeadLength() const noexcept { return head.getNumSamples(); }
+
+    /**
+     * Decode numSamples starting at sourceStart into dest, from startSample
+     * on, zero-filling past the end. May wait on the disk, so not on the
+     * audio thread; safe from several threads at once (mapped reads keep
+     * no state).
+     */
+    void read(juce::AudioBuffer<float>& dest, int startSample, int numSamples, int64_t sourceStart) const {
+        jassert(dest.getNumChannels() >= numChannels);
+        jassert(startSample + numSamples <= dest.getNumSamples());
+
+        const auto available = (int)juce::jlimit<int64_t>(0, numSamples, lengthInSamples - sourceStart);
+        if (available > 0) {
+            if (mapped != nullptr) {
+                mapped->read(&dest, startSample, available, sourceStart, true, true);
+            } else {
+                for (int ch = 0; ch < numChannels; ++ch) {
+                    dest.copyFrom(ch, startSample, decoded, ch, (int)sourceStart, available);
+                }
+            }
+        }
+        if (available < numSamples) {
+            for (int ch = 0; ch < numChannels; ++ch) {
+                dest.clear(ch, startSample + available, numSamples - available);
+            }
+        }
+    }
+
+private:
+    friend class SampleStore;
+
+    Sample() = default;
+
+    juce::File file;
+    juce::Time modificationTime;
+    int numChannels = 0;
+    int64_t lengthInSamples = 0;
+    double sampleRate = 0.0;
+
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped;
+    juce::AudioBuffer<float> decoded;   // Formats that can't be mapped
+    juce::AudioBuffer<float> head;
+};
+
+// ==============================================================================
+// Sample Store
+// ==============================================================================
+
+class SampleStore {
+public:
+    /** Samples this long (or shorter) are kept entirely in the head. */
+    static constexpr int defaultPreloadSamples = 32768;
+
+    /** The store for this process, created on first use. */
+    static std::shared_ptr<SampleStore> getShared() {
+        static std::mutex registryMutex;
+        static std::weak_ptr<SampleStore> shared;
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        if (auto existing = shared.lock()) return existing;
+
+        std::shared_ptr<SampleStore> store(new SampleStore());
+        shared = store;
+        return store;
+    }
+
+    ~SampleStore() { streamingThread.stopThread(2000); }
+
+    SampleStore(const SampleStore&) = delete;
+    SampleStore& operator=(const SampleStore&) = delete;
+
+    /**
+     * The shared Sample for an audio file, opening it if no one holds it.
+     * Reads the header and decodes the head (the whole file for formats
+     * that can't be mapped), so never call it from the audio thread.
+     * preloadSamples only applies when this call opens the file.
+     * @return nullptr if the file is missing or not a readable audio file
+     */
+    std::shared_ptr<const Sample> open(const juce::File& file, int preloadSamples = defaultPreloadSamples) {
+        BEATCONNECT_RT_BLOCKING("SampleStore::open");
+
+        const auto modified = file.getLastModificationTime();
+        const auto key = file.getFullPathName();
+
+        if (auto existing = find(key, modified)) return existing;
+
+        // Loaded without the lock, so opening one large file doesn't hold up
+        // every other instance's opens. Two first opens of the same file at
+        // once both load it; the first to finish is kept.
+        auto sample = load(file, preloadSamples);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto existing = samples[key].lock(); existing && existing->modificationTime == modified) {
+            return existing;
+        }
+        if (sample == nullptr) {
+            samples.erase(key);
+            return nullptr;
+        }
+
+        sample->modificationTime = modified;
+        samples[key] = sample;
+        pruneExpired();
+        return sample;
+    }
+
+    /** Thread the SampleStreams of this store are filled on. */
+    juce::TimeSliceThread& getStreamingThread() { return streamingThread; }
+
+private:
+    SampleStore() {
+        formats.registerBasicFormats();
+        streamingThread.startThread(juce::Thread::Priority::high);
+    }
+
+    std::shared_ptr<const Sample> find(const juce::String& key, juce::Time modified) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = samples.find(key);
+        if (it == samples.end()) return nullptr;
+
+        auto existing = it->second.lock();
+        return existing && existing->modificationTime == modified ? existing : nullptr;
+    }
+
+    // Any thread, without the store's mutex; formats isn't changed after
+    // construction
+    std::shared_ptr<Sample> load(const juce::File& file, int preloadSamples) {
+        if (!file.existsAsFile()) return nullptr;
+
+        auto* format = formats.findFormatForFileExtension(file.getFileExtension());
+        if (format == nullptr) return nullptr;
+
+        std::shared_ptr<Sample> sample(new Sample());
+        sample->file = file;
+
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+        if (mapped != nullptr && mapped->mapEntireFile() && mapped->getMappedSection().getLength() > 0) {
+            sample->numChannels = (int)mapped->numChannels;
+            sample->lengthInSamples = mapped->lengthInSamples;
+            sample->sampleRate = mapped->sampleRate;
+            sample->mapped = std::move(mapped);
+        } else {
+            std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+            if (reader == nullptr || reader->lengthInSamples > std::numeric_limits<int>::max()) return nullptr;
+
+            sample->numChannels = (int)reader->numChannels;
+            sample->lengthInSamples = reader->lengthInSamples;
+            sample->sampleRate = reader->sampleRate;
+            sample->decoded.setSize(sample->numChannels, (int)reader->lengthInSamples);
+            reader->read(&sample->decoded, 0, (int)reader->lengthInSamples, 0, true, true);
+        }
+
+        if (sample->numChannels <= 0) return nullptr;
+
+        const auto headLength = (int)std::min<int64_t>(std::max(0, preloadSamples), sample->lengthInSamples);
+        sample->head.setSize(sample->numChannels, headLength);
+        sample->read(sample->head, 0, headLength, 0);
+        return sample;
+    }
+
+    // Call with mutex held
+    void pruneExpired() {
+        for (auto it = samples.begin(); it != samples.end();) {
+            it = it->second.expired() ? samples.erase(it) : std::next(it);
+        }
+    }
+
+    std::mutex mutex;
+    juce::AudioFormatManager formats;
+    std::map<juce::String, std::weak_ptr<Sample>> samples;
+    juce::TimeSliceThread streamingThread { "BeatConnect Sample Streaming" };
+};
+
+// ==============================================================================
+// Sample Stream
+// ==============================================================================
+
+/**
+ * Plays Samples on the audio thread without touching the disk. A stream is
+ * a voice: seek(sample, position) points it at any Sample on the audio
+ * thread, so a sampler needs one stream (and one ring buffer) per voice,
+ * not per sample. Create and destroy it off the audio thread; seek(),
+ * stop() and read() are real-time safe and must only be called from one
+ * thread at a time.
+ *
+ * Nothing is read ahead until the first seek(). The audio thread never
+ * wakes the streaming thread (that takes a lock); the stream is polled
+ * instead: every activePollMs while it is playing, every idlePollMs once it
+ * is stopped or has streamed to the end. A seek to the
+ * start is covered by the head (about 0.7 s at 48 kHz with the default
+ * preload); seeks beyond it, or a much shorter preload, can underrun for up
+ * to one poll.
+ */
+class SampleStream : private juce::TimeSliceClient {
+public:
+    /** How often a playing stream, and an idle one, is checked for a new seek. */
+    static constexpr int activePollMs = 10;
+    static constexpr int idlePollMs = 50;
+
+    /**
+     * A stream for samples of up to maxChannels channels, with bufferSamples
+     * of read-ahead beyond the head (allocated here).
+     */
+    explicit SampleStream(std::shared_ptr<SampleStore> s, int maxChannels = 2, int bufferSamples = 65536)
+        : store(std::move(s)), fifo(std::max(1024, bufferSamples)) {
+        jassert(store != nullptr && maxChannels > 0);
+        ring.setSize(std::max(1, maxChannels), fifo.getTotalSize());
+        store->getStreamingThread().addTimeSliceClient(this);
+    }
+
+    /** A stream for one sample, which it keeps alive. seek(position) plays it. */
+    SampleStream(std::shared_ptr<SampleStore> s, std::shared_ptr<const Sample> smp, int bufferSamples = 65536)
+        : SampleStream(std::move(s), smp != nullptr ? smp->getNumChannels() : 1, bufferSamples) {
+        jassert(smp != nullptr);
+        owned = std::move(smp);
+    }
+
+    ~SampleStream() override {
+        store->getStreamingThread().removeTimeSliceClient(this);
+    }
+
+    SampleStream(const SampleStream&) = delete;
+    SampleStream& operator=(const SampleStream&) = delete;
+
+    /** The sample playing, or nullptr once stopped. Audio thread. */
+    const Sample* getSample() const noexcept { return sample; }
+
+    /**
+     * Audio thread. Plays sample from position (e.g. 0 on note on). The
+     * sample must stay alive as long as the stream (an instrument keeps its
+     * samples for as long as its voices) and have no more channels than the
+     * stream was made for; otherwise the stream stops and returns false.
+     */
+    bool seek(const Sample& newSample, int64_t newPosition) noexcept {
+        if (newSample.getNumChannels() > ring.getNumChannels()) {
+            stop();
+            return false;
+        }
+
+        sample = &newSample;
+        position = std::max<int64_t>(0, newPosition);
+        requestFill(std::max<int64_t>(position, sample->getHeadLength()));
+        return true;
+    }
+
+    /** Audio thread. Restarts the current sample (or the one the stream was made with). */
+    bool seek(int64_t newPosition) noexcept {
+        const Sample* target = sample != nullptr ? sample : owned.get();
+        return target != nullptr && seek(*target, newPosition);
+    }
+
+    /** Audio thread. Silence until the next seek(); the streaming thread goes idle. */
+    void stop() noexcept {
+        if (sample == nullptr) return;
+        sample = nullptr;
+        position = 0;
+        requestFill(0);
+    }
+
+    /**
+     * Audio thread. Writes the next numSamples into dest and advances, one
+     * output channel per sample channel (a mono sample goes to every output
+     * channel). Anything not yet streamed in, past the end, or after stop()
+     * is silence.
+     * @return How many samples held audio
+     */
+    int read(float* const* dest, int numDestChannels, int numSamples) noexcept {
+        if (sample == nullptr) {
+            for (int ch = 0; ch < numDestChannels; ++ch) {
+                juce::FloatVectorOperations::clear(dest[ch], numSamples);
+            }
+            return 0;
+        }
+
+        const int sourceChannels = sample->getNumChannels();
+        auto copy = [&](int destOffset, int count, const juce::AudioBuffer<float>& source, int sourceStart) {
+            if (count <= 0) return;
+            for (int ch = 0; ch < numDestChannels; ++ch) {
+                juce::FloatVectorOperations::copy(dest[ch] + destOffset,
+                                                  source.getReadPointer(ch % sourceChannels, sourceStart), count);
+            }
+        };
+
+        int done = 0;
+        const auto& head = sample->getHead();
+        if (position < head.getNumSamples()) {
+            done = (int)std::min<int64_t>(numSamples, head.getNumSamples() - position);
+            copy(0, done, head, (int)position);
+            position += done;
+        }
+
+        if (done < numSamples && position < sample->getLengthInSamples()
+            && readyGeneration.load(std::memory_order_acquire) == fillGeneration) {
+            // After an underrun, drop what was played as silence
+            if (ringPosition < position) {
+                auto skip = (int)std::min<int64_t>(position - ringPosition, fifo.getNumReady());
+                fifo.finishedRead(skip);
+                ringPosition += skip;
+            }
+
+            if (ringPosition == position) {
+                int start1, size1, start2, size2;
+                fifo.prepareToRead(numSamples - done, start1, size1, start2, size2);
+                copy(done, size1, ring, start1);
+                copy(done + size1, size2, ring, start2);
+                fifo.finishedRead(size1 + size2);
+                done += size1 + size2;
+                position += size1 + size2;
+                ringPosition = position;
+            }
+        }
+
+        const int audible = done;
+        if (done < numSamples) {
+            for (int ch = 0; ch < numDestChannels; ++ch) {
+                juce::FloatVectorOperations::clear(dest[ch] + done, numSamples - done);
+            }
+
+            // Stay in time. The ring catches up by dropping what we missed,
+            // unless it has fallen too far behind to, then starts over here.
+            const auto missedFrom = position;
+            position += numSamples - done;
+            if (missedFrom < sample->getLengthInSamples()) {
+                underruns.fetch_add(1, std::memory_order_relaxed);
+                if (position - ringPosition > fifo.getTotalSize()) requestFill(position);
+            }
+        }
+        return audible;
+    }
+
+    int64_t getPosition() const noexcept { return position; }
+    bool isFinished() const noexcept { return sample == nullptr || position >= sample->getLengthInSamples(); }
+
+    /** Blocks that came up short because the disk hadn't kept up. */
+    uint64_t getNumUnderruns() const noexcept { return underruns.load(std::memory_order_relaxed); }
+
+private:
+    // Audio thread: points the streaming thread at the current sample and a
+    // new fill position, for it to pick up on its next poll. The ring isn't
+    // read again until it has started over from there.
+    void requestFill(int64_t from) noexcept {
+        ringPosition = from;
+        requestedSample.store(sample, std::memory_order_relaxed);
+        requestedStart.store(from, std::memory_order_relaxed);
+        requestedGeneration.store(++fillGeneration, std::memory_order_release);
+    }
+
+    // Streaming thread: keeps the ring topped up from the mapping
+    int useTimeSlice() override {
+        const auto generation = requestedGeneration.load(std::memory_order_acquire);
+        if (generation != readyGeneration.load(std::memory_order_relaxed)) {
+            // The audio thread stops reading the ring until readyGeneration
+            // catches up, so it can be reset here
+            fifo.reset();
+            fillSample = requestedSample.load(std::memory_order_relaxed);
+            writePosition = requestedStart.load(std::memory_order_relaxed);
+            readyGeneration.store(generation, std::memory_order_release);
+        }
+
+        // Stopped, or streamed to the end: nothing to do until the next seek
+        if (fillSample == nullptr || writePosition >= fillSample->getLengthInSamples()) return idlePollMs;
+
+        const int wanted = (int)std::min<int64_t>(std::min(fifo.getFreeSpace(), fillChunkSamples),
+                                                  fillSample->getLengthInSamples() - writePosition);
+        if (wanted < fillChunkSamples / 4 && writePosition + wanted < fillSample->getLengthInSamples()) {
+            return activePollMs;  // Nearly full; wait for the audio thread to make room
+        }
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(wanted, start1, size1, start2, size2);
+        if (size1 > 0) fillSample->read(ring, start1, size1, writePosition);
+        if (size2 > 0) fillSample->read(ring, start2, size2, writePosition + size1);
+        fifo.finishedWrite(size1 + size2);
+        writePosition += size1 + size2;
+        return 0;
+    }
+
+    static constexpr int fillChunkSamples = 8192;
+
+    std::shared_ptr<SampleStore> store;
+    std::shared_ptr<const Sample> owned;   // Single-sample streams
+
+    juce::AbstractFifo fifo;
+    juce::AudioBuffer<float> ring;
+
+    // Audio thread
+    const Sample* sample = nullptr;
+    int64_t position = 0;
+    int64_t ringPosition = 0;      // Source position of the ring's next sample
+    uint32_t fillGeneration = 0;
+
+    // Audio thread -> streaming thread
+    std::atomic<const Sample*> requestedSample { nullptr };
+    std::atomic<int64_t> requestedStart { 0 };
+    std::atomic<uint32_t> requestedGeneration { 0 };
+
+    // Streaming thread -> audio thread: the fill request the ring now serves
+    std::atomic<uint32_t> readyGeneration { 0 };
+
+    // Streaming thread
+    const Sample* fillSample = nullptr;
+    int64_t writePosition = 0;
+
+    std::atomic<uint64_t> underruns { 0 };
+};
+
+} // namespace beatconnect
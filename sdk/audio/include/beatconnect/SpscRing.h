@@ -0,0 +1,93 @@
+#pragma once
+
+/**
+ * Single-Producer / Single-Consumer Ring
+ *
+ * A bounded, lock-free FIFO for handing fixed-size values from one thread to
+ * exactly one other - typically the audio thread to the message thread.
+ *
+ * push() and pop() never allocate, lock or wait, so both are safe on the
+ * audio thread. Storage is a fixed array sized at compile time, and values
+ * must be trivially copyable so a push is a plain copy.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace beatconnect {
+
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing values must be trivially copyable");
+
+public:
+    static constexpr size_t capacity = Capacity;
+
+    /** Producer only. Returns false (and drops the value) if the ring is full. */
+    bool push(const T& value) noexcept {
+        const auto tail = writeIndex.load(std::memory_order_relaxed);
+        if (tail - cachedReadIndex == Capacity) {
+            cachedReadIndex = readIndex.load(std::memory_order_acquire);
+            if (tail - cachedReadIndex == Capacity) return false;
+        }
+
+        slots[tail & mask] = value;
+        writeIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Consumer only. Returns false if the ring is empty. */
+    bool pop(T& value) noexcept {
+        const auto head = readIndex.load(std::memory_order_relaxed);
+        if (head == cachedWriteIndex) {
+            cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+            if (head == cachedWriteIndex) return false;
+        }
+
+        value = slots[head & mask];
+        readIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only. Hands every value queued so far to fn(const T&) in
+     * order, then frees their slots in one step. Returns how many there were.
+     */
+    template <typename Fn>
+    size_t popAll(Fn&& fn) {
+        const auto head = readIndex.load(std::memory_order_relaxed);
+        const auto tail = writeIndex.load(std::memory_order_acquire);
+        cachedWriteIndex = tail;
+
+        for (auto i = head; i != tail; ++i) fn(static_cast<const T&>(slots[i & mask]));
+        readIndex.store(tail, std::memory_order_release);
+        return static_cast<size_t>(tail - head);
+    }
+
+    /** Approximate when called from neither side. */
+    size_t size() const noexcept {
+        return static_cast<size_t>(writeIndex.load(std::memory_order_acquire)
+                                   - readIndex.load(std::memory_order_acquire));
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+
+private:
+    static constexpr uint64_t mask = Capacity - 1;
+
+    // Producer and consumer state on separate cache lines, so neither side's
+    // writes invalidate the other's reads
+    alignas(64) std::atomic<uint64_t> writeIndex{0};
+    uint64_t cachedReadIndex = 0;   // Producer's last view of readIndex
+
+    alignas(64) std::atomic<uint64_t> readIndex{0};
+    uint64_t cachedWriteIndex = 0;  // Consumer's last view of writeIndex
+
+    alignas(64) std::array<T, Capacity> slots{};
+};
+
+} // namespace beatconnect
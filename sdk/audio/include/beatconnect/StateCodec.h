@@ -0,0 +1,301 @@
+#pragma once
+
+/**
+ * Binary State Codec
+ *
+ * Compact, versioned plugin state for getStateInformation() /
+ * setStateInformation() in place of copyState() -> createXml() ->
+ * copyXmlToBinary(): parameters are written as a table of parameter-id
+ * hashes plus a float array, with no XML DOM or text encoding on the host's
+ * save path. Anything else kept in the APVTS tree (custom properties,
+ * child trees) travels alongside as a binary ValueTree.
+ *
+ *   void getStateInformation(juce::MemoryBlock& destData) override
+ *   {
+ *       beatconnect::StateCodec::write(apvts, destData, kStateVersion);
+ *   }
+ *
+ *   void setStateInformation(const void* data, int sizeInBytes) override
+ *   {
+ *       beatconnect::StateCodec::read(apvts, data, sizeInBytes,
+ *           [](juce::uint32 fromVersion, beatconnect::StateValues& values) {
+ *               if (fromVersion < 2) values.rename("drive", "saturation");
+ *           });
+ *   }
+ *
+ * read() also accepts the XML blobs written by copyXmlToBinary() (older
+ * sessions), taking their version from the "stateVersion" attribute, so
+ * the migration hook sees both the same way.
+ *
+ * Layout (little-endian):
+ *   'BCST' | u16 format | u16 flags | u32 stateVersion | u32 tree type hash |
+ *   u32 payloadSize | payload
+ *   payload (zlib-compressed if flags & compressed):
+ *   u32 n | n x u32 id hash | n x f32 plain value | u32 extrasSize | extras
+ *
+ * Message thread (or whichever thread the host saves from); not real-time.
+ */
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+namespace beatconnect {
+
+// ==============================================================================
+// Parameter Values
+// ==============================================================================
+
+/** Stored parameter values (plain, not normalised), keyed by id hash. */
+class StateValues {
+public:
+    /** FNV-1a of the UTF-8 parameter id. */
+    static uint32_t hashId(juce::StringRef id) noexcept {
+        uint32_t hash = 2166136261u;
+        for (auto* p = id.text.getAddress(); *p != 0; ++p) {
+            hash ^= (uint8_t)*p;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    bool contains(juce::StringRef id) const { return values.count(hashId(id)) != 0; }
+
+    float get(juce::StringRef id, float fallback = 0.0f) const {
+        auto it = values.find(hashId(id));
+        return it != values.end() ? it->second : fallback;
+    }
+
+    void set(juce::StringRef id, float value) { values[hashId(id)] = value; }
+    void remove(juce::StringRef id) { values.erase(hashId(id)); }
+
+    /** Move a stored value to a new id (parameter renamed between versions). */
+    void rename(juce::StringRef from, juce::StringRef to) {
+        auto it = values.find(hashId(from));
+        if (it == values.end()) return;
+        const float value = it->second;
+        values.erase(it);
+        values[hashId(to)] = value;
+    }
+
+    size_t size() const { return values.size(); }
+
+    std::unordered_map<uint32_t, float> values;
+};
+
+/** Called between decoding and applying, to upgrade state from older versions. */
+using StateMigration = std::function<void(juce::uint32 fromVersion, StateValues& values)>;
+
+// ==============================================================================
+// Codec
+// ==============================================================================
+
+class StateCodec {
+public:
+    enum class Compression { none, zlib };
+
+    static constexpr uint32_t magic = 0x54534342;  // "BCST"
+    static constexpr uint16_t formatVersion = 2;
+    static constexpr uint16_t compressedFlag = 1;
+
+    /** Decoded state, before it's applied. */
+    struct Decoded {
+        juce::uint32 stateVersion = 0;
+        uint32_t treeType = 0;   // hashId() of the APVTS tree type that wrote it
+        StateValues values;
+        juce::ValueTree extras;  // Non-parameter properties and children, may be invalid
+    };
+
+    static void write(juce::AudioProcessorValueTreeState& apvts, juce::MemoryBlock& dest,
+                      juce::uint32 stateVersion, Compression compression = Compression::none) {
+        auto state = apvts.copyState();
+
+        // Parameters: hash table, then values
+        juce::Array<uint32_t> ids;
+        juce::Array<float> plainValues;
+        juce::ValueTree extras(state.getType());
+        extras.copyPropertiesFrom(state, nullptr);
+
+       #if JUCE_DEBUG
+        std::unordered_map<uint32_t, juce::String> idsByHash;
+       #endif
+
+        for (const auto& child : state) {
+            if (child.hasType("PARAM")) {
+                const auto id = child.getProperty("id").toString();
+                const auto hash = StateValues::hashId(id);
+
+               #if JUCE_DEBUG
+                // Two parameter ids with the same hash would be stored as one;
+                // rename one of them
+                auto inserted = idsByHash.emplace(hash, id);
+                jassert(inserted.second || inserted.first->second == id);
+               #endif
+
+                ids.add(hash);
+                plainValues.add((float)child.getProperty("value"));
+            } else {
+                extras.appendChild(child.createCopy(), nullptr);
+            }
+        }
+
+        juce::MemoryOutputStream payload;
+        payload.writeInt(ids.size());
+        for (auto id : ids) payload.writeInt((int)id);
+        for (auto value : plainValues) payload.writeFloat(value);
+
+        if (extras.getNumProperties() > 0 || extras.getNumChildren() > 0) {
+            juce::MemoryOutputStream extrasStream;
+            extras.writeToStream(extrasStream);
+            payload.writeInt((int)extrasStream.getDataSize());
+            payload.write(extrasStream.getData(), extrasStream.getDataSize());
+        } else {
+            payload.writeInt(0);
+        }
+
+        const bool compress = compression == Compression::zlib;
+
+        dest.reset();
+        juce::MemoryOutputStream out(dest, false);
+        out.writeInt((int)magic);
+        out.writeShort((short)formatVersion);
+        out.writeShort((short)(compress ? compressedFlag : 0));
+        out.writeInt((int)stateVersion);
+        out.writeInt((int)StateValues::hashId(state.getType().toString()));
+        out.writeInt((int)payload.getDataSize());
+
+        if (compress) {
+            juce::GZIPCompressorOutputStream zipped(out);
+            zipped.write(payload.getData(), payload.getDataSize());
+        } else {
+            out.write(payload.getData(), payload.getDataSize());
+        }
+    }
+
+    /**
+     * Decode a blob written by write() or copyXmlToBinary(). Returns false
+     * (leaving decoded untouched) for anything else or a damaged blob.
+     */
+    static bool decode(const void* data, int sizeInBytes, Decoded& decoded) {
+        if (data == nullptr || sizeInBytes < 20) return false;
+
+        juce::MemoryInputStream in(data, (size_t)sizeInBytes, false);
+        if ((uint32_t)in.readInt() != magic) return decodeLegacyXml(data, sizeInBytes, decoded);
+
+        const auto format = (uint16_t)in.readShort();
+        const auto flags = (uint16_t)in.readShort();
+        const auto stateVersion = (juce::uint32)in.readInt();
+        if (format != formatVersion) return false;
+
+        const auto treeType = (uint32_t)in.readInt();
+        const auto payloadSize = (juce::uint32)in.readInt();
+
+        juce::MemoryBlock payload;
+        if ((flags & compressedFlag) != 0) {
+            juce::GZIPDecompressorInputStream unzipped(in);
+            if (unzipped.readIntoMemoryBlock(payload, (ssize_t)payloadSize) != (size_t)payloadSize) return false;
+        } else if (in.readIntoMemoryBlock(payload, (ssize_t)payloadSize) != (size_t)payloadSize) {
+            return false;
+        }
+
+        juce::MemoryInputStream body(payload, false);
+        const auto count = (juce::uint32)body.readInt();
+        if ((juce::int64)count * 8 > body.getNumBytesRemaining()) return false;
+
+        juce::HeapBlock<uint32_t> ids(count);
+        for (juce::uint32 i = 0; i < count; ++i) ids[i] = (uint32_t)body.readInt();
+
+        Decoded result;
+        result.stateVersion = stateVersion;
+        result.treeType = treeType;
+        for (juce::uint32 i = 0; i < count; ++i) result.values.values[ids[i]] = body.readFloat();
+
+        const auto extrasSize = (juce::uint32)body.readInt();
+        if (extrasSize > 0) {
+            if ((juce::int64)extrasSize > body.getNumBytesRemaining()) return false;
+            result.extras = juce::ValueTree::readFromData(
+                static_cast<const char*>(payload.getData()) + body.getPosition(), extrasSize);
+        }
+
+        decoded = std::move(result);
+        return true;
+    }
+
+    /**
+     * Apply decoded state: every parameter starts from its default and
+     * stored ones take their values, so a parameter the blob doesn't know
+     * (added in a later version) never keeps whatever was loaded before.
+     * Extras replace the tree's non-parameter content.
+     */
+    static void apply(juce::AudioProcessorValueTreeState& apvts, const Decoded& decoded) {
+        juce::ValueTree state(apvts.state.getType());
+
+        for (auto* param : apvts.processor.getParameters()) {
+            auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(param);
+            if (ranged == nullptr || apvts.getParameter(ranged->getParameterID()) != ranged) continue;
+
+            const auto id = ranged->getParameterID();
+            auto value = ranged->convertFrom0to1(ranged->getDefaultValue());
+
+            auto it = decoded.values.values.find(StateValues::hashId(id));
+            if (it != decoded.values.values.end()) value = it->second;
+
+            state.appendChild(juce::ValueTree("PARAM", { { "id", id }, { "value", value } }), nullptr);
+        }
+
+        if (decoded.extras.isValid()) {
+            for (int i = 0; i < decoded.extras.getNumProperties(); ++i) {
+                auto name = decoded.extras.getPropertyName(i);
+                state.setProperty(name, decoded.extras.getProperty(name), nullptr);
+            }
+            for (const auto& child : decoded.extras) state.appendChild(child.createCopy(), nullptr);
+        }
+
+        apvts.replaceState(state);
+    }
+
+    /** decode() + migrate + apply(). Returns false if the blob wasn't usable. */
+    static bool read(juce::AudioProcessorValueTreeState& apvts, const void* data, int sizeInBytes,
+                     const StateMigration& migrate = {}) {
+        Decoded decoded;
+        if (!decode(data, sizeInBytes, decoded)) return false;
+
+        // Another processor's state
+        if (decoded.treeType != StateValues::hashId(apvts.state.getType().toString())) return false;
+
+        if (migrate) migrate(decoded.stateVersion, decoded.values);
+        apply(apvts, decoded);
+        return true;
+    }
+
+private:
+    static bool decodeLegacyXml(const void* data, int sizeInBytes, Decoded& decoded) {
+        auto xml = juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes);
+        if (xml == nullptr) return false;
+
+        auto tree = juce::ValueTree::fromXml(*xml);
+        if (!tree.isValid()) return false;
+
+        Decoded result;
+        result.stateVersion = (juce::uint32)(int)tree.getProperty("stateVersion", 0);
+        result.treeType = StateValues::hashId(tree.getType().toString());
+        tree.removeProperty("stateVersion", nullptr);
+
+        result.extras = juce::ValueTree(tree.getType());
+        result.extras.copyPropertiesFrom(tree, nullptr);
+
+        for (const auto& child : tree) {
+            if (child.hasType("PARAM"))
+                result.values.set(child.getProperty("id").toString(), (float)child.getProperty("value"));
+            else
+                result.extras.appendChild(child.createCopy(), nullptr);
+        }
+
+        decoded = std::move(result);
+        return true;
+    }
+};
+
+} // namespace beatconnect
@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * Audio-to-UI Telemetry
+ *
+ * Moves meter readings, waveform snapshots, FFT frames and the like from the
+ * audio thread to the editor without locks or allocation:
+ *
+ *   // Processor (audio thread), once per block
+ *   beatconnect::LevelFrame frame;
+ *   beatconnect::measureLevels(buffer.getArrayOfReadPointers(), numChannels,
+ *                              numSamples, frame.inputPeak, frame.inputRms);
+ *   ...
+ *   telemetry.push(frame);
+ *
+ *   // Editor (message thread), once per UI tick
+ *   beatconnect::LevelSummary levels;
+ *   processor.getTelemetry().drain([&](const beatconnect::LevelFrame& f) { levels.add(f); });
+ *
+ * A channel carries any trivially copyable frame type, e.g.
+ * struct ScopeFrame { std::array<float, 512> samples; };. Each channel has
+ * one producer and one consumer; use one channel per kind of frame.
+ */
+
+#include "beatconnect/SpscRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace beatconnect {
+
+// ==============================================================================
+// Channel
+// ==============================================================================
+
+template <typename Frame, size_t Capacity = 256>
+class TelemetryChannel {
+public:
+    /**
+     * Audio thread. Never blocks: if the UI has fallen behind (or no editor
+     * is open) the frame is dropped and counted.
+     */
+    void push(const Frame& frame) noexcept {
+        if (!ring.push(frame)) dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** UI thread. Passes every queued frame to fn(const Frame&), oldest first. */
+    template <typename Fn>
+    size_t drain(Fn&& fn) {
+        return ring.popAll(std::forward<Fn>(fn));
+    }
+
+    /** Frames dropped because the channel was full. */
+    uint64_t getNumDropped() const noexcept { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    SpscRing<Frame, Capacity> ring;
+    std::atomic<uint64_t> dropped{0};
+};
+
+// ==============================================================================
+// Levels
+// ==============================================================================
+
+/** Per-block input and output levels, across all channels. */
+struct LevelFrame {
+    float inputPeak = 0.0f;
+    float inputRms = 0.0f;
+    float outputPeak = 0.0f;
+    float outputRms = 0.0f;
+    int32_t numSamples = 0;
+};
+
+/** Peak and RMS of a block across all channels. Allocation-free. */
+inline void measureLevels(const float* const* channels, int numChannels, int numSamples,
+                          float& peak, float& rms) noexcept {
+    float maxAbs = 0.0f;
+    double sumSquares = 0.0;
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const float* data = channels[ch];
+        for (int i = 0; i < numSamples; ++i) {
+            const float s = data[i];
+            maxAbs = std::max(maxAbs, std::abs(s));
+            sumSquares += (double)s * (double)s;
+        }
+    }
+
+    const int count = numChannels * numSamples;
+    peak = maxAbs;
+    rms = count > 0 ? (float)std::sqrt(sumSquares / count) : 0.0f;
+}
+
+/**
+ * UI-side batching: folds the frames drained in one tick into a single
+ * reading - the highest peak, and RMS over all the samples they cover.
+ */
+class LevelSummary {
+public:
+    void add(const LevelFrame& frame) {
+        const double n = std::max(1, frame.numSamples);
+        inputPeak = std::max(inputPeak, frame.inputPeak);
+        outputPeak = std::max(outputPeak, frame.outputPeak);
+        inputSumSquares += (double)frame.inputRms * frame.inputRms * n;
+        outputSumSquares += (double)frame.outputRms * frame.outputRms * n;
+        numSamples += n;
+        ++numFrames;
+    }
+
+    bool isEmpty() const { return numFrames == 0; }
+    int getNumFrames() const { return numFrames; }
+
+    float getInputPeak() const { return inputPeak; }
+    float getOutputPeak() const { return outputPeak; }
+    float getInputRms() const { return numSamples > 0 ? (float)std::sqrt(inputSumSquares / numSamples) : 0.0f; }
+    float getOutputRms() const { return numSamples > 0 ? (float)std::sqrt(outputSumSquares / numSamples) : 0.0f; }
+
+    void reset() { *this = LevelSummary(); }
+
+private:
+    float inputPeak = 0.0f;
+    float outputPeak = 0.0f;
+    double inputSumSquares = 0.0;
+    double outputSumSquares = 0.0;
+    double numSamples = 0.0;
+    int numFrames = 0;
+};
+
+} // namespace beatconnect
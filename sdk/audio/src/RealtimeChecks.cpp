@@ -0,0 +1,253 @@
+/**
+ * Real-Time Checks - Implementation
+ *
+ * Compiled into the plugin only when BEATCONNECT_RT_CHECKS is on (see
+ * cmake/BeatConnectRealtimeChecks.cmake). Replaces the global allocation
+ * operators for the plugin binary and, on Linux, defines the __wrap_
+ * functions the linker routes the listed libc calls through.
+ */
+
+#include "beatconnect/RealtimeChecks.h"
+
+#include <cstdlib>
+#include <new>
+
+#if JUCE_WINDOWS
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <dbghelp.h>
+    #if JUCE_MSVC
+        #pragma comment(lib, "dbghelp.lib")
+    #endif
+#else
+    #include <execinfo.h>
+#endif
+
+#if BEATCONNECT_RT_CHECKS_WRAP
+    #include <pthread.h>
+    #include <semaphore.h>
+    #include <cstdio>
+    #include <ctime>
+    #include <unistd.h>
+#endif
+
+namespace beatconnect {
+
+// ==============================================================================
+// Backtraces
+// ==============================================================================
+
+int captureRealtimeBacktrace(void** frames, int maxFrames) noexcept {
+#if JUCE_WINDOWS
+    return (int)CaptureStackBackTrace(1, (DWORD)maxFrames, frames, nullptr);
+#else
+    return backtrace(frames, maxFrames);
+#endif
+}
+
+juce::String describeRealtimeBacktrace(void* const* frames, int numFrames) {
+    juce::String text;
+
+#if JUCE_WINDOWS
+    auto process = GetCurrentProcess();
+    static const bool symbolsLoaded = SymInitialize(process, nullptr, TRUE) != FALSE;
+
+    alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + 256] = {};
+    auto* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+    symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+    symbol->MaxNameLen = 255;
+
+    for (int i = 0; i < numFrames; ++i) {
+        DWORD64 displacement = 0;
+        text << "    " << i << ": ";
+        if (symbolsLoaded && SymFromAddr(process, (DWORD64)frames[i], &displacement, symbol)) {
+            text << symbol->Name << " + " << (int)displacement;
+        } else {
+            text << "0x" << juce::String::toHexString((juce::pointer_sized_int)frames[i]);
+        }
+        text << juce::newLine;
+    }
+#else
+    if (auto** symbols = backtrace_symbols(frames, numFrames)) {
+        for (int i = 0; i < numFrames; ++i) {
+            text << "    " << symbols[i] << juce::newLine;
+        }
+        std::free(symbols);
+    }
+#endif
+
+    return text;
+}
+
+} // namespace beatconnect
+
+// ==============================================================================
+// Allocation
+// ==============================================================================
+
+using beatconnect::RealtimeScope;
+using beatconnect::RealtimeViolationKind;
+
+#if BEATCONNECT_RT_CHECKS_WRAP
+extern "C" void* __real_malloc(size_t size);
+extern "C" void __real_free(void* ptr);
+#endif
+
+namespace {
+
+// Straight to the C allocator, past the malloc/free wrappers below
+void* rawAlloc(std::size_t size) noexcept {
+#if BEATCONNECT_RT_CHECKS_WRAP
+    return __real_malloc(size);
+#else
+    return std::malloc(size);
+#endif
+}
+
+void rawFree(void* ptr) noexcept {
+#if BEATCONNECT_RT_CHECKS_WRAP
+    __real_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void* checkedAlloc(std::size_t size) noexcept {
+    RealtimeScope::report(RealtimeViolationKind::allocation, "operator new");
+    return rawAlloc(size == 0 ? 1 : size);
+}
+
+void checkedFree(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    RealtimeScope::report(RealtimeViolationKind::deallocation, "operator delete");
+    rawFree(ptr);
+}
+
+void* checkedAlignedAlloc(std::size_t size, std::size_t alignment) noexcept {
+    RealtimeScope::report(RealtimeViolationKind::allocation, "operator new");
+    if (size == 0) size = 1;
+#if JUCE_WINDOWS
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, std::max(alignment, sizeof(void*)), size) == 0 ? ptr : nullptr;
+#endif
+}
+
+void checkedAlignedFree(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    RealtimeScope::report(RealtimeViolationKind::deallocation, "operator delete");
+#if JUCE_WINDOWS
+    _aligned_free(ptr);
+#else
+    rawFree(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (auto* ptr = checkedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (auto* ptr = checkedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return checkedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return checkedAlloc(size); }
+
+void operator delete(void* ptr) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr) noexcept { checkedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { checkedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { checkedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { checkedFree(ptr); }
+
+#if __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (auto* ptr = checkedAlignedAlloc(size, (std::size_t)alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (auto* ptr = checkedAlignedAlloc(size, (std::size_t)alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return checkedAlignedAlloc(size, (std::size_t)alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return checkedAlignedAlloc(size, (std::size_t)alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept { checkedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { checkedAlignedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { checkedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { checkedAlignedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { checkedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { checkedAlignedFree(ptr); }
+#endif
+
+// ==============================================================================
+// Linux: wrapped libc calls (-Wl,--wrap=<symbol>)
+// ==============================================================================
+
+#if BEATCONNECT_RT_CHECKS_WRAP
+
+// Declares __real_<name> and defines __wrap_<name>, which reports and then
+// forwards. The list must match _BEATCONNECT_RT_CHECKS_WRAPPED in the cmake.
+#define BEATCONNECT_RT_WRAP(kind, ret, name, params, args)          \
+    extern "C" ret __real_##name params;                           \
+    extern "C" ret __wrap_##name params;                           \
+    extern "C" ret __wrap_##name params {                          \
+        RealtimeScope::report(RealtimeViolationKind::kind, #name); \
+        return __real_##name args;                                 \
+    }
+
+BEATCONNECT_RT_WRAP(allocation, void*, calloc, (size_t count, size_t size), (count, size))
+BEATCONNECT_RT_WRAP(allocation, void*, realloc, (void* ptr, size_t size), (ptr, size))
+
+BEATCONNECT_RT_WRAP(lock, int, pthread_mutex_lock, (pthread_mutex_t* mutex), (mutex))
+BEATCONNECT_RT_WRAP(lock, int, pthread_cond_wait, (pthread_cond_t* cond, pthread_mutex_t* mutex), (cond, mutex))
+BEATCONNECT_RT_WRAP(lock, int, pthread_cond_timedwait,
+                    (pthread_cond_t* cond, pthread_mutex_t* mutex, const struct timespec* until),
+                    (cond, mutex, until))
+BEATCONNECT_RT_WRAP(lock, int, pthread_rwlock_rdlock, (pthread_rwlock_t* lock), (lock))
+BEATCONNECT_RT_WRAP(lock, int, pthread_rwlock_wrlock, (pthread_rwlock_t* lock), (lock))
+BEATCONNECT_RT_WRAP(lock, int, sem_wait, (sem_t* semaphore), (semaphore))
+
+BEATCONNECT_RT_WRAP(systemCall, int, nanosleep, (const struct timespec* duration, struct timespec* remaining),
+                    (duration, remaining))
+BEATCONNECT_RT_WRAP(systemCall, int, usleep, (useconds_t microseconds), (microseconds))
+BEATCONNECT_RT_WRAP(systemCall, ssize_t, read, (int fd, void* buffer, size_t count), (fd, buffer, count))
+BEATCONNECT_RT_WRAP(systemCall, ssize_t, write, (int fd, const void* buffer, size_t count), (fd, buffer, count))
+BEATCONNECT_RT_WRAP(systemCall, FILE*, fopen, (const char* path, const char* mode), (path, mode))
+BEATCONNECT_RT_WRAP(systemCall, size_t, fread, (void* buffer, size_t size, size_t count, FILE* file),
+                    (buffer, size, count, file))
+BEATCONNECT_RT_WRAP(systemCall, size_t, fwrite, (const void* buffer, size_t size, size_t count, FILE* file),
+                    (buffer, size, count, file))
+BEATCONNECT_RT_WRAP(systemCall, int, fflush, (FILE* file), (file))
+
+#undef BEATCONNECT_RT_WRAP
+
+extern "C" void* __wrap_malloc(size_t size);
+extern "C" void __wrap_free(void* ptr);
+
+extern "C" void* __wrap_malloc(size_t size) {
+    RealtimeScope::report(RealtimeViolationKind::allocation, "malloc");
+    return __real_malloc(size);
+}
+
+extern "C" void __wrap_free(void* ptr) {
+    if (ptr != nullptr) RealtimeScope::report(RealtimeViolationKind::deallocation, "free");
+    __real_free(ptr);
+}
+
+#endif
@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * Editor Update Scheduler
+ *
+ * Drop-in replacement for startTimerHz(30) in an editor. The tick runs at
+ * the active rate while something is changing, falls back to a slow idle
+ * rate once ticks stop reporting changes, and to a slower rate still while
+ * the editor isn't showing (window hidden or minimised, tab closed):
+ *
+ *   // Member of the editor
+ *   beatconnect::UpdateScheduler scheduler { *this, [this] { return updateMeters(); } };
+ *
+ *   // Constructor
+ *   scheduler.start();
+ *
+ * The tick returns true when it did visible work (sent a frame, repainted a
+ * meter). It keeps running at every rate, so telemetry keeps draining; only
+ * how often changes. Call wake() when something outside the tick changes
+ * (a parameter moved, transport started) to return to the active rate at once.
+ *
+ * Message thread only.
+ */
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <functional>
+#include <utility>
+
+namespace beatconnect {
+
+struct UpdateRates {
+    int activeHz = 30;
+    int idleHz = 4;
+    int hiddenHz = 1;
+
+    /** Consecutive ticks without changes before dropping to idleHz. */
+    int idleAfterTicks = 15;
+};
+
+class UpdateScheduler : private juce::Timer {
+public:
+    enum class Mode { Stopped, Active, Idle, Hidden };
+
+    UpdateScheduler(juce::Component& ownerToWatch, std::function<bool()> onTick, UpdateRates updateRates = {})
+        : owner(ownerToWatch), tick(std::move(onTick)), rates(updateRates) {}
+
+    ~UpdateScheduler() override { stopTimer(); }
+
+    void start() {
+        quietTicks = 0;
+        setMode(owner.isShowing() ? Mode::Active : Mode::Hidden);
+    }
+
+    void stop() {
+        stopTimer();
+        mode = Mode::Stopped;
+    }
+
+    /** Back to the active rate, e.g. after a parameter change. */
+    void wake() {
+        quietTicks = 0;
+        if (mode == Mode::Idle) setMode(Mode::Active);
+    }
+
+    Mode getMode() const { return mode; }
+
+private:
+    void timerCallback() override {
+        const bool changed = tick();
+
+        if (!owner.isShowing()) {
+            setMode(Mode::Hidden);
+            return;
+        }
+
+        if (changed) {
+            quietTicks = 0;
+            setMode(Mode::Active);
+        } else if (++quietTicks >= rates.idleAfterTicks) {
+            setMode(Mode::Idle);
+        } else if (mode == Mode::Hidden) {
+            setMode(Mode::Active);
+        }
+    }
+
+    void setMode(Mode next) {
+        if (next == mode) return;
+        mode = next;
+
+        switch (mode) {
+            case Mode::Active: startTimerHz(rates.activeHz); break;
+            case Mode::Idle:   startTimerHz(rates.idleHz); break;
+            case Mode::Hidden: startTimerHz(rates.hiddenHz); break;
+            case Mode::Stopped: stopTimer(); break;
+        }
+    }
+
+    juce::Component& owner;
+    std::function<bool()> tick;
+    UpdateRates rates;
+    Mode mode = Mode::Stopped;
+    int quietTicks = 0;
+};
+
+} // namespace beatconnect
@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * Parameter Relays
+ *
+ * JUCE 8 WebView relays and parameter attachments for every parameter in a
+ * plugin's table (beatconnect/ParameterTable.h, audio SDK), instead of a
+ * hand-written relay, withOptionsFrom() and attachment per parameter. The
+ * relay type follows each spec's kind and its identifier is the parameter
+ * id, so the web UI's getSliderState("gain") etc. match by construction.
+ *
+ * Usage (PluginEditor):
+ *
+ *   // Member
+ *   beatconnect::ParameterRelays relays { kParameters };
+ *
+ *   // setupWebView(), before creating the WebBrowserComponent
+ *   auto options = relays.withOptions(juce::WebBrowserComponent::Options())...;
+ *
+ *   // After creating it
+ *   relays.attach(processorRef.getAPVTS());
+ *
+ * Message thread only. Header-only; compiles in the plugin against its
+ * juce_gui_extra.
+ */
+
+#include <beatconnect/ParameterTable.h>
+
+#if defined(JUCE_GUI_EXTRA_H_INCLUDED) && JUCE_WEB_BROWSER
+
+#include <array>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace beatconnect {
+
+class ParameterRelays {
+public:
+    /** specs: the parameter table's std::array, or any other container of ParameterSpec. */
+    template <typename Specs>
+    explicit ParameterRelays(const Specs& specs) {
+        entries.reserve(std::size(specs));
+        for (const auto& spec : specs) {
+            auto& entry = entries.emplace_back();
+            entry.id = spec.id;
+            entry.kind = spec.kind;
+
+            switch (spec.kind) {
+                case ParameterKind::slider:   entry.slider = std::make_unique<juce::WebSliderRelay>(spec.id); break;
+                case ParameterKind::toggle:   entry.toggle = std::make_unique<juce::WebToggleButtonRelay>(spec.id); break;
+                case ParameterKind::comboBox: entry.comboBox = std::make_unique<juce::WebComboBoxRelay>(spec.id); break;
+            }
+        }
+    }
+
+    /** options with every relay registered. Call before creating the browser. */
+    juce::WebBrowserComponent::Options withOptions(juce::WebBrowserComponent::Options options) const {
+        for (const auto& entry : entries) {
+            if (entry.slider != nullptr)   options = options.withOptionsFrom(*entry.slider);
+            if (entry.toggle != nullptr)   options = options.withOptionsFrom(*entry.toggle);
+            if (entry.comboBox != nullptr) options = options.withOptionsFrom(*entry.comboBox);
+        }
+        return options;
+    }
+
+    /**
+     * Connect each relay to its APVTS parameter: pushes the current value to
+     * the web UI and keeps both sides in sync from then on (automation,
+     * presets, drags with undo grouping).
+     */
+    void attach(juce::AudioProcessorValueTreeState& apvts, juce::UndoManager* undoManager = nullptr) {
+        for (auto& entry : entries) {
+            auto* parameter = apvts.getParameter(entry.id);
+            jassert(parameter != nullptr);  // Spec missing from the layout
+            if (parameter == nullptr) continue;
+
+            switch (entry.kind) {
+                case ParameterKind::slider:
+                    entry.sliderAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
+                        *parameter, *entry.slider, undoManager);
+                    break;
+                case ParameterKind::toggle:
+                    entry.toggleAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment>(
+                        *parameter, *entry.toggle, undoManager);
+                    break;
+                case ParameterKind::comboBox:
+                    entry.comboBoxAttachment = std::make_unique<juce::WebComboBoxParameterAttachment>(
+                        *parameter, *entry.comboBox, undoManager);
+                    break;
+            }
+        }
+    }
+
+    /** Drop the attachments, e.g. before the browser goes away. Relays stay. */
+    void detach() {
+        for (auto& entry : entries) {
+            entry.sliderAttachment.reset();
+            entry.toggleAttachment.reset();
+            entry.comboBoxAttachment.reset();
+        }
+    }
+
+private:
+    // Attachments are declared after the relays they hold, so they go first
+    struct Entry {
+        juce::String id;
+        ParameterKind kind = ParameterKind::slider;
+
+        std::unique_ptr<juce::WebSliderRelay> slider;
+        std::unique_ptr<juce::WebToggleButtonRelay> toggle;
+        std::unique_ptr<juce::WebComboBoxRelay> comboBox;
+
+        std::unique_ptr<juce::WebSliderParameterAttachment> sliderAttachment;
+        std::unique_ptr<juce::WebToggleButtonParameterAttachment> toggleAttachment;
+        std::unique_ptr<juce::WebComboBoxParameterAttachment> comboBoxAttachment;
+    };
+
+    std::vector<Entry> entries;
+};
+
+} // namespace beatconnect
+
+#endif
@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * Visualizer Transport
+ *
+ * Ships float buffers (meters, waveforms, spectra) to the web UI as packed
+ * binary instead of a juce::var tree per value. Each frame becomes one event
+ * carrying the raw little-endian float32 bytes as base64, which the web side
+ * decodes straight into a reused Float32Array (see
+ * addVisualizerStreamListener() / useVisualizerStream() in the web template).
+ *
+ * Frames that haven't changed since the last one sent on the same stream -
+ * silence, a frozen spectrum - are suppressed, optionally within a
+ * threshold. The web side asks for a resend when it first subscribes, so a
+ * reloaded page still gets the current frame.
+ *
+ * Usage (PluginEditor):
+ *
+ *   // Member, declared before the WebBrowserComponent it's registered with
+ *   beatconnect::VisualizerTransport visualizer;
+ *
+ *   options = beatconnect::withVisualizerTransport(options, visualizer);
+ *   ...
+ *   // timerCallback()
+ *   beatconnect::sendVisualizerFrame(*webView, visualizer, "scope", samples, numSamples);
+ *
+ * Message thread only.
+ */
+
+#include <juce_core/juce_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace beatconnect {
+
+class VisualizerTransport {
+public:
+    /** Event carrying { stream, seq, data } to the web UI. */
+    static constexpr const char* eventId = "__beatconnect__viz";
+
+    /** Event the web UI emits to have every stream sent again. */
+    static constexpr const char* resyncEventId = "__beatconnect__vizResync";
+
+    /**
+     * Frames whose values are all within threshold of the last frame sent
+     * on their stream are suppressed; 0 suppresses only identical frames.
+     */
+    explicit VisualizerTransport(float threshold = 0.0f);
+
+    void setThreshold(float threshold);
+
+    /**
+     * Payload for a frame on stream, or a void var if the frame is
+     * suppressed. A returned payload counts as sent.
+     */
+    juce::var encode(const std::string& stream, const float* data, size_t count);
+
+    /** Forget what was sent, so the next frame on every stream goes out. */
+    void invalidate();
+
+private:
+    struct Stream {
+        std::vector<float> last;
+        uint32_t sequence = 0;
+        bool sent = false;
+    };
+
+    bool unchanged(const Stream& stream, const float* data, size_t count) const;
+
+    std::unordered_map<std::string, Stream> streams;
+    float threshold;
+};
+
+} // namespace beatconnect
+
+// ==============================================================================
+// WebBrowserComponent integration
+// ==============================================================================
+
+#if defined(JUCE_GUI_EXTRA_H_INCLUDED) && JUCE_WEB_BROWSER
+
+namespace beatconnect {
+
+/** Register the web UI's resync request. transport must outlive the browser. */
+inline juce::WebBrowserComponent::Options withVisualizerTransport(juce::WebBrowserComponent::Options options,
+                                                                  VisualizerTransport& transport) {
+    return options.withEventListener(VisualizerTransport::resyncEventId,
+        [&transport](const juce::var&) { transport.invalidate(); });
+}
+
+/**
+ * Send a frame if it changed. While the browser isn't showing nothing is
+ * sent, and the next frame after it reappears always is.
+ */
+inline bool sendVisualizerFrame(juce::WebBrowserComponent& browser, VisualizerTransport& transport,
+                                const std::string& stream, const float* data, size_t count) {
+    if (!browser.isShowing()) {
+        transport.invalidate();
+        return false;
+    }
+
+    auto payload = transport.encode(stream, data, count);
+    if (payload.isVoid()) return false;
+
+    browser.emitEventIfBrowserIsVisible(VisualizerTransport::eventId, payload);
+    return true;
+}
+
+} // namespace beatconnect
+
+#endif
@@ -0,0 +1,165 @@
+#pragma once
+
+/**
+ * Web Resource Cache
+ *
+ * Serves a plugin's bundled web UI to JUCE's WebBrowserComponent from an
+ * immutable, process-wide cache instead of the filesystem.
+ *
+ * The first editor to open loads the tree once: files under Resources/WebUI
+ * are memory-mapped, embedded BinaryData is referenced in place, and an
+ * embedded archive (see cmake/BeatConnectWebUI.cmake) is inflated. Every
+ * editor open at the same time (in any plugin instance in the process)
+ * shares that cache, and it is released when the last one lets go of it.
+ * MIME types are resolved once per file through a hash table, not per
+ * request.
+ *
+ * Usage (PluginEditor.cpp):
+ *
+ *   auto options = juce::WebBrowserComponent::Options()
+ *       .withNativeIntegrationEnabled()
+ *       .withResourceProvider(beatconnect::makeResourceProvider(
+ *           beatconnect::WebResourceCache::forDirectory(resourcesDir)));
+ *
+ * makeResourceProvider() is available once <juce_gui_extra/juce_gui_extra.h>
+ * is included with JUCE_WEB_BROWSER enabled.
+ */
+
+#include <juce_core/juce_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace beatconnect {
+
+class WebResourceCache {
+public:
+    struct Resource {
+        const std::byte* data = nullptr;
+        size_t size = 0;
+        const char* mimeType = "application/octet-stream";
+    };
+
+    /** A file that already lives in memory for the process lifetime. */
+    struct EmbeddedFile {
+        std::string path;        // Relative to the UI root, '/' separated
+        const void* data = nullptr;
+        size_t size = 0;
+    };
+
+    /**
+     * Cache for a directory such as Resources/WebUI, loaded on first use and
+     * shared while any caller holds it. Returns nullptr if the directory is
+     * missing or empty; that result isn't cached, so a later call can pick
+     * up a freshly copied build.
+     */
+    static std::shared_ptr<const WebResourceCache> forDirectory(const juce::File& root);
+
+    /**
+     * Cache over memory the caller keeps alive (typically static data).
+     * Nothing is copied. key identifies the set for sharing between callers.
+     */
+    static std::shared_ptr<const WebResourceCache> fromEmbedded(const std::string& key,
+                                                                std::vector<EmbeddedFile> files);
+
+    /**
+     * Cache over a juce_add_binary_data target, e.g.
+     *
+     *   fromBinaryData(BinaryData::namedResourceList, BinaryData::namedResourceListSize,
+     *                  BinaryData::getNamedResource, BinaryData::getNamedResourceOriginalFilename);
+     *
+     * BinaryData keeps only file names, not directories, so lookups that
+     * miss fall back to the requested file name.
+     */
+    static std::shared_ptr<const WebResourceCache> fromBinaryData(
+        const char* const* namedResourceList, int numResources,
+        const char* (*getNamedResource)(const char*, int&),
+        const char* (*getOriginalFilename)(const char*));
+
+    /**
+     * Cache over a zip archive in memory, such as the one
+     * beatconnect_embed_webui() packs and embeds at build time. Entries are
+     * inflated once, on first use, and shared while any caller holds the
+     * cache; the archive itself must stay alive (static BinaryData does).
+     *
+     * Memory: every entry is inflated up front onto the heap, so while the
+     * cache is held the process carries the whole uncompressed UI
+     * (getTotalBytes()) on top of the compressed archive in the binary.
+     * Entries are served identity-encoded: WebBrowserComponent::Resource
+     * has no way to set Content-Encoding, so precompressed (.br / .gz)
+     * variants couldn't be handed to the browser as they are.
+     */
+    static std::shared_ptr<const WebResourceCache> fromArchive(const void* data, size_t size);
+
+    /**
+     * Look up a request path as passed to a resource provider ("/",
+     * "/assets/index.js?v=2", ...). "/" and directory paths map to their
+     * index.html. Returns nullptr if there's no such file.
+     */
+    const Resource* find(const std::string& url) const;
+
+    /** Number of files and their combined size. */
+    size_t getNumFiles() const { return resources.size(); }
+    int64_t getTotalBytes() const { return totalBytes; }
+
+    /** MIME type for a path's extension (case-insensitive). */
+    static const char* mimeTypeFor(const std::string& path);
+
+private:
+    WebResourceCache() = default;
+
+    static std::shared_ptr<const WebResourceCache> fromMemory(const std::string& key,
+                                                              std::vector<EmbeddedFile> files, bool flat);
+
+    void add(std::string path, const void* data, size_t size);
+
+    std::unordered_map<std::string, Resource> resources;
+    std::vector<std::unique_ptr<juce::MemoryMappedFile>> mappings;
+    std::vector<std::unique_ptr<juce::MemoryBlock>> buffers;  // Inflated or unmappable files
+    int64_t totalBytes = 0;
+    bool flat = false;
+};
+
+} // namespace beatconnect
+
+// ==============================================================================
+// WebBrowserComponent integration
+// ==============================================================================
+
+#if defined(JUCE_GUI_EXTRA_H_INCLUDED) && JUCE_WEB_BROWSER
+
+#include <functional>
+#include <optional>
+
+namespace beatconnect {
+
+/**
+ * Resource provider for WebBrowserComponent::Options::withResourceProvider().
+ * Holds the cache alive. A null cache serves nothing (e.g. dev mode with no
+ * bundled build).
+ *
+ * WebBrowserComponent::Resource owns its bytes as a std::vector, so each
+ * request makes the one copy JUCE requires, straight from the mapped pages.
+ */
+inline std::function<std::optional<juce::WebBrowserComponent::Resource>(const juce::String&)>
+makeResourceProvider(std::shared_ptr<const WebResourceCache> cache) {
+    return [cache = std::move(cache)](const juce::String& url) -> std::optional<juce::WebBrowserComponent::Resource> {
+        if (!cache) return std::nullopt;
+
+        auto* resource = cache->find(url.toStdString());
+        if (!resource) return std::nullopt;
+
+        return juce::WebBrowserComponent::Resource{
+            std::vector<std::byte>(resource->data, resource->data + resource->size),
+            juce::String(resource->mimeType)
+        };
+    };
+}
+
+} // namespace beatconnect
+
+#endif
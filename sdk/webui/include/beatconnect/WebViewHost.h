@@ -0,0 +1,308 @@
+#pragma once
+
+/**
+ * WebView Host
+ *
+ * Lends editors a web view that's already running instead of each editor
+ * building its own WebBrowserComponent. Opening an editor otherwise pays
+ * for WebView2 environment creation, browser process startup and a full
+ * page load every time (1-2 s on Windows, nearly as long for every further
+ * instance).
+ *
+ * One host per plugin per process. Every view it creates uses the same
+ * options, including the WebView2 user data folder, so they share one
+ * environment and browser process. When an editor closes, its view is
+ * parked with the page still loaded, and the next editor to open gets it
+ * back at once. After the first page load, the host also pre-warms a
+ * spare view in the background, so a second instance opens just as fast.
+ *
+ * Views own what the browser was built with: one relay per parameter
+ * (ParameterRelays) and the visualizer transport. Editors attach the
+ * relays to their APVTS, and receive the web UI's events through a handler
+ * instead of listeners bound to one editor:
+ *
+ *   // PluginEditor member (declared after anything the handler uses)
+ *   beatconnect::WebViewHost::Lease webView;
+ *
+ *   // Constructor
+ *   webView = beatconnect::WebViewHost::forPlugin("MyPlugin", [] {
+ *       beatconnect::WebViewConfig config;
+ *       config.parameters = { kParameters.begin(), kParameters.end() };
+ *       config.events = { "activatePlugin" };
+ *       config.options = [](auto options) { return options.withResourceProvider(...); };
+ *       config.url = juce::WebBrowserComponent::getResourceProviderRoot();
+ *       return config;
+ *   }).acquire();
+ *
+ *   webView->getRelays().attach(processorRef.getAPVTS());
+ *   webView->setEventHandler([this](const juce::Identifier& id, const juce::var& data) { ... });
+ *   addAndMakeVisible(*webView);
+ *
+ * A reused page was last set up by another editor (possibly another
+ * instance): relay attachments push every parameter again, and once the
+ * view is showing in its new editor it emits attachedEventId, so the page
+ * can re-request anything else (addEditorAttachedListener() in
+ * juce-bridge.ts). Views keep their page loaded while hidden or parked.
+ *
+ * Message thread only. Header-only; compiles in the plugin against its
+ * juce_gui_extra. Hosts are deleted with the rest of JUCE's
+ * DeletedAtShutdown objects.
+ */
+
+#include <beatconnect/ParameterRelays.h>
+#include <beatconnect/VisualizerTransport.h>
+
+#if defined(JUCE_GUI_EXTRA_H_INCLUDED) && JUCE_WEB_BROWSER
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace beatconnect {
+
+// ==============================================================================
+// Configuration
+// ==============================================================================
+
+struct WebViewConfig {
+    // Parameters for the relays (the plugin's parameter table)
+    std::vector<ParameterSpec> parameters;
+
+    // Web UI events forwarded to the editor the view is lent to
+    std::vector<juce::Identifier> events;
+
+    // Everything else the browser needs: backend, resource provider,
+    // platform options (WebView2 user data folder, background colour).
+    // Must not capture an editor; views outlive them.
+    std::function<juce::WebBrowserComponent::Options(juce::WebBrowserComponent::Options)> options;
+
+    // Page to load: the dev server, or getResourceProviderRoot()
+    juce::String url;
+
+    // Loaded views kept parked for the next editor, counting the pre-warmed
+    // spare. Each costs a renderer process; 0 gives the old behaviour.
+    int spareViews = 1;
+
+    // Load a spare in the background once the first page has loaded
+    bool prewarm = true;
+
+    // Size of views loaded before any editor shows them
+    int initialWidth = 800;
+    int initialHeight = 500;
+};
+
+// ==============================================================================
+// WebView Host
+// ==============================================================================
+
+class WebViewHost : private juce::AsyncUpdater,
+                    private juce::DeletedAtShutdown {
+public:
+    /** Emitted to a reused page when it's lent to another editor. */
+    static constexpr const char* attachedEventId = "__beatconnect__attached";
+
+    // ==========================================================================
+    // View
+    // ==========================================================================
+
+    /** A browser with its relays and visualizer transport, lent to one editor at a time. */
+    class View : public juce::Component {
+    public:
+        using EventHandler = std::function<void(const juce::Identifier& event, const juce::var& data)>;
+
+        juce::WebBrowserComponent& getBrowser() { return *browser; }
+        ParameterRelays& getRelays() { return relays; }
+        VisualizerTransport& getVisualizer() { return visualizer; }
+
+        /** Receives the events listed in WebViewConfig::events. Cleared when the view is returned. */
+        void setEventHandler(EventHandler handler) { eventHandler = std::move(handler); }
+
+        /** True once the page has finished loading. */
+        bool isLoaded() const { return loaded; }
+
+        void resized() override { browser->setBounds(getLocalBounds()); }
+
+        // Events sent before the editor is on screen are dropped
+        void parentHierarchyChanged() override { sendAttachedIfShowing(); }
+        void visibilityChanged() override { sendAttachedIfShowing(); }
+
+    private:
+        friend class WebViewHost;
+
+        class Browser : public juce::WebBrowserComponent {
+        public:
+            Browser(View& v, const Options& options) : juce::WebBrowserComponent(options), view(v) {}
+            void pageFinishedLoading(const juce::String&) override { view.pageLoaded(); }
+
+        private:
+            View& view;
+        };
+
+        View(WebViewHost& h, const WebViewConfig& config) : host(h), relays(config.parameters) {
+            // Without this a hidden browser navigates to about:blank, and
+            // every handoff between editors reloads the page
+            auto base = juce::WebBrowserComponent::Options().withKeepPageLoadedWhenBrowserIsHidden();
+            auto options = withVisualizerTransport(relays.withOptions(base), visualizer);
+            for (const auto& event : config.events) {
+                options = options.withEventListener(event, [this, event](const juce::var& data) {
+                    if (eventHandler) eventHandler(event, data);
+                });
+            }
+            if (config.options) options = config.options(options);
+
+            browser = std::make_unique<Browser>(*this, options);
+            addAndMakeVisible(*browser);
+            setSize(config.initialWidth, config.initialHeight);
+            browser->goToURL(config.url);
+        }
+
+        void pageLoaded() {
+            loaded = true;
+            host.viewLoaded();
+        }
+
+        void sendAttachedIfShowing() {
+            if (!attachPending || !isShowing()) return;
+            attachPending = false;
+            browser->emitEventIfBrowserIsVisible(attachedEventId, juce::var());
+        }
+
+        WebViewHost& host;
+
+        // Registered with the browser, so declared before it
+        ParameterRelays relays;
+        VisualizerTransport visualizer;
+        EventHandler eventHandler;
+
+        std::unique_ptr<Browser> browser;
+        bool loaded = false;
+        bool attachPending = false;   // Lent with another editor's page, not yet shown
+    };
+
+    /** Hands the view back to its host when the editor lets go of it. */
+    struct Return {
+        WebViewHost* host = nullptr;
+        void operator()(View* view) const { host->release(view); }
+    };
+
+    using Lease = std::unique_ptr<View, Return>;
+
+    // ==========================================================================
+    // Host
+    // ==========================================================================
+
+    /**
+     * The host for pluginName in this process, created on first use from
+     * makeConfig (which is called only then).
+     */
+    static WebViewHost& forPlugin(const juce::String& pluginName, const std::function<WebViewConfig()>& makeConfig) {
+        auto& host = getHosts()[pluginName];
+        if (host == nullptr) host = new WebViewHost(pluginName, makeConfig());
+        return *host;
+    }
+
+    /** A view for an editor: a parked one with its page loaded if there is one. */
+    Lease acquire() {
+        auto found = std::find_if(parked.begin(), parked.end(), [](const auto& v) { return v->isLoaded(); });
+        if (found == parked.end()) found = parked.begin();
+
+        std::unique_ptr<View> view;
+        if (found != parked.end()) {
+            view = std::move(*found);
+            parked.erase(found);
+            parking.removeChildComponent(view.get());
+        } else {
+            view.reset(new View(*this, config));
+        }
+
+        // The page is still showing another editor's state; it's told once
+        // the new editor has it on screen
+        if (view->isLoaded()) {
+            view->visualizer.invalidate();
+            view->attachPending = true;
+        }
+
+        // Replace the spare that was just taken
+        if (everLoaded) triggerAsyncUpdate();
+
+        return Lease(view.release(), Return { this });
+    }
+
+    int getNumParkedViews() const { return (int)parked.size(); }
+
+private:
+    /** Off-screen window parked views stay in, so their native views survive. */
+    class ParkingWindow : public juce::Component {
+    public:
+        void open(int width, int height) {
+            if (isOnDesktop()) return;
+            setBounds(-30000, -30000, width, height);
+            addToDesktop(juce::ComponentPeer::windowIsTemporary | juce::ComponentPeer::windowIgnoresKeyPresses
+                         | juce::ComponentPeer::windowIgnoresMouseClicks);
+            setVisible(true);
+        }
+    };
+
+    WebViewHost(const juce::String& name, WebViewConfig c) : pluginName(name), config(std::move(c)) {}
+
+    ~WebViewHost() override {
+        cancelPendingUpdate();
+        parked.clear();
+        getHosts().erase(pluginName);
+    }
+
+    static std::map<juce::String, WebViewHost*>& getHosts() {
+        static std::map<juce::String, WebViewHost*> hosts;
+        return hosts;
+    }
+
+    void park(std::unique_ptr<View> view) {
+        parking.open(config.initialWidth, config.initialHeight);
+        parking.addAndMakeVisible(*view);
+        parked.push_back(std::move(view));
+    }
+
+    void release(View* returned) {
+        std::unique_ptr<View> view(returned);
+        view->getRelays().detach();
+        view->setEventHandler(nullptr);
+        view->attachPending = false;
+        if (auto* parent = view->getParentComponent()) parent->removeChildComponent(view.get());
+
+        // Keep loaded pages over spares that are still loading
+        if ((int)parked.size() >= config.spareViews && view->isLoaded()) {
+            auto loading = std::find_if(parked.begin(), parked.end(), [](const auto& v) { return !v->isLoaded(); });
+            if (loading != parked.end()) parked.erase(loading);
+        }
+
+        if ((int)parked.size() < config.spareViews) park(std::move(view));
+    }
+
+    void viewLoaded() {
+        if (!everLoaded) {
+            everLoaded = true;
+            triggerAsyncUpdate();
+        }
+    }
+
+    // Pre-warm, off the editor's own load
+    void handleAsyncUpdate() override {
+        if (!config.prewarm) return;
+        while ((int)parked.size() < config.spareViews) park(std::unique_ptr<View>(new View(*this, config)));
+    }
+
+    juce::String pluginName;
+    WebViewConfig config;
+
+    // Declared before the views parked in it
+    ParkingWindow parking;
+    std::vector<std::unique_ptr<View>> parked;
+
+    bool everLoaded = false;
+};
+
+} // namespace beatconnect
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * Visualizer Transport - Implementation
+ */
+
+#include "beatconnect/VisualizerTransport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace beatconnect {
+
+VisualizerTransport::VisualizerTransport(float t) : threshold(std::max(0.0f, t)) {}
+
+void VisualizerTransport::setThreshold(float t) {
+    threshold = std::max(0.0f, t);
+}
+
+juce::var VisualizerTransport::encode(const std::string& name, const float* data, size_t count) {
+    auto& stream = streams[name];
+    if (stream.sent && unchanged(stream, data, count)) return {};
+
+    stream.last.assign(data, data + count);
+    stream.sent = true;
+    ++stream.sequence;
+
+    // One string for the whole frame; the web side reads it back as float32
+    // in the platform's (little-endian) byte order
+    juce::DynamicObject::Ptr payload = new juce::DynamicObject();
+    payload->setProperty("stream", juce::String(name));
+    payload->setProperty("seq", (juce::int64)stream.sequence);
+    payload->setProperty("data", juce::Base64::toBase64(data, count * sizeof(float)));
+    return juce::var(payload.get());
+}
+
+void VisualizerTransport::invalidate() {
+    for (auto& entry : streams) entry.second.sent = false;
+}
+
+bool VisualizerTransport::unchanged(const Stream& stream, const float* data, size_t count) const {
+    if (stream.last.size() != count) return false;
+    if (threshold == 0.0f) return count == 0 || std::memcmp(stream.last.data(), data, count * sizeof(float)) == 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (std::abs(stream.last[i] - data[i]) > threshold) return false;
+    }
+    return true;
+}
+
+} // namespace beatconnect
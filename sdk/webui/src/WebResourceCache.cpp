@@ -0,0 +1,231 @@
+/**
+ * Web Resource Cache - Implementation
+ */
+
+#include "beatconnect/WebResourceCache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+
+namespace beatconnect {
+
+namespace {
+
+// Caches are shared while any host holds one: editors open at the same time,
+// and the views the web view pool keeps warm. Once the last of them lets go
+// the mappings are released, so a rebuilt UI on disk is picked up next time.
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_map<std::string, std::weak_ptr<const WebResourceCache>>& registry() {
+    static std::unordered_map<std::string, std::weak_ptr<const WebResourceCache>> caches;
+    return caches;
+}
+
+// Caller holds registryMutex(). Expired entries are dropped on the way.
+std::shared_ptr<const WebResourceCache> findCached(const std::string& key) {
+    auto& caches = registry();
+    for (auto it = caches.begin(); it != caches.end();) {
+        if (it->second.expired()) it = caches.erase(it);
+        else ++it;
+    }
+
+    auto it = caches.find(key);
+    return it == caches.end() ? nullptr : it->second.lock();
+}
+
+std::string normalisePath(const std::string& url) {
+    auto end = url.find_first_of("?#");
+    std::string path = url.substr(0, end);
+
+    size_t start = 0;
+    while (start < path.size() && path[start] == '/') ++start;
+    if (path.compare(start, 2, "./") == 0) start += 2;
+    path.erase(0, start);
+
+    if (path.empty() || path.back() == '/') path += "index.html";
+    return path;
+}
+
+std::string fileNameOf(const std::string& path) {
+    auto slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace
+
+// ==============================================================================
+// Construction
+// ==============================================================================
+
+std::shared_ptr<const WebResourceCache> WebResourceCache::forDirectory(const juce::File& root) {
+    const auto key = root.getFullPathName().toStdString();
+
+    std::lock_guard<std::mutex> lock(registryMutex());
+    if (auto existing = findCached(key)) return existing;
+
+    if (!root.isDirectory()) return nullptr;
+
+    std::shared_ptr<WebResourceCache> cache(new WebResourceCache());
+    for (const auto& file : root.findChildFiles(juce::File::findFiles, true)) {
+        auto path = file.getRelativePathFrom(root).replaceCharacter('\\', '/').toStdString();
+
+        // Mapped pages are shared with the OS file cache and only paged in
+        // when served
+        auto mapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+        if (mapping->getData() != nullptr) {
+            cache->add(std::move(path), mapping->getData(), mapping->getSize());
+            cache->mappings.push_back(std::move(mapping));
+            continue;
+        }
+
+        // Empty files can't be mapped; anything else unmappable is read once
+        auto block = std::make_unique<juce::MemoryBlock>();
+        if (file.getSize() > 0 && !file.loadFileAsData(*block)) continue;
+        cache->add(std::move(path), block->getData(), block->getSize());
+        cache->buffers.push_back(std::move(block));
+    }
+
+    if (cache->resources.empty()) return nullptr;
+
+    registry()[key] = cache;
+    return cache;
+}
+
+std::shared_ptr<const WebResourceCache> WebResourceCache::fromEmbedded(const std::string& key,
+                                                                       std::vector<EmbeddedFile> files) {
+    return fromMemory(key, std::move(files), false);
+}
+
+std::shared_ptr<const WebResourceCache> WebResourceCache::fromMemory(const std::string& key,
+                                                                     std::vector<EmbeddedFile> files, bool flat) {
+    std::lock_guard<std::mutex> lock(registryMutex());
+    if (auto existing = findCached(key)) return existing;
+
+    std::shared_ptr<WebResourceCache> cache(new WebResourceCache());
+    cache->flat = flat;
+    for (auto& file : files) {
+        cache->add(normalisePath(file.path), file.data, file.size);
+    }
+    if (cache->resources.empty()) return nullptr;
+
+    registry()[key] = cache;
+    return cache;
+}
+
+std::shared_ptr<const WebResourceCache> WebResourceCache::fromBinaryData(
+    const char* const* namedResourceList, int numResources,
+    const char* (*getNamedResource)(const char*, int&),
+    const char* (*getOriginalFilename)(const char*)) {
+    // The resource list is unique to the binary it's compiled into
+    const auto key = "binarydata:" + std::to_string(reinterpret_cast<uintptr_t>(namedResourceList));
+
+    std::vector<EmbeddedFile> files;
+    files.reserve((size_t)std::max(0, numResources));
+    for (int i = 0; i < numResources; ++i) {
+        int size = 0;
+        const char* data = getNamedResource(namedResourceList[i], size);
+        const char* name = getOriginalFilename(namedResourceList[i]);
+        if (data == nullptr || name == nullptr) continue;
+        files.push_back({name, data, (size_t)size});
+    }
+
+    return fromMemory(key, std::move(files), true);
+}
+
+std::shared_ptr<const WebResourceCache> WebResourceCache::fromArchive(const void* data, size_t size) {
+    const auto key = "archive:" + std::to_string(reinterpret_cast<uintptr_t>(data));
+
+    std::lock_guard<std::mutex> lock(registryMutex());
+    if (auto existing = findCached(key)) return existing;
+
+    juce::MemoryInputStream input(data, size, false);
+    juce::ZipFile archive(input);
+
+    std::shared_ptr<WebResourceCache> cache(new WebResourceCache());
+    for (int i = 0; i < archive.getNumEntries(); ++i) {
+        auto* entry = archive.getEntry(i);
+        auto path = entry->filename.replaceCharacter('\\', '/').toStdString();
+        if (path.empty() || path.back() == '/') continue;  // Directory entry
+
+        std::unique_ptr<juce::InputStream> stream(archive.createStreamForEntry(i));
+        if (!stream) continue;
+
+        auto block = std::make_unique<juce::MemoryBlock>();
+        stream->readIntoMemoryBlock(*block);
+        cache->add(normalisePath(path), block->getData(), block->getSize());
+        cache->buffers.push_back(std::move(block));
+    }
+    if (cache->resources.empty()) return nullptr;
+
+    registry()[key] = cache;
+    return cache;
+}
+
+void WebResourceCache::add(std::string path, const void* data, size_t size) {
+    Resource resource;
+    resource.data = static_cast<const std::byte*>(data);
+    resource.size = size;
+    resource.mimeType = mimeTypeFor(path);
+    totalBytes += (int64_t)size;
+    resources[std::move(path)] = resource;
+}
+
+// ==============================================================================
+// Lookup
+// ==============================================================================
+
+const WebResourceCache::Resource* WebResourceCache::find(const std::string& url) const {
+    auto path = normalisePath(url);
+    auto it = resources.find(path);
+    if (it == resources.end() && flat) it = resources.find(fileNameOf(path));
+    return it == resources.end() ? nullptr : &it->second;
+}
+
+const char* WebResourceCache::mimeTypeFor(const std::string& path) {
+    static const std::unordered_map<std::string, const char*> types = {
+        {"html", "text/html"},
+        {"htm", "text/html"},
+        {"css", "text/css"},
+        {"js", "application/javascript"},
+        {"mjs", "application/javascript"},
+        {"json", "application/json"},
+        {"map", "application/json"},
+        {"wasm", "application/wasm"},
+        {"txt", "text/plain"},
+        {"xml", "application/xml"},
+        {"png", "image/png"},
+        {"jpg", "image/jpeg"},
+        {"jpeg", "image/jpeg"},
+        {"gif", "image/gif"},
+        {"webp", "image/webp"},
+        {"avif", "image/avif"},
+        {"svg", "image/svg+xml"},
+        {"ico", "image/x-icon"},
+        {"woff", "font/woff"},
+        {"woff2", "font/woff2"},
+        {"ttf", "font/ttf"},
+        {"otf", "font/otf"},
+        {"wav", "audio/wav"},
+        {"mp3", "audio/mpeg"},
+        {"ogg", "audio/ogg"},
+        {"mp4", "video/mp4"},
+        {"webm", "video/webm"},
+    };
+
+    auto name = fileNameOf(path);
+    auto dot = name.find_last_of('.');
+    if (dot == std::string::npos) return "application/octet-stream";
+
+    std::string extension = name.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](unsigned char c) { return (char)std::tolower(c); });
+
+    auto it = types.find(extension);
+    return it == types.end() ? "application/octet-stream" : it->second;
+}
+
+} // namespace beatconnect
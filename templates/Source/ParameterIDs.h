@@ -1,32 +1,47 @@
 /*
   ==============================================================================
-    {{PLUGIN_NAME}} - Parameter IDs
+    {{PLUGIN_NAME}} - Parameters
     BeatConnect Plugin Template
 
-    Define all parameter identifiers as constexpr strings.
-    These IDs must match exactly between:
-    - C++ (APVTS parameter creation)
-    - C++ (relay creation)
-    - TypeScript (getSliderState(), etc.)
+    Every parameter is defined once, in PLUGIN_PARAMETERS below. From that
+    list the SDK generates:
+    - the APVTS layout (beatconnect::createParameterLayout)
+    - the processor's cached parameter reads, indexed by Param
+    - the editor's WebView relays and attachments (beatconnect::ParameterRelays)
+
+    The first column is the parameter id, which must match the web code's
+    getSliderState(), getToggleState() and getComboBoxState() calls.
   ==============================================================================
 */
 
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <beatconnect/ParameterTable.h>
 
-namespace ParamIDs
+// One line per parameter - add yours here:
+//   X(id, slider(name, min, max, step, default, label))
+//   X(id, toggle(name, default))
+//   X(id, comboBox(name, "Option A|Option B", defaultIndex))
+// Chain .withSkew(), .withVersion() or .notAutomatable() onto a spec as needed.
+#define PLUGIN_PARAMETERS(X)                                         \
+    X(gain,   slider("Gain", 0.0f, 1.0f, 0.01f, 0.5f, "dB"))          \
+    X(mix,    slider("Mix", 0.0f, 1.0f, 0.01f, 1.0f, "%"))            \
+    X(bypass, toggle("Bypass", false))
+    // X(mode,   comboBox("Mode", "Clean|Warm|Hot", 0))   (add a \ to the line above)
+
+// Param::gain, Param::mix, ... - index into the processor's parameter table
+enum class Param : size_t
 {
-    // Example parameters - modify for your plugin
-    inline constexpr const char* gain   = "gain";
-    inline constexpr const char* mix    = "mix";
-    inline constexpr const char* bypass = "bypass";
-    // inline constexpr const char* mode   = "mode";
-}
+    PLUGIN_PARAMETERS(BEATCONNECT_PARAMETER_ENUMERATOR)
+};
 
-// Default values and choice options
-namespace ParamDefaults
+// ParamIDs::gain == "gain", for code that needs the string id
+namespace ParamIDs
 {
-    // Example choice options for ComboBox parameters
-    // inline const juce::StringArray modeOptions { "Clean", "Warm", "Hot" };
+    PLUGIN_PARAMETERS(BEATCONNECT_PARAMETER_ID)
 }
+
+inline constexpr std::array kParameters { PLUGIN_PARAMETERS(BEATCONNECT_PARAMETER_SPEC) };
+
+using ParameterTable = beatconnect::ParameterTable<Param, kParameters.size()>;
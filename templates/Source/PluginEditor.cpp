@@ -11,6 +11,12 @@
 #include "PluginEditor.h"
 #include "ParameterIDs.h"
 
+#include <beatconnect/WebResourceCache.h>
+
+#if BEATCONNECT_WEBUI_EMBEDDED
+#include "WebUIData.h"
+#endif
+
 #if BEATCONNECT_ACTIVATION_ENABLED
 #include <beatconnect/Activation.h>
 #endif
@@ -19,6 +25,90 @@
 // Set {{PLUGIN_NAME_UPPER}}_DEV_MODE=1 in CMakeLists.txt to use dev server
 static constexpr const char* DEV_SERVER_URL = "http://localhost:5173";
 
+//==============================================================================
+// WebView configuration, shared by every editor of this plugin in the
+// process. Built once, by the first editor to open; nothing here may refer
+// to an editor, since the views outlive them.
+static beatconnect::WebViewConfig makeWebViewConfig()
+{
+    beatconnect::WebViewConfig config;
+
+    // ===========================================================================
+    // STEP 1: Relays exist BEFORE creating WebBrowserComponent
+    // ===========================================================================
+    // Each view holds one relay per parameter in PLUGIN_PARAMETERS
+    // (ParameterIDs.h), identified by the parameter id your web code passes
+    // to getSliderState(), getToggleState() or getComboBoxState(). Add
+    // parameters there, not here.
+    config.parameters = { kParameters.begin(), kParameters.end() };
+
+    // Web UI events handled by the editor (handleWebEvent)
+    config.events = { "getActivationStatus",
+                      "getPresetList", "saveUserPreset", "loadUserPreset",
+                      "renameUserPreset", "deleteUserPreset" };
+#if BEATCONNECT_ACTIVATION_ENABLED
+    config.events.push_back("activatePlugin");
+    config.events.push_back("deactivatePlugin");
+#endif
+
+    // ===========================================================================
+    // STEP 2: Load the bundled web UI for production builds
+    // ===========================================================================
+    // Either embedded in the binary ({{PLUGIN_NAME_UPPER}}_EMBED_WEBUI) or
+    // copied next to it in Resources/WebUI. Loaded once per process and
+    // shared by every view.
+#if BEATCONNECT_WEBUI_EMBEDDED
+    auto webResources = beatconnect::WebResourceCache::fromArchive(
+        WebUIData::WebUI_zip, (size_t) WebUIData::WebUI_zipSize);
+#else
+    auto resourcesDir = juce::File::getSpecialLocation(juce::File::currentExecutableFile)
+                            .getParentDirectory()
+                            .getChildFile("Resources")
+                            .getChildFile("WebUI");
+    auto webResources = beatconnect::WebResourceCache::forDirectory(resourcesDir);
+#endif
+
+    // ===========================================================================
+    // STEP 3: WebBrowserComponent options (relays are added by the host)
+    // ===========================================================================
+    // The same user data folder for every view, so they share one WebView2
+    // environment and browser process
+    config.options = [webResources](juce::WebBrowserComponent::Options options)
+    {
+        return options
+            .withBackend(juce::WebBrowserComponent::Options::Backend::webview2)
+            .withNativeIntegrationEnabled()
+            // Resource provider serves bundled web files in production
+            .withResourceProvider(beatconnect::makeResourceProvider(webResources))
+            // Windows-specific WebView2 options
+            .withWinWebView2Options(
+                juce::WebBrowserComponent::Options::WinWebView2()
+                    .withBackgroundColour(juce::Colour(0xff1a1a1a))
+                    .withStatusBarDisabled()
+                    .withUserDataFolder(
+                        juce::File::getSpecialLocation(juce::File::tempDirectory)
+                            .getChildFile("{{PLUGIN_NAME}}_WebView2")));
+    };
+
+    // ===========================================================================
+    // STEP 4: URL based on build mode
+    // ===========================================================================
+#if {{PLUGIN_NAME_UPPER}}_DEV_MODE
+    // Development: connect to Vite dev server for hot reload
+    config.url = DEV_SERVER_URL;
+#else
+    // Production: load from bundled resources via resource provider
+    config.url = juce::WebBrowserComponent::getResourceProviderRoot();
+#endif
+
+    // One loaded view kept for the next editor, pre-warmed after the first
+    // page load. Raise for plugins usually open in several instances at once.
+    config.spareViews = 1;
+    config.initialWidth = 800;
+    config.initialHeight = 500;
+    return config;
+}
+
 //==============================================================================
 {{PLUGIN_NAME}}Editor::{{PLUGIN_NAME}}Editor({{PLUGIN_NAME}}Processor& p)
     : AudioProcessorEditor(&p),
@@ -26,119 +116,39 @@ static constexpr const char* DEV_SERVER_URL = "http://localhost:5173";
 {
     setupWebView();
     setupRelaysAndAttachments();
+    setupPresetEvents();
     setupActivationEvents();
 
     // Set plugin window size
     setSize(800, 500);
     setResizable(false, false);
 
-    // Start timer for sending visualizer/meter data to web UI (30 Hz)
-    startTimerHz(30);
+    // Start sending visualizer/meter data to web UI (adaptive, up to 30 Hz)
+    scheduler.start();
 }
 
 {{PLUGIN_NAME}}Editor::~{{PLUGIN_NAME}}Editor()
 {
-    stopTimer();
+    scheduler.stop();
+    processorRef.getPresetManager().onUserPresetsChanged = nullptr;
+
+#if BEATCONNECT_ACTIVATION_ENABLED
+    if (auto* activation = processorRef.getActivation())
+        activation->removeStateListener(activationListenerId);
+#endif
 }
 
 //==============================================================================
 void {{PLUGIN_NAME}}Editor::setupWebView()
 {
-    // ===========================================================================
-    // STEP 1: Create relays BEFORE creating WebBrowserComponent
-    // ===========================================================================
-    // Relays must exist before building WebView options.
-    // The relay identifier must match the identifier used in your web code's
-    // getSliderState(), getToggleState(), or getComboBoxState() calls.
-
-    // Slider relays (continuous float parameters)
-    gainRelay = std::make_unique<juce::WebSliderRelay>("gain");
-    mixRelay = std::make_unique<juce::WebSliderRelay>("mix");
-
-    // Toggle relays (boolean parameters)
-    bypassRelay = std::make_unique<juce::WebToggleButtonRelay>("bypass");
-
-    // ComboBox relays (choice parameters) - uncomment if needed:
-    // modeRelay = std::make_unique<juce::WebComboBoxRelay>("mode");
+    // A parked view with its page already loaded if there is one (instant),
+    // otherwise a new one in the plugin's shared WebView2 environment
+    webView = beatconnect::WebViewHost::forPlugin("{{PLUGIN_NAME}}", makeWebViewConfig).acquire();
 
-    // ===========================================================================
-    // STEP 2: Get resources directory for production builds
-    // ===========================================================================
-    resourcesDir = juce::File::getSpecialLocation(juce::File::currentExecutableFile)
-                       .getParentDirectory()
-                       .getChildFile("Resources")
-                       .getChildFile("WebUI");
-
-    // ===========================================================================
-    // STEP 3: Build WebBrowserComponent with JUCE 8 options
-    // ===========================================================================
-    auto options = juce::WebBrowserComponent::Options()
-        .withBackend(juce::WebBrowserComponent::Options::Backend::webview2)
-        .withNativeIntegrationEnabled()
-        // Resource provider serves bundled web files in production
-        .withResourceProvider(
-            [this](const juce::String& url) -> std::optional<juce::WebBrowserComponent::Resource>
-            {
-                auto path = url;
-                if (path.startsWith("/"))
-                    path = path.substring(1);
-                if (path.isEmpty())
-                    path = "index.html";
-
-                auto file = resourcesDir.getChildFile(path);
-                if (!file.existsAsFile())
-                    return std::nullopt;
-
-                // Determine MIME type
-                juce::String mimeType = "application/octet-stream";
-                if (path.endsWith(".html")) mimeType = "text/html";
-                else if (path.endsWith(".css")) mimeType = "text/css";
-                else if (path.endsWith(".js")) mimeType = "application/javascript";
-                else if (path.endsWith(".json")) mimeType = "application/json";
-                else if (path.endsWith(".png")) mimeType = "image/png";
-                else if (path.endsWith(".jpg") || path.endsWith(".jpeg")) mimeType = "image/jpeg";
-                else if (path.endsWith(".svg")) mimeType = "image/svg+xml";
-                else if (path.endsWith(".woff")) mimeType = "font/woff";
-                else if (path.endsWith(".woff2")) mimeType = "font/woff2";
-
-                juce::MemoryBlock data;
-                file.loadFileAsData(data);
-
-                return juce::WebBrowserComponent::Resource{
-                    std::vector<std::byte>(
-                        reinterpret_cast<const std::byte*>(data.getData()),
-                        reinterpret_cast<const std::byte*>(data.getData()) + data.getSize()),
-                    mimeType.toStdString()
-                };
-            })
-        // Register relays with WebView
-        .withOptionsFrom(*gainRelay)
-        .withOptionsFrom(*mixRelay)
-        .withOptionsFrom(*bypassRelay)
-        // .withOptionsFrom(*modeRelay)  // Uncomment if using
-        // Windows-specific WebView2 options
-        .withWinWebView2Options(
-            juce::WebBrowserComponent::Options::WinWebView2()
-                .withBackgroundColour(juce::Colour(0xff1a1a1a))
-                .withStatusBarDisabled()
-                .withUserDataFolder(
-                    juce::File::getSpecialLocation(juce::File::tempDirectory)
-                        .getChildFile("{{PLUGIN_NAME}}_WebView2")));
-
-    // Create the WebBrowserComponent
-    webView = std::make_unique<juce::WebBrowserComponent>(options);
+    webView->setEventHandler([this](const juce::Identifier& event, const juce::var& data) {
+        handleWebEvent(event, data);
+    });
     addAndMakeVisible(*webView);
-
-    // ===========================================================================
-    // STEP 4: Load URL based on build mode
-    // ===========================================================================
-#if {{PLUGIN_NAME_UPPER}}_DEV_MODE
-    // Development: connect to Vite dev server for hot reload
-    webView->goToURL(DEV_SERVER_URL);
-#else
-    // Production: load from bundled resources via resource provider
-    webView->goToURL(webView->getResourceProviderRoot());
-#endif
 }
 
 //==============================================================================
@@ -153,74 +163,179 @@ void {{PLUGIN_NAME}}Editor::setupRelaysAndAttachments()
     // - Updates web when APVTS changes (e.g., automation)
     // - Handles drag start/end for proper undo/redo grouping
 
-    auto& apvts = processorRef.getAPVTS();
+    webView->getRelays().attach(processorRef.getAPVTS());
+}
+
+//==============================================================================
+bool {{PLUGIN_NAME}}Editor::sendVisualizerData()
+{
+    // ===========================================================================
+    // Send custom data to web (meters, visualizers, status)
+    // ===========================================================================
+    // Numeric data (meters, waveforms, spectra) goes through the visualizer
+    // transport as packed float32 frames; the web side reads each stream with
+    // useVisualizerStream(). Unchanged frames are skipped automatically.
+    // Anything else can still be sent as a JSON event with
+    // emitEventIfBrowserIsVisible().
+    //
+    // Called by the scheduler; return true when something was sent so it
+    // stays at the active rate.
+
+    // Fold every level frame the audio thread queued since the last tick
+    // into one reading. Drained even without a WebView so it can't go stale.
+    beatconnect::LevelSummary levels;
+    processorRef.getLevelTelemetry().drain([&levels](const beatconnect::LevelFrame& frame) {
+        levels.add(frame);
+    });
+
+    if (!webView || levels.isEmpty())
+        return false;
+
+    // Audio levels, 0..1: [inputPeak, outputPeak, inputRms, outputRms]
+    const float levelFrame[] = { levels.getInputPeak(), levels.getOutputPeak(),
+                                 levels.getInputRms(), levels.getOutputRms() };
+    auto& browser = webView->getBrowser();
+    bool sent = beatconnect::sendVisualizerFrame(browser, webView->getVisualizer(), "levels", levelFrame, 4);
 
-    // Slider attachments
-    gainAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParamIDs::gain), *gainRelay, nullptr);
-    mixAttachment = std::make_unique<juce::WebSliderParameterAttachment>(
-        *apvts.getParameter(ParamIDs::mix), *mixRelay, nullptr);
+    // Example: waveform or spectrum from another telemetry channel
+    // beatconnect::sendVisualizerFrame(browser, webView->getVisualizer(), "scope",
+    //                                  scope.samples.data(), scope.samples.size());
 
-    // Toggle attachments
-    bypassAttachment = std::make_unique<juce::WebToggleButtonParameterAttachment>(
-        *apvts.getParameter(ParamIDs::bypass), *bypassRelay, nullptr);
+    // Example: non-numeric data as a JSON event
+    // juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    // data->setProperty("isPlaying", processorRef.isHostPlaying());
+    // browser.emitEventIfBrowserIsVisible("visualizerData", juce::var(data.get()));
 
-    // ComboBox attachments - uncomment if using:
-    // modeAttachment = std::make_unique<juce::WebComboBoxParameterAttachment>(
-    //     *apvts.getParameter(ParamIDs::mode), *modeRelay, nullptr);
+    return sent;
 }
 
 //==============================================================================
-void {{PLUGIN_NAME}}Editor::timerCallback()
+// Presets (usePresets)
+//==============================================================================
+
+void {{PLUGIN_NAME}}Editor::setupPresetEvents()
 {
-    sendVisualizerData();
-    sendActivationState();
+    // The index changed for a reason other than this editor's own requests:
+    // first background scan done, files changed on disk, another instance
+    // saved a preset. Called on the message thread.
+    processorRef.getPresetManager().onUserPresetsChanged = [this] { sendPresetListChanged(); };
 }
 
-void {{PLUGIN_NAME}}Editor::sendVisualizerData()
+void {{PLUGIN_NAME}}Editor::sendPresetListChanged()
 {
-    // ===========================================================================
-    // Send custom data to web (meters, visualizers, status)
-    // ===========================================================================
-    // This is for non-parameter data like level meters, waveforms, etc.
-    // Use emitEventIfBrowserIsVisible() to avoid queueing events when hidden.
+    // The web UI refetches its first page with its current search
+    if (webView)
+        webView->getBrowser().emitEventIfBrowserIsVisible("presetListChanged", juce::var());
+}
 
-    if (!webView)
-        return;
+bool {{PLUGIN_NAME}}Editor::handlePresetEvent(const juce::Identifier& event, const juce::var& data)
+{
+    auto& presets = processorRef.getPresetManager();
+    auto& browser = webView->getBrowser();
+
+    auto sendResult = [&browser](const char* resultEvent, bool success, juce::DynamicObject::Ptr result,
+                                 const char* error) {
+        result->setProperty("success", success);
+        if (!success)
+            result->setProperty("error", error);
+        browser.emitEventIfBrowserIsVisible(resultEvent, juce::var(result.get()));
+    };
+
+    // One page of user presets: { offset, limit, query }
+    if (event == juce::Identifier("getPresetList"))
+    {
+        auto list = presets.getPresetListAsJson((int) data.getProperty("offset", 0),
+                                                (int) data.getProperty("limit", -1),
+                                                data.getProperty("query", "").toString());
+        browser.emitEventIfBrowserIsVisible("presetList", juce::JSON::parse(list));
+        return true;
+    }
 
-    // Build visualizer data object
-    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    if (event == juce::Identifier("saveUserPreset"))
+    {
+        auto name = data.getProperty("name", "").toString().trim();
+        const bool saved = name.isNotEmpty() && presets.saveUserPreset(name);
 
-    // Example: send audio levels
-    // data->setProperty("inputLevel", processorRef.getInputLevel());
-    // data->setProperty("outputLevel", processorRef.getOutputLevel());
+        juce::DynamicObject::Ptr result = new juce::DynamicObject();
+        result->setProperty("name", name);
+        sendResult("savePresetResult", saved, result, "Could not save preset");
+        if (saved)
+            sendPresetListChanged();
+        return true;
+    }
 
-    // Example: send playback state
-    // data->setProperty("isPlaying", processorRef.isHostPlaying());
+    if (event == juce::Identifier("loadUserPreset"))
+    {
+        auto name = data.getProperty("name", "").toString();
+        const bool isFactory = (bool) data.getProperty("isFactory", false);
 
-    // Send to web UI
-    webView->emitEventIfBrowserIsVisible("visualizerData", juce::var(data.get()));
+        juce::DynamicObject::Ptr result = new juce::DynamicObject();
+        result->setProperty("name", name);
+        result->setProperty("isFactory", isFactory);
+        sendResult("loadPresetResult", presets.loadPreset(name, isFactory), result, "Could not load preset");
+        return true;
+    }
+
+    if (event == juce::Identifier("renameUserPreset"))
+    {
+        auto oldName = data.getProperty("oldName", "").toString();
+        auto newName = data.getProperty("newName", "").toString().trim();
+        const bool renamed = newName.isNotEmpty() && presets.renameUserPreset(oldName, newName);
+
+        juce::DynamicObject::Ptr result = new juce::DynamicObject();
+        result->setProperty("oldName", oldName);
+        result->setProperty("newName", newName);
+        sendResult("renamePresetResult", renamed, result, "Could not rename preset");
+        if (renamed)
+            sendPresetListChanged();
+        return true;
+    }
+
+    if (event == juce::Identifier("deleteUserPreset"))
+    {
+        auto name = data.getProperty("name", "").toString();
+        const bool deleted = presets.deleteUserPreset(name);
+
+        juce::DynamicObject::Ptr result = new juce::DynamicObject();
+        result->setProperty("name", name);
+        sendResult("deletePresetResult", deleted, result, "Could not delete preset");
+        if (deleted)
+            sendPresetListChanged();
+        return true;
+    }
+
+    return false;
 }
 
 //==============================================================================
 // BeatConnect Activation
 //==============================================================================
 
-void {{PLUGIN_NAME}}Editor::setupActivationEvents()
+void {{PLUGIN_NAME}}Editor::handleWebEvent(const juce::Identifier& event, const juce::var& data)
 {
-#if BEATCONNECT_ACTIVATION_ENABLED
-    if (!webView)
+    if (handlePresetEvent(event, data))
+        return;
+
+    // Web UI asks for the current state once it has loaded; after that,
+    // changes are pushed by the state listener in setupActivationEvents()
+    if (event == juce::Identifier("getActivationStatus"))
+    {
+        sendActivationState(true);
         return;
+    }
+
+#if BEATCONNECT_ACTIVATION_ENABLED
+    // Activation request from web UI
+    if (event == juce::Identifier("activatePlugin"))
+    {
+        auto* activation = processorRef.getActivation();
+        if (activation == nullptr)
+            return;
 
-    // Listen for activation requests from web UI
-    webView->addListener("activatePlugin", [this](const juce::var& data) {
         auto code = data.getProperty("code", "").toString().toStdString();
 
-        beatconnect::Activation::getInstance().activateAsync(code,
+        activation->activateAsync(code,
             [safeThis = juce::Component::SafePointer(this)](beatconnect::ActivationStatus status) {
-                if (safeThis == nullptr)
-                    return;
-
                 juce::MessageManager::callAsync([safeThis, status]() {
                     if (safeThis == nullptr)
                         return;
@@ -243,48 +358,80 @@ void {{PLUGIN_NAME}}Editor::setupActivationEvents()
                     }
                     result->setProperty("status", statusStr);
 
-                    safeThis->webView->emitEventIfBrowserIsVisible("activationResult", juce::var(result.get()));
+                    safeThis->webView->getBrowser().emitEventIfBrowserIsVisible("activationResult", juce::var(result.get()));
                 });
             });
-    });
+        return;
+    }
 
-    // Listen for deactivation requests
-    webView->addListener("deactivatePlugin", [this](const juce::var&) {
-        auto status = beatconnect::Activation::getInstance().deactivate();
+    // Deactivation request
+    if (event == juce::Identifier("deactivatePlugin"))
+    {
+        auto* activation = processorRef.getActivation();
+        auto status = activation != nullptr ? activation->deactivate()
+                                            : beatconnect::ActivationStatus::NotConfigured;
 
         juce::DynamicObject::Ptr result = new juce::DynamicObject();
         result->setProperty("success", status == beatconnect::ActivationStatus::Valid);
-        webView->emitEventIfBrowserIsVisible("deactivationResult", juce::var(result.get()));
-    });
+        webView->getBrowser().emitEventIfBrowserIsVisible("deactivationResult", juce::var(result.get()));
+    }
 #endif
 }
 
-void {{PLUGIN_NAME}}Editor::sendActivationState()
+void {{PLUGIN_NAME}}Editor::setupActivationEvents()
+{
+#if BEATCONNECT_ACTIVATION_ENABLED
+    // Event-driven instead of polling: fires when this or any other instance
+    // of the plugin activates, deactivates, or is revalidated. The callback
+    // can arrive on any thread, so hop to the message thread first.
+    if (auto* activation = processorRef.getActivation())
+    {
+        activationListenerId = activation->addStateListener(
+            [safeThis = juce::Component::SafePointer(this)](bool, const std::optional<beatconnect::ActivationInfo>&) {
+                juce::MessageManager::callAsync([safeThis]() {
+                    if (safeThis != nullptr)
+                        safeThis->sendActivationState();
+                });
+            });
+    }
+#endif
+
+    sendActivationState();
+}
+
+void {{PLUGIN_NAME}}Editor::sendActivationState(bool force)
 {
     if (!webView)
         return;
 
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+
 #if BEATCONNECT_ACTIVATION_ENABLED
-    auto& activation = beatconnect::Activation::getInstance();
+    auto* activation = processorRef.getActivation();
 
-    juce::DynamicObject::Ptr data = new juce::DynamicObject();
-    data->setProperty("isActivated", activation.isActivated());
+    data->setProperty("isActivated", activation != nullptr && activation->isActivated());
     data->setProperty("requiresActivation", processorRef.hasActivationEnabled());
 
-    if (auto info = activation.getActivationInfo())
+    if (auto info = activation != nullptr ? activation->getActivationInfo() : std::nullopt)
     {
         data->setProperty("activationCode", juce::String(info->activationCode));
         data->setProperty("expiresAt", juce::String(info->expiresAt));
     }
-
-    webView->emitEventIfBrowserIsVisible("activationState", juce::var(data.get()));
 #else
     // No activation compiled in - always report as activated
-    juce::DynamicObject::Ptr data = new juce::DynamicObject();
     data->setProperty("isActivated", true);
     data->setProperty("requiresActivation", false);
-    webView->emitEventIfBrowserIsVisible("activationState", juce::var(data.get()));
 #endif
+
+    // Revalidation fires the state listener without changing anything; only
+    // send on change, unless the web UI asked (e.g. after a reload)
+    juce::var state(data.get());
+    auto json = juce::JSON::toString(state, true);
+    if (!force && json == lastActivationState)
+        return;
+
+    lastActivationState = json;
+    webView->getBrowser().emitEventIfBrowserIsVisible("activationState", state);
 }
 
 //==============================================================================
@@ -11,11 +11,12 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_extra/juce_gui_extra.h>
+#include <beatconnect/UpdateScheduler.h>
+#include <beatconnect/WebViewHost.h>
 #include "PluginProcessor.h"
 
 //==============================================================================
-class {{PLUGIN_NAME}}Editor : public juce::AudioProcessorEditor,
-                              private juce::Timer
+class {{PLUGIN_NAME}}Editor : public juce::AudioProcessorEditor
 {
 public:
     explicit {{PLUGIN_NAME}}Editor({{PLUGIN_NAME}}Processor&);
@@ -24,45 +25,40 @@ public:
     //==============================================================================
     void paint(juce::Graphics&) override;
     void resized() override;
-    void timerCallback() override;
 
 private:
     //==============================================================================
     {{PLUGIN_NAME}}Processor& processorRef;
 
     //==============================================================================
-    // WebView component
-    std::unique_ptr<juce::WebBrowserComponent> webView;
+    // Activation state listener (see setupActivationEvents)
+    int activationListenerId = 0;
 
-    // Resources directory for production builds
-    juce::File resourcesDir;
+    // Last activation state sent, so unchanged states aren't re-sent
+    juce::String lastActivationState;
 
     //==============================================================================
-    // JUCE 8 Parameter Relays
-    // These provide automatic bidirectional sync between web UI and APVTS.
-    // Create one relay per parameter, matching the identifier used in web code.
-
-    // Example relays (add your own parameters here):
-    std::unique_ptr<juce::WebSliderRelay> gainRelay;
-    std::unique_ptr<juce::WebSliderRelay> mixRelay;
-    std::unique_ptr<juce::WebToggleButtonRelay> bypassRelay;
-    // std::unique_ptr<juce::WebComboBoxRelay> modeRelay;
+    // WebView, lent by the plugin's WebViewHost: the browser with one relay
+    // per parameter in PLUGIN_PARAMETERS (ParameterIDs.h) and the visualizer
+    // transport. Handed back with its page still loaded when the editor
+    // closes, so the next one opens instantly. Declared after the state its
+    // event handler uses.
+    beatconnect::WebViewHost::Lease webView;
 
     //==============================================================================
-    // Parameter Attachments
-    // Connect relays to APVTS parameters for automatic value sync
-
-    std::unique_ptr<juce::WebSliderParameterAttachment> gainAttachment;
-    std::unique_ptr<juce::WebSliderParameterAttachment> mixAttachment;
-    std::unique_ptr<juce::WebToggleButtonParameterAttachment> bypassAttachment;
-    // std::unique_ptr<juce::WebComboBoxParameterAttachment> modeAttachment;
+    // Visualizer updates: 30 Hz while levels move, slower when static or hidden
+    beatconnect::UpdateScheduler scheduler { *this, [this] { return sendVisualizerData(); } };
 
     //==============================================================================
     void setupWebView();
     void setupRelaysAndAttachments();
+    void handleWebEvent(const juce::Identifier& event, const juce::var& data);
+    bool handlePresetEvent(const juce::Identifier& event, const juce::var& data);
+    void setupPresetEvents();
+    void sendPresetListChanged();
     void setupActivationEvents();
-    void sendVisualizerData();
-    void sendActivationState();
+    bool sendVisualizerData();
+    void sendActivationState(bool force = false);
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR({{PLUGIN_NAME}}Editor)
@@ -7,7 +7,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "ParameterIDs.h"
+#include <beatconnect/StateCodec.h>
 
 #if HAS_PROJECT_DATA
 #include "ProjectData.h"
@@ -25,7 +25,8 @@ static constexpr int kStateVersion = 1;
     : AudioProcessor(BusesProperties()
                      .withInput("Input", juce::AudioChannelSet::stereo(), true)
                      .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts(*this, nullptr, "Parameters", createParameterLayout())
+      apvts(*this, nullptr, "Parameters", beatconnect::createParameterLayout(kParameters)),
+      params(apvts, kParameters)
 {
     loadProjectData();
 }
@@ -34,45 +35,6 @@ static constexpr int kStateVersion = 1;
 {
 }
 
-//==============================================================================
-juce::AudioProcessorValueTreeState::ParameterLayout {{PLUGIN_NAME}}Processor::createParameterLayout()
-{
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    // ==============================================================================
-    // Define your parameters here
-    // ==============================================================================
-
-    // Example: Gain parameter
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::gain, 1 },
-        "Gain",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-        0.5f,
-        juce::AudioParameterFloatAttributes()
-            .withLabel("dB")
-    ));
-
-    // Example: Mix parameter
-    params.push_back(std::make_unique<juce::AudioParameterFloat>(
-        juce::ParameterID { ParamIDs::mix, 1 },
-        "Mix",
-        juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
-        1.0f,
-        juce::AudioParameterFloatAttributes()
-            .withLabel("%")
-    ));
-
-    // Example: Boolean toggle
-    params.push_back(std::make_unique<juce::AudioParameterBool>(
-        juce::ParameterID { ParamIDs::bypass, 1 },
-        "Bypass",
-        false
-    ));
-
-    return { params.begin(), params.end() };
-}
-
 //==============================================================================
 const juce::String {{PLUGIN_NAME}}Processor::getName() const
 {
@@ -137,6 +99,10 @@ void {{PLUGIN_NAME}}Processor::prepareToPlay(double sampleRate, int samplesPerBl
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
 
+    // 20ms parameter ramps, starting from the current values
+    gainMix.prepare(sampleRate, samplesPerBlock);
+    gainMix.reset(params.get(Param::gain), params.get(Param::mix));
+
     // Example:
     // gain.prepare(spec);
     // gain.setGainLinear(0.5f);
@@ -162,6 +128,8 @@ bool {{PLUGIN_NAME}}Processor::isBusesLayoutSupported(const BusesLayout& layouts
 void {{PLUGIN_NAME}}Processor::processBlock(juce::AudioBuffer<float>& buffer,
                                             juce::MidiBuffer& midiMessages)
 {
+    // Everything below runs under the real-time checks when they're enabled
+    BEATCONNECT_RT_SCOPE(rtMonitor, buffer.getNumSamples(), getSampleRate());
     juce::ignoreUnused(midiMessages);
     juce::ScopedNoDenormals noDenormals;
 
@@ -172,33 +140,43 @@ void {{PLUGIN_NAME}}Processor::processBlock(juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
+    // Input levels for the editor's meters
+    beatconnect::LevelFrame levels;
+    levels.numSamples = buffer.getNumSamples();
+    beatconnect::measureLevels(buffer.getArrayOfReadPointers(), totalNumInputChannels,
+                               buffer.getNumSamples(), levels.inputPeak, levels.inputRms);
+
     // ==============================================================================
-    // Get parameter values (atomic read - thread safe)
+    // Get parameter values (atomic read by index - no id lookup)
     // ==============================================================================
-    auto gainValue = apvts.getRawParameterValue(ParamIDs::gain)->load();
-    auto mixValue = apvts.getRawParameterValue(ParamIDs::mix)->load();
-    auto bypassValue = apvts.getRawParameterValue(ParamIDs::bypass)->load() > 0.5f;
+    auto gainValue = params.get(Param::gain);
+    auto mixValue = params.get(Param::mix);
+    auto bypassValue = params.getBool(Param::bypass);
 
     if (bypassValue)
+    {
+        // Jump to the current values so re-enabling doesn't ramp from stale ones
+        gainMix.reset(gainValue, mixValue);
+        levels.outputPeak = levels.inputPeak;
+        levels.outputRms = levels.inputRms;
+        levelTelemetry.push(levels);
         return;
+    }
 
     // ==============================================================================
     // Process audio here
     // ==============================================================================
 
-    // Example: Simple gain processing
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
-    {
-        auto* channelData = buffer.getWritePointer(channel);
+    // Example: smoothed gain with dry/wet mix. Parameters are smoothed once
+    // per block, not per sample, and applied with vector ops; see
+    // beatconnect/MixKernels.h for the kernels to build your own stages from.
+    gainMix.setTargets(gainValue, mixValue);
+    gainMix.process(buffer.getArrayOfWritePointers(), totalNumInputChannels, buffer.getNumSamples());
 
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
-        {
-            // Dry/wet mix with gain
-            float dry = channelData[sample];
-            float wet = dry * gainValue;
-            channelData[sample] = dry * (1.0f - mixValue) + wet * mixValue;
-        }
-    }
+    // Output levels, then hand the frame to the UI (never blocks)
+    beatconnect::measureLevels(buffer.getArrayOfReadPointers(), totalNumOutputChannels,
+                               buffer.getNumSamples(), levels.outputPeak, levels.outputRms);
+    levelTelemetry.push(levels);
 }
 
 //==============================================================================
@@ -215,34 +193,36 @@ juce::AudioProcessorEditor* {{PLUGIN_NAME}}Processor::createEditor()
 //==============================================================================
 void {{PLUGIN_NAME}}Processor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-
-    // Add state version for forwards compatibility
-    xml->setAttribute("stateVersion", kStateVersion);
-
-    copyXmlToBinary(*xml, destData);
+    // Binary parameter table plus any non-parameter state, tagged with kStateVersion
+    beatconnect::StateCodec::write(apvts, destData, kStateVersion);
 }
 
 void {{PLUGIN_NAME}}Processor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState != nullptr && xmlState->hasTagName(apvts.state.getType()))
-    {
-        // Check state version
-        int loadedVersion = xmlState->getIntAttribute("stateVersion", 0);
+    // Also reads state saved as XML by earlier builds
+    beatconnect::StateCodec::read(apvts, data, sizeInBytes,
+        [](juce::uint32 loadedVersion, beatconnect::StateValues& values)
+        {
+            // Upgrade state saved before breaking parameter changes. Values
+            // are plain (not normalised); parameters left out of values keep
+            // their defaults.
+            if (loadedVersion != (juce::uint32) kStateVersion)
+            {
+                DBG("State version mismatch (loaded: " + juce::String(loadedVersion) +
+                    ", current: " + juce::String(kStateVersion) + ")");
+                // e.g. values.rename("oldId", "newId"); values.remove("droppedId");
+                juce::ignoreUnused(values);
+            }
+        });
+}
 
-        apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+//==============================================================================
+PresetManager& {{PLUGIN_NAME}}Processor::getPresetManager()
+{
+    if (presetManager == nullptr)
+        presetManager = std::make_unique<PresetManager>(apvts, getName());
 
-        // Reset to defaults if state version mismatch (breaking parameter changes)
-        if (loadedVersion != kStateVersion)
-        {
-            DBG("State version mismatch (loaded: " + juce::String(loadedVersion) +
-                ", current: " + juce::String(kStateVersion) + ") - using defaults");
-            // Add any parameter resets needed here
-        }
-    }
+    return *presetManager;
 }
 
 //==============================================================================
@@ -9,7 +9,12 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include <beatconnect/Telemetry.h>
+#include <beatconnect/MixKernels.h>
+#include <beatconnect/RealtimeChecks.h>
 #include <memory>
+#include "ParameterIDs.h"
+#include "PresetManager.h"
 
 #if BEATCONNECT_ACTIVATION_ENABLED
 namespace beatconnect { class Activation; }
@@ -59,6 +64,18 @@ public:
     // Parameter Access
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
 
+    //==============================================================================
+    // Presets (message thread). Created on first use, by the editor, so the
+    // preset index and its watcher thread only run once a UI needs them.
+    PresetManager& getPresetManager();
+
+    //==============================================================================
+    // Audio-to-UI telemetry
+    // One LevelFrame per block from the audio thread, drained by the editor.
+    // Lock-free and allocation-free; frames are dropped when no editor drains.
+    using LevelTelemetry = beatconnect::TelemetryChannel<beatconnect::LevelFrame>;
+    LevelTelemetry& getLevelTelemetry() { return levelTelemetry; }
+
     //==============================================================================
     // BeatConnect Integration
     bool hasActivationEnabled() const;
@@ -79,7 +96,13 @@ private:
     //==============================================================================
     // Parameters
     juce::AudioProcessorValueTreeState apvts;
-    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+
+    // Every parameter's value, looked up once; read by Param in processBlock.
+    // Declared after apvts, which it's built from.
+    ParameterTable params;
+
+    // See getPresetManager(); declared after apvts, which it recalls into
+    std::unique_ptr<PresetManager> presetManager;
 
     //==============================================================================
     // BeatConnect project data (loaded from embedded project_data.json)
@@ -94,8 +117,20 @@ private:
     std::unique_ptr<beatconnect::Activation> activation_;
 #endif
 
+    //==============================================================================
+    // Telemetry - add a channel per kind of frame (scope, spectrum, ...)
+    LevelTelemetry levelTelemetry;
+
+    // Real-time safety checks for processBlock (QA builds with
+    // -DBEATCONNECT_RT_CHECKS=ON): allocations, locks, system calls and
+    // block time against the buffer deadline, logged with backtraces
+    beatconnect::RealtimeMonitor rtMonitor;
+
     //==============================================================================
     // DSP - Add your processing members here
+    // Smoothed gain + dry/wet, a few vector ops per block
+    beatconnect::GainMix gainMix;
+
     // Example:
     // juce::dsp::Gain<float> gain;
 
@@ -9,17 +9,144 @@
 
 #include "PresetManager.h"
 
+#include <algorithm>
+#include <map>
+
+namespace
+{
+    // How often the watcher checks the presets folder, and how often it
+    // rescans regardless (edits in place don't touch the folder's timestamp)
+    constexpr int watchIntervalMs = 2000;
+    constexpr int fullRescanIntervalMs = 30000;
+
+    constexpr int indexCacheVersion = 1;
+
+    bool lessByName(const PresetManager::UserPreset& a, const PresetManager::UserPreset& b)
+    {
+        return a.name.compareNatural(b.name) < 0;
+    }
+
+    bool sameEntry(const PresetManager::UserPreset& a, const PresetManager::UserPreset& b)
+    {
+        return a.name == b.name && a.modified == b.modified && a.size == b.size
+            && a.tags == b.tags && a.category == b.category;
+    }
+}
+
+//==============================================================================
+/*
+    The user preset index for one presets folder, with the thread that builds
+    and watches it. Shared by every PresetManager in the process that uses the
+    folder (one per plugin instance), so a session with many instances still
+    scans and polls the folder once.
+*/
+class PresetManager::Index : private juce::Thread
+{
+public:
+    Index(const juce::File& presetsDir, const juce::File& cacheFile)
+        : juce::Thread("PresetIndex"), userPresetsDir(presetsDir), indexCacheFile(cacheFile)
+    {
+        startThread(juce::Thread::Priority::background);
+    }
+
+    ~Index() override
+    {
+        stopThread(4000);
+
+        if (cacheDirty.exchange(false))
+            saveIndexCache();
+    }
+
+    static std::shared_ptr<Index> getShared(const juce::File& presetsDir, const juce::File& cacheFile)
+    {
+        static juce::CriticalSection registryLock;
+        static std::map<juce::String, std::weak_ptr<Index>> registry;
+
+        const juce::ScopedLock lock(registryLock);
+        auto& entry = registry[presetsDir.getFullPathName()];
+
+        if (auto existing = entry.lock())
+            return existing;
+
+        auto created = std::make_shared<Index>(presetsDir, cacheFile);
+        entry = created;
+        return created;
+    }
+
+    bool isReady() const { return ready.load(); }
+
+    void addListener(PresetManager* manager)
+    {
+        const juce::ScopedLock lock(listenerLock);
+        listeners.addIfNotAlreadyThere(manager);
+    }
+
+    void removeListener(PresetManager* manager)
+    {
+        const juce::ScopedLock lock(listenerLock);
+        listeners.removeFirstMatchingValue(manager);
+    }
+
+    void updateEntry(const juce::String& name, const juce::File& file, PresetManager* source);
+    void removeEntry(const juce::String& name, PresetManager* source);
+
+    // Sorted by name; read under presetLock
+    juce::CriticalSection presetLock;
+    std::vector<UserPreset> userPresets;
+
+private:
+    const juce::File userPresetsDir;
+    const juce::File indexCacheFile;
+
+    juce::uint32 indexGeneration = 0;      // Bumped by every change to userPresets, under presetLock
+    std::atomic<bool> ready { false };
+    std::atomic<bool> cacheDirty { false };
+
+    juce::CriticalSection listenerLock;
+    juce::Array<PresetManager*> listeners;
+
+    void run() override;
+
+    /** Tells every manager but source that the list changed. */
+    void notifyListeners(PresetManager* source = nullptr);
+
+    bool rescanUserPresets();
+    void loadIndexCache();
+    void saveIndexCache();
+    static UserPreset readUserPreset(const juce::File& file);
+};
+
 //==============================================================================
 PresetManager::PresetManager(juce::AudioProcessorValueTreeState& state,
-                             const juce::String& name)
+                             const juce::String& name,
+                             const juce::File& dataDirectory)
     : apvts(state), pluginName(name)
 {
     // Set up user presets directory
-    userPresetsDir = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
-        .getChildFile(pluginName)
-        .getChildFile("UserPresets");
+    auto appDataDir = dataDirectory != juce::File()
+        ? dataDirectory
+        : juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile(pluginName);
+    userPresetsDir = appDataDir.getChildFile("UserPresets");
+
+    // Outside UserPresets so it isn't synced or mistaken for a preset
+    indexCacheFile = appDataDir.getChildFile("UserPresetIndex.json");
 
     ensureUserPresetsDirExists();
+
+    // id -> parameter, once, instead of a string search per parameter per recall
+    for (auto* param : apvts.processor.getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(param))
+            parameterIndex.set(ranged->getParameterID(), ranged);
+
+    // Built off the message thread, once per presets folder
+    presetIndex = Index::getShared(userPresetsDir, indexCacheFile);
+    presetIndex->addListener(this);
+}
+
+PresetManager::~PresetManager()
+{
+    presetIndex->removeListener(this);
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -70,22 +197,61 @@ juce::StringArray PresetManager::getUserPresetNames() const
 {
     juce::StringArray names;
 
-    auto files = userPresetsDir.findChildFiles(
-        juce::File::findFiles, false, "*.xml");
+    const juce::ScopedLock lock(presetIndex->presetLock);
+    for (const auto& preset : presetIndex->userPresets)
+        names.add(preset.name);
 
-    // Sort alphabetically
-    files.sort();
+    return names;
+}
 
-    for (const auto& file : files)
+std::vector<PresetManager::UserPreset> PresetManager::findUserPresets(const juce::String& query,
+                                                                      const juce::String& category) const
+{
+    auto matches = [&query, &category](const UserPreset& preset)
     {
-        names.add(file.getFileNameWithoutExtension());
+        if (category.isNotEmpty() && !preset.category.equalsIgnoreCase(category))
+            return false;
+
+        if (query.isEmpty() || preset.name.containsIgnoreCase(query)
+            || preset.category.containsIgnoreCase(query))
+            return true;
+
+        for (const auto& tag : preset.tags)
+            if (tag.containsIgnoreCase(query))
+                return true;
+
+        return false;
+    };
+
+    std::vector<UserPreset> result;
+
+    const juce::ScopedLock lock(presetIndex->presetLock);
+    for (const auto& preset : presetIndex->userPresets)
+        if (matches(preset))
+            result.push_back(preset);
+
+    return result;
+}
+
+juce::StringArray PresetManager::getUserPresetCategories() const
+{
+    juce::StringArray categories;
+
+    {
+        const juce::ScopedLock lock(presetIndex->presetLock);
+        for (const auto& preset : presetIndex->userPresets)
+            if (preset.category.isNotEmpty())
+                categories.addIfNotAlreadyThere(preset.category, true);
     }
 
-    return names;
+    categories.sortNatural();
+    return categories;
 }
 
 //==============================================================================
-bool PresetManager::saveUserPreset(const juce::String& name)
+bool PresetManager::saveUserPreset(const juce::String& name,
+                                   const juce::StringArray& tags,
+                                   const juce::String& category)
 {
     if (name.isEmpty())
         return false;
@@ -103,9 +269,18 @@ bool PresetManager::saveUserPreset(const juce::String& name)
     xml->setAttribute("presetName", name);
     xml->setAttribute("presetVersion", 1);
 
+    if (!tags.isEmpty())
+        xml->setAttribute("presetTags", tags.joinIntoString(","));
+    if (category.isNotEmpty())
+        xml->setAttribute("presetCategory", category);
+
     // Save to file
     auto file = getPresetFile(name);
-    return xml->writeTo(file);
+    if (!xml->writeTo(file))
+        return false;
+
+    presetIndex->updateEntry(file.getFileNameWithoutExtension(), file, this);
+    return true;
 }
 
 bool PresetManager::loadPreset(const juce::String& name, bool isFactory)
@@ -134,37 +309,62 @@ bool PresetManager::loadPreset(const juce::String& name, bool isFactory)
     if (!xml)
         return false;
 
-    auto state = juce::ValueTree::fromXml(*xml);
-    if (!state.isValid())
-        return false;
+    applyParameterState(*xml);
+
+    if (onPresetLoaded)
+        onPresetLoaded(name, false);
+
+    return true;
+}
 
-    // Set parameters one by one from saved state
-    // Skip the "preset" parameter to prevent factory preset being re-applied
-    for (int i = 0; i < state.getNumChildren(); ++i)
+void PresetManager::applyParameterState(const juce::XmlElement& state)
+{
+    struct Change
     {
-        auto child = state.getChild(i);
-        if (child.hasType("PARAM"))
-        {
-            auto paramId = child.getProperty("id").toString();
+        juce::RangedAudioParameter* param;
+        float value;
+    };
 
-            // Skip the preset selector - we don't want to trigger factory presets
-            if (paramId == "preset")
-                continue;
+    // Work out everything that changes before touching any parameter
+    std::vector<Change> changes;
+    changes.reserve((size_t)parameterIndex.size());
 
-            if (auto* param = apvts.getParameter(paramId))
-            {
-                // Values in APVTS state are stored as normalized (0-1)
-                float normalizedValue = (float)child.getProperty("value");
+    for (auto* child : state.getChildWithTagNameIterator("PARAM"))
+    {
+        auto paramId = child->getStringAttribute("id");
 
-                // Clamp to valid range to prevent any invalid values
-                normalizedValue = juce::jlimit(0.0f, 1.0f, normalizedValue);
+        // Skip the preset selector - we don't want to trigger factory presets
+        if (paramId == "preset")
+            continue;
 
-                param->setValueNotifyingHost(normalizedValue);
-            }
-        }
+        auto* param = parameterIndex[paramId];
+        if (param == nullptr)
+            continue;
+
+        // APVTS state holds plain (denormalised) values; clamp in case the
+        // preset came from a version with different ranges
+        auto normalisedValue = juce::jlimit(0.0f, 1.0f,
+            param->convertTo0to1((float)child->getDoubleAttribute("value")));
+
+        if (normalisedValue != param->getValue())
+            changes.push_back({ param, normalisedValue });
     }
 
-    return true;
+    if (changes.empty())
+        return;
+
+    // One gesture around the whole recall, so hosts record it as a single
+    // edit, and the audio thread can hold off until every value is in
+    recallSequence.fetch_add(1, std::memory_order_acq_rel);
+
+    for (const auto& change : changes)
+        change.param->beginChangeGesture();
+    for (const auto& change : changes)
+        change.param->setValueNotifyingHost(change.value);
+    for (const auto& change : changes)
+        change.param->endChangeGesture();
+
+    recallSequence.fetch_add(1, std::memory_order_acq_rel);
 }
 
 juce::ValueTree PresetManager::loadUserPresetState(const juce::String& name)
@@ -211,6 +411,9 @@ bool PresetManager::renameUserPreset(const juce::String& oldName, const juce::St
 
     // Delete old file
     oldFile.deleteFile();
+
+    presetIndex->removeEntry(oldFile.getFileNameWithoutExtension(), this);
+    presetIndex->updateEntry(newFile.getFileNameWithoutExtension(), newFile, this);
     return true;
 }
 
@@ -223,11 +426,16 @@ bool PresetManager::deleteUserPreset(const juce::String& name)
     if (!file.existsAsFile())
         return false;
 
-    return file.deleteFile();
+    if (!file.deleteFile())
+        return false;
+
+    presetIndex->removeEntry(file.getFileNameWithoutExtension(), this);
+    return true;
 }
 
 //==============================================================================
-juce::String PresetManager::getPresetListAsJson() const
+juce::String PresetManager::getPresetListAsJson(int offset, int limit,
+                                                const juce::String& query) const
 {
     juce::DynamicObject::Ptr root = new juce::DynamicObject();
 
@@ -242,16 +450,270 @@ juce::String PresetManager::getPresetListAsJson() const
     }
     root->setProperty("factory", factoryArray);
 
-    // User presets array
+    // User presets array - one page, served from the index
+    auto presets = findUserPresets(query);
+    const int total = (int)presets.size();
+    const int start = juce::jlimit(0, total, offset);
+    const int end = limit < 0 ? total : juce::jmin(total, start + limit);
+
     juce::Array<juce::var> userArray;
-    for (const auto& name : getUserPresetNames())
+    for (int i = start; i < end; ++i)
     {
+        const auto& info = presets[(size_t)i];
+
+        juce::Array<juce::var> tags;
+        for (const auto& tag : info.tags)
+            tags.add(tag);
+
         juce::DynamicObject::Ptr preset = new juce::DynamicObject();
-        preset->setProperty("name", name);
+        preset->setProperty("name", info.name);
         preset->setProperty("isFactory", false);
+        preset->setProperty("category", info.category);
+        preset->setProperty("tags", tags);
+        preset->setProperty("modified", info.modified);
         userArray.add(juce::var(preset.get()));
     }
     root->setProperty("user", userArray);
+    root->setProperty("userOffset", start);
+    root->setProperty("userTotal", total);
+    root->setProperty("isIndexReady", isIndexReady());
 
     return juce::JSON::toString(juce::var(root.get()));
 }
+
+//==============================================================================
+// Preset Index
+//==============================================================================
+
+bool PresetManager::isIndexReady() const
+{
+    return presetIndex->isReady();
+}
+
+void PresetManager::handleAsyncUpdate()
+{
+    if (onUserPresetsChanged)
+        onUserPresetsChanged();
+}
+
+void PresetManager::Index::run()
+{
+    // Last session's index first, so the list is available before the scan
+    loadIndexCache();
+    rescanUserPresets();
+    ready = true;
+    notifyListeners();
+
+    auto lastDirectoryChange = userPresetsDir.getLastModificationTime();
+    auto lastFullRescan = juce::Time::getMillisecondCounter();
+
+    while (!threadShouldExit())
+    {
+        if (cacheDirty.exchange(false))
+            saveIndexCache();
+
+        wait(watchIntervalMs);
+        if (threadShouldExit())
+            break;
+
+        // Adding, removing or renaming a file touches the folder; edits in
+        // place (a sync client replacing a file) only show up in a full rescan
+        auto directoryChange = userPresetsDir.getLastModificationTime();
+        auto now = juce::Time::getMillisecondCounter();
+
+        if (directoryChange != lastDirectoryChange || now - lastFullRescan >= (juce::uint32)fullRescanIntervalMs)
+        {
+            lastDirectoryChange = directoryChange;
+            lastFullRescan = now;
+
+            if (rescanUserPresets())
+                notifyListeners();
+        }
+    }
+}
+
+void PresetManager::Index::notifyListeners(PresetManager* source)
+{
+    const juce::ScopedLock lock(listenerLock);
+    for (auto* manager : listeners)
+        if (manager != source)
+            manager->triggerAsyncUpdate();
+}
+
+bool PresetManager::Index::rescanUserPresets()
+{
+    std::vector<UserPreset> previous;
+    juce::uint32 generation;
+    {
+        const juce::ScopedLock lock(presetLock);
+        previous = userPresets;
+        generation = indexGeneration;
+    }
+
+    std::map<juce::String, const UserPreset*> known;
+    for (const auto& preset : previous)
+        known[preset.file.getFileName()] = &preset;
+
+    // Only files that are new or changed since the index was built are parsed
+    std::vector<UserPreset> scanned;
+    for (const auto& entry : juce::RangedDirectoryIterator(userPresetsDir, false, "*.xml", juce::File::findFiles))
+    {
+        if (threadShouldExit())
+            return false;
+
+        const auto& file = entry.getFile();
+        const auto modified = entry.getModificationTime().toMilliseconds();
+        const auto size = entry.getFileSize();
+
+        auto it = known.find(file.getFileName());
+        if (it != known.end() && it->second->modified == modified && it->second->size == size)
+            scanned.push_back(*it->second);
+        else
+            scanned.push_back(readUserPreset(file));
+    }
+
+    std::sort(scanned.begin(), scanned.end(), lessByName);
+
+    if (std::equal(scanned.begin(), scanned.end(), previous.begin(), previous.end(), sameEntry))
+        return false;
+
+    {
+        const juce::ScopedLock lock(presetLock);
+
+        // A save/rename/delete landed mid-scan; the watcher will see its
+        // change to the folder and rescan
+        if (indexGeneration != generation)
+            return false;
+
+        userPresets = std::move(scanned);
+        ++indexGeneration;
+    }
+
+    cacheDirty = true;
+    return true;
+}
+
+PresetManager::UserPreset PresetManager::Index::readUserPreset(const juce::File& file)
+{
+    UserPreset preset;
+    preset.name = file.getFileNameWithoutExtension();
+    preset.file = file;
+    preset.modified = file.getLastModificationTime().toMilliseconds();
+    preset.size = file.getSize();
+
+    // Only the outer element is parsed - metadata lives in its attributes
+    juce::XmlDocument document(file);
+    if (auto xml = document.getDocumentElement(true))
+    {
+        preset.tags.addTokens(xml->getStringAttribute("presetTags"), ",", "");
+        preset.tags.trim();
+        preset.tags.removeEmptyStrings();
+        preset.category = xml->getStringAttribute("presetCategory");
+    }
+
+    return preset;
+}
+
+void PresetManager::Index::updateEntry(const juce::String& name, const juce::File& file,
+                                       PresetManager* source)
+{
+    auto preset = readUserPreset(file);
+
+    {
+        const juce::ScopedLock lock(presetLock);
+
+        auto it = std::lower_bound(userPresets.begin(), userPresets.end(), preset, lessByName);
+        if (it != userPresets.end() && it->name == name)
+            *it = std::move(preset);
+        else
+            userPresets.insert(it, std::move(preset));
+
+        ++indexGeneration;
+    }
+
+    cacheDirty = true;
+    notify();
+    notifyListeners(source);
+}
+
+void PresetManager::Index::removeEntry(const juce::String& name, PresetManager* source)
+{
+    {
+        const juce::ScopedLock lock(presetLock);
+
+        userPresets.erase(std::remove_if(userPresets.begin(), userPresets.end(),
+                                         [&name](const UserPreset& p) { return p.name == name; }),
+                          userPresets.end());
+        ++indexGeneration;
+    }
+
+    cacheDirty = true;
+    notify();
+    notifyListeners(source);
+}
+
+void PresetManager::Index::loadIndexCache()
+{
+    auto json = juce::JSON::parse(indexCacheFile);
+    if ((int)json.getProperty("version", 0) != indexCacheVersion)
+        return;
+
+    std::vector<UserPreset> presets;
+    if (auto* entries = json.getProperty("presets", {}).getArray())
+    {
+        for (const auto& entry : *entries)
+        {
+            UserPreset preset;
+            preset.name = entry.getProperty("name", {}).toString();
+            preset.file = userPresetsDir.getChildFile(entry.getProperty("file", {}).toString());
+            preset.modified = (juce::int64)entry.getProperty("modified", 0);
+            preset.size = (juce::int64)entry.getProperty("size", 0);
+            preset.category = entry.getProperty("category", {}).toString();
+
+            if (auto* tags = entry.getProperty("tags", {}).getArray())
+                for (const auto& tag : *tags)
+                    preset.tags.add(tag.toString());
+
+            if (preset.name.isNotEmpty())
+                presets.push_back(std::move(preset));
+        }
+    }
+
+    std::sort(presets.begin(), presets.end(), lessByName);
+
+    const juce::ScopedLock lock(presetLock);
+    userPresets = std::move(presets);
+    ++indexGeneration;
+}
+
+void PresetManager::Index::saveIndexCache()
+{
+    juce::Array<juce::var> entries;
+    {
+        const juce::ScopedLock lock(presetLock);
+        for (const auto& preset : userPresets)
+        {
+            juce::Array<juce::var> tags;
+            for (const auto& tag : preset.tags)
+                tags.add(tag);
+
+            juce::DynamicObject::Ptr entry = new juce::DynamicObject();
+            entry->setProperty("name", preset.name);
+            entry->setProperty("file", preset.file.getFileName());
+            entry->setProperty("modified", preset.modified);
+            entry->setProperty("size", preset.size);
+            entry->setProperty("category", preset.category);
+            entry->setProperty("tags", tags);
+            entries.add(juce::var(entry.get()));
+        }
+    }
+
+    juce::DynamicObject::Ptr root = new juce::DynamicObject();
+    root->setProperty("version", indexCacheVersion);
+    root->setProperty("presets", entries);
+
+    // Written via a temporary file so a crash can't leave half an index
+    juce::TemporaryFile temp(indexCacheFile);
+    if (temp.getFile().replaceWithText(juce::JSON::toString(juce::var(root.get()), true)))
+        temp.overwriteTargetFileWithTemporary();
+}
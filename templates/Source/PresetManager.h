@@ -4,18 +4,42 @@
 
     Handles saving, loading, renaming, and deleting user presets.
     User presets are stored as XML files in the app data directory.
+
+    Recalling a preset applies every changed parameter in one pass (see
+    applyParameterState()) rather than one host notification per parameter
+    per preset entry.
+
+    User presets are served from an in-memory index (name, file, modification
+    time, tags, category) rather than scanning the directory on every call.
+    The index is built on a background thread, persisted next to the presets
+    folder so the next session starts from it, kept current by save / rename /
+    delete, and by a watcher that picks up files added or changed elsewhere
+    (a cloud sync client, another process). Every PresetManager for the same
+    presets folder in the process shares one index and one watcher thread,
+    released with the last of them.
   ==============================================================================
 */
 
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
 
-class PresetManager
+class PresetManager : private juce::AsyncUpdater
 {
 public:
+    /**
+     * User presets live in dataDirectory/UserPresets, with the index cache
+     * beside that folder. dataDirectory defaults to the user's application
+     * data folder for pluginName.
+     */
     PresetManager(juce::AudioProcessorValueTreeState& apvts,
-                  const juce::String& pluginName);
+                  const juce::String& pluginName,
+                  const juce::File& dataDirectory = {});
+    ~PresetManager() override;
 
     //==============================================================================
     // Factory Presets (read-only, defined in code)
@@ -24,16 +48,76 @@ public:
 
     //==============================================================================
     // User Presets
+    struct UserPreset
+    {
+        juce::String name;
+        juce::File file;
+        juce::int64 modified = 0;  // ms since epoch
+        juce::int64 size = 0;
+        juce::StringArray tags;
+        juce::String category;
+    };
+
     juce::StringArray getUserPresetNames() const;
-    bool saveUserPreset(const juce::String& name);
+    bool saveUserPreset(const juce::String& name,
+                        const juce::StringArray& tags = {},
+                        const juce::String& category = {});
     bool loadPreset(const juce::String& name, bool isFactory);
     juce::ValueTree loadUserPresetState(const juce::String& name);
+
+    /**
+     * Bulk recall of APVTS state (PARAM children). Only parameters whose
+     * value changes are touched, all inside one begin/end change gesture.
+     */
+    void applyParameterState(const juce::XmlElement& state);
+
+    /**
+     * Audio thread: lets processBlock() read parameters as one consistent
+     * snapshot rather than half of one preset and half of another. Odd while
+     * a recall is being applied, and bumped twice per recall:
+     *
+     *   auto seq = presetManager.getRecallSequence();
+     *   if ((seq & 1) == 0)
+     *   {
+     *       auto gain = gainParam->load(), mix = mixParam->load();
+     *       if (presetManager.getRecallSequence() == seq)
+     *           gainMix.setTargets(gain, mix);  // else keep last block's
+     *   }
+     *
+     * Block smoothing then ramps to the new preset instead of jumping.
+     */
+    juce::uint32 getRecallSequence() const { return recallSequence.load(std::memory_order_acquire); }
+    bool isRecalling() const { return (getRecallSequence() & 1) != 0; }
+
+    /**
+     * Called on the message thread after a user preset has been recalled,
+     * once per recall - the place to send one "presetLoaded" update to the UI.
+     */
+    std::function<void(const juce::String& name, bool isFactory)> onPresetLoaded;
     bool renameUserPreset(const juce::String& oldName, const juce::String& newName);
     bool deleteUserPreset(const juce::String& name);
 
+    /** Presets whose name, tags or category contain query (any case), sorted by name. */
+    std::vector<UserPreset> findUserPresets(const juce::String& query = {},
+                                            const juce::String& category = {}) const;
+    juce::StringArray getUserPresetCategories() const;
+
+    /** False until the first scan has finished; until then the list comes from the cache. */
+    bool isIndexReady() const;
+
+    /**
+     * Called on the message thread when the user preset list changes for a
+     * reason other than this object's own save/rename/delete (first scan,
+     * files changed on disk, another instance saving a preset). Typically
+     * re-sends the list to the web UI.
+     */
+    std::function<void()> onUserPresetsChanged;
+
     //==============================================================================
     // JSON for UI communication
-    juce::String getPresetListAsJson() const;
+    // User presets are paged: limit < 0 returns all of them from offset.
+    juce::String getPresetListAsJson(int offset = 0, int limit = -1,
+                                     const juce::String& query = {}) const;
 
     //==============================================================================
     // Directory management
@@ -43,11 +127,23 @@ private:
     juce::AudioProcessorValueTreeState& apvts;
     juce::String pluginName;
     juce::File userPresetsDir;
+    juce::File indexCacheFile;
     juce::StringArray factoryPresetNames;
 
+    // Parameter lookup for recall, built once
+    juce::HashMap<juce::String, juce::RangedAudioParameter*> parameterIndex;
+    std::atomic<juce::uint32> recallSequence { 0 };
+
     void ensureUserPresetsDirExists();
     juce::File getPresetFile(const juce::String& name) const;
     juce::String sanitizeFileName(const juce::String& name) const;
 
+    //==============================================================================
+    // Index, shared by every instance using the same presets folder
+    class Index;
+    std::shared_ptr<Index> presetIndex;
+
+    void handleAsyncUpdate() override;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetManager)
 };
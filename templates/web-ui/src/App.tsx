@@ -9,7 +9,7 @@
  * 2. C++ relay creation (e.g., WebSliderRelay("gain"))
  */
 
-import { useSliderParam, useToggleParam, useVisualizerData } from './hooks/useJuceParam';
+import { useSliderParam, useToggleParam, useVisualizerStream } from './hooks/useJuceParam';
 import { isInJuceWebView } from './lib/juce-bridge';
 
 // ==============================================================================
@@ -23,13 +23,15 @@ const ParamIDs = {
 } as const;
 
 // ==============================================================================
-// Visualizer Data Type (matches C++ sendVisualizerData())
+// Visualizer Stream Layout (matches C++ sendVisualizerData())
 // ==============================================================================
-interface VisualizerData {
-  inputLevel?: number;
-  outputLevel?: number;
-  isPlaying?: boolean;
-}
+// "levels" frames: peaks since the last update and RMS, 0..1
+const LevelIndex = {
+  inputPeak: 0,
+  outputPeak: 1,
+  inputRms: 2,
+  outputRms: 3,
+} as const;
 
 // ==============================================================================
 // Main App Component
@@ -43,8 +45,8 @@ function App() {
   // Example: ComboBox parameter
   // const mode = useComboParam(ParamIDs.mode, { defaultIndex: 0 });
 
-  // Visualizer data from C++ (30 Hz updates)
-  const vizData = useVisualizerData<VisualizerData>('visualizerData', {});
+  // Level meters from C++ (up to 30 Hz, only when levels change)
+  const levels = useVisualizerStream('levels');
 
   // Connection status indicator
   const isConnected = isInJuceWebView();
@@ -131,12 +133,12 @@ function App() {
       </main>
 
       {/* Visualizer Section (optional) */}
-      {vizData.inputLevel !== undefined && (
+      {levels.data.length > 0 && (
         <section className="visualizer">
           <div className="meter">
             <div
               className="meter-fill"
-              style={{ width: `${(vizData.inputLevel ?? 0) * 100}%` }}
+              style={{ width: `${levels.data[LevelIndex.inputPeak] * 100}%` }}
             />
           </div>
         </section>
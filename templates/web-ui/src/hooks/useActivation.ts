@@ -0,0 +1,126 @@
+/**
+ * React Hook for BeatConnect Activation
+ *
+ * Mirrors the editor's activation state (PluginEditor::sendActivationState())
+ * and sends activation / deactivation requests to C++.
+ *
+ * C++ pushes 'activationState' whenever this or another instance activates,
+ * deactivates or is revalidated. The hook asks for it once on mount, and
+ * again when the page is reused by another editor, whose instance may not
+ * be in the same state.
+ */
+
+import { useState, useEffect, useCallback } from 'react';
+import { isInJuceWebView, addCustomEventListener, addEditorAttachedListener } from '../lib/juce-bridge';
+
+/** Payload of the 'activationState' event. */
+export interface ActivationState {
+  isActivated: boolean;
+  requiresActivation: boolean;
+  activationCode?: string;
+  expiresAt?: string;
+}
+
+interface State extends ActivationState {
+  isLoading: boolean;
+  isActivating: boolean;
+  error?: string;
+}
+
+/**
+ * Hook for the plugin's activation state
+ */
+export function useActivation() {
+  const [state, setState] = useState<State>({
+    isActivated: false,
+    requiresActivation: true,
+    isLoading: true,
+    isActivating: false,
+  });
+
+  useEffect(() => {
+    if (!isInJuceWebView()) {
+      // Development mode - behave as activated
+      console.log('[Activation] Development mode - skipping activation');
+      setState(s => ({ ...s, isActivated: true, requiresActivation: false, isLoading: false }));
+      return;
+    }
+
+    const requestState = () => {
+      window.__JUCE__!.backend.emitEvent('getActivationStatus', {});
+    };
+
+    const unsubState = addCustomEventListener('activationState', (data: unknown) => {
+      const activation = data as ActivationState;
+      setState(s => ({ ...s, ...activation, isLoading: false }));
+    });
+
+    const unsubResult = addCustomEventListener('activationResult', (data: unknown) => {
+      const result = data as { success: boolean; status?: string };
+      console.log('[Activation] activationResult:', result);
+
+      // The new state itself arrives as 'activationState'
+      setState(s => ({
+        ...s,
+        isActivating: false,
+        error: result.success ? undefined : result.status || 'Activation failed',
+      }));
+    });
+
+    const unsubDeactivate = addCustomEventListener('deactivationResult', (data: unknown) => {
+      const result = data as { success: boolean };
+      if (!result.success) {
+        setState(s => ({ ...s, error: 'Failed to deactivate' }));
+      }
+    });
+
+    // Page reused by another editor: its instance's state, not the last one's
+    const unsubAttached = addEditorAttachedListener(requestState);
+
+    requestState();
+
+    return () => {
+      unsubState();
+      unsubResult();
+      unsubDeactivate();
+      unsubAttached();
+    };
+  }, []);
+
+  const activate = useCallback((code: string) => {
+    if (!code.trim()) {
+      setState(s => ({ ...s, error: 'Activation code cannot be empty' }));
+      return;
+    }
+
+    if (!isInJuceWebView()) return;
+
+    setState(s => ({ ...s, isActivating: true, error: undefined }));
+    window.__JUCE__!.backend.emitEvent('activatePlugin', { code: code.trim() });
+  }, []);
+
+  const deactivate = useCallback(() => {
+    if (!isInJuceWebView()) return;
+    window.__JUCE__!.backend.emitEvent('deactivatePlugin', {});
+  }, []);
+
+  const clearError = useCallback(() => {
+    setState(s => ({ ...s, error: undefined }));
+  }, []);
+
+  return {
+    // State
+    isActivated: state.isActivated,
+    requiresActivation: state.requiresActivation,
+    activationCode: state.activationCode,
+    expiresAt: state.expiresAt,
+    isLoading: state.isLoading,
+    isActivating: state.isActivating,
+    error: state.error,
+
+    // Actions
+    activate,
+    deactivate,
+    clearError,
+  };
+}
@@ -12,6 +12,8 @@ import {
   getToggleState,
   getComboBoxState,
   addCustomEventListener,
+  addEditorAttachedListener,
+  addVisualizerStreamListener,
   isInJuceWebView,
 } from '../lib/juce-bridge';
 
@@ -77,8 +79,14 @@ export function useSliderParam(
       setValueState(state.getNormalisedValue());
     });
 
+    // Page reused by another editor: re-read what its relay now holds
+    const unsubAttached = addEditorAttachedListener(() => {
+      setValueState(state.getNormalisedValue());
+    });
+
     return () => {
       state.valueChangedEvent.removeListener(listenerId);
+      unsubAttached();
     };
   }, [isConnected]);
 
@@ -150,8 +158,13 @@ export function useToggleParam(
       setValueState(state.getValue());
     });
 
+    const unsubAttached = addEditorAttachedListener(() => {
+      setValueState(state.getValue());
+    });
+
     return () => {
       state.valueChangedEvent.removeListener(listenerId);
+      unsubAttached();
     };
   }, [isConnected]);
 
@@ -228,9 +241,15 @@ export function useComboParam(
       setChoices(state.getChoices());
     });
 
+    const unsubAttached = addEditorAttachedListener(() => {
+      setIndexState(state.getChoiceIndex());
+      setChoices(state.getChoices());
+    });
+
     return () => {
       state.valueChangedEvent.removeListener(valueListener);
       state.propertiesChangedEvent.removeListener(propsListener);
+      unsubAttached();
     };
   }, [isConnected]);
 
@@ -269,3 +288,43 @@ export function useVisualizerData<T>(eventId: string, initialValue: T): T {
 
   return data;
 }
+
+// ==============================================================================
+// useVisualizerStream - Packed Float Frames from C++
+// ==============================================================================
+
+interface VisualizerStreamReturn {
+  /** Latest frame (reused between frames - copy it to keep old values) */
+  data: Float32Array;
+  /** Increments with every frame received */
+  sequence: number;
+}
+
+const emptyFrame = new Float32Array(0);
+
+/**
+ * Hook for a visualizer stream sent with beatconnect::sendVisualizerFrame().
+ * Re-renders once per received frame; unchanged frames aren't sent at all.
+ *
+ * For canvas drawing at high rates prefer addVisualizerStreamListener()
+ * directly, so frames are drawn without going through React state.
+ *
+ * @param stream - Stream name used in C++ sendVisualizerFrame()
+ *
+ * @example
+ * const levels = useVisualizerStream('levels');
+ * const inputPeak = levels.data[0] ?? 0;
+ */
+export function useVisualizerStream(stream: string): VisualizerStreamReturn {
+  const [frame, setFrame] = useState<VisualizerStreamReturn>({ data: emptyFrame, sequence: 0 });
+
+  useEffect(() => {
+    const unsubscribe = addVisualizerStreamListener(stream, (data, sequence) => {
+      setFrame({ data, sequence });
+    });
+
+    return unsubscribe;
+  }, [stream]);
+
+  return frame;
+}
@@ -2,42 +2,79 @@
  * React Hook for User Preset Management
  *
  * Manages user presets (save/load/rename/delete) and communication with C++ backend.
+ *
+ * User presets arrive in pages from the C++ preset index
+ * (PresetManager::getPresetListAsJson(offset, limit, query)), so libraries
+ * with thousands of presets don't have to be sent in one message.
  */
 
-import { useState, useEffect, useCallback } from 'react';
-import { isInJuceWebView, addCustomEventListener } from '../lib/juce-bridge';
+import { useState, useEffect, useCallback, useRef } from 'react';
+import { isInJuceWebView, addCustomEventListener, addEditorAttachedListener } from '../lib/juce-bridge';
 
 export interface PresetInfo {
   name: string;
   isFactory: boolean;
+  category?: string;
+  tags?: string[];
+  modified?: number;  // ms since epoch (user presets)
 }
 
 export interface PresetList {
   factory: PresetInfo[];
   user: PresetInfo[];
+  userOffset?: number;  // Index of user[0] in the full (filtered) list
+  userTotal?: number;   // Size of the full (filtered) list
+  isIndexReady?: boolean;
   currentPreset?: string;
   isCurrentFactory?: boolean;
 }
 
+/** Payload of the 'getPresetList' request. */
+export interface PresetListRequest {
+  offset: number;
+  limit: number;
+  query: string;
+}
+
 interface PresetState {
   factory: PresetInfo[];
   user: PresetInfo[];
+  userTotal: number;
+  query: string;
   isLoading: boolean;
   error?: string;
   currentPreset?: string;
   isCurrentFactory?: boolean;
 }
 
+interface UsePresetsOptions {
+  /** User presets fetched per page (default 200) */
+  pageSize?: number;
+}
+
 /**
  * Hook for managing presets
  */
-export function usePresets() {
+export function usePresets(options: UsePresetsOptions = {}) {
+  const { pageSize = 200 } = options;
+
   const [state, setState] = useState<PresetState>({
     factory: [],
     user: [],
+    userTotal: 0,
+    query: '',
     isLoading: true,
   });
 
+  // Latest state for callbacks that page or search without re-creating
+  const stateRef = useRef(state);
+  stateRef.current = state;
+
+  const requestPresetList = useCallback((offset: number, query: string) => {
+    const request: PresetListRequest = { offset, limit: pageSize, query };
+    window.__JUCE__!.backend.emitEvent('getPresetList', request);
+  }, [pageSize]);
+
   // Initialize listeners for C++ events
   useEffect(() => {
     if (!isInJuceWebView()) {
@@ -53,6 +90,8 @@ export function usePresets() {
         user: [
           { name: 'My Custom Preset', isFactory: false },
         ],
+        userTotal: 1,
+        query: '',
         isLoading: false,
       });
       return;
@@ -64,16 +103,34 @@ export function usePresets() {
     const unsubList = addCustomEventListener('presetList', (data: unknown) => {
       console.log('[Presets] presetList event received:', data);
       const list = data as PresetList;
+      const page = list.user || [];
+      const offset = list.userOffset ?? 0;
       setState(s => ({
         ...s,
         factory: list.factory || [],
-        user: list.user || [],
+        // Later pages extend the list; offset 0 (first page, new search,
+        // or C++ pushing a change) replaces it
+        user: offset > 0 ? [...s.user.slice(0, offset), ...page] : page,
+        userTotal: list.userTotal ?? offset + page.length,
         isLoading: false,
         currentPreset: list.currentPreset || s.currentPreset,
         isCurrentFactory: list.isCurrentFactory ?? s.isCurrentFactory,
       }));
     });
 
+    // C++ preset index changed (first scan finished, files changed on disk):
+    // fetch the first page again with the current search
+    const unsubChanged = addCustomEventListener('presetListChanged', () => {
+      requestPresetList(0, stateRef.current.query);
+    });
+
+    // Page reused by another editor (possibly another instance): its
+    // current preset isn't ours, so forget it and fetch the list again
+    const unsubAttached = addEditorAttachedListener(() => {
+      setState(s => ({ ...s, currentPreset: undefined, isCurrentFactory: undefined }));
+      requestPresetList(0, stateRef.current.query);
+    });
+
     // Listen for save result
     const unsubSave = addCustomEventListener('savePresetResult', (data: unknown) => {
       const result = data as { success: boolean; name?: string; error?: string };
@@ -142,16 +199,32 @@ export function usePresets() {
 
     // Request initial preset list from C++
     console.log('[Presets] Requesting initial preset list');
-    window.__JUCE__!.backend.emitEvent('getPresetList', {});
+    requestPresetList(0, '');
 
     return () => {
       unsubList();
+      unsubChanged();
+      unsubAttached();
       unsubSave();
       unsubLoad();
       unsubRename();
       unsubDelete();
     };
-  }, []);
+  }, [requestPresetList]);
+
+  // Fetch the next page of user presets, if there is one
+  const loadMorePresets = useCallback(() => {
+    const s = stateRef.current;
+    if (!isInJuceWebView() || s.user.length >= s.userTotal) return;
+    requestPresetList(s.user.length, s.query);
+  }, [requestPresetList]);
+
+  // Filter user presets by name, tag or category (searched in C++)
+  const searchPresets = useCallback((query: string) => {
+    setState(s => ({ ...s, query }));
+    if (!isInJuceWebView()) return;
+    requestPresetList(0, query);
+  }, [requestPresetList]);
 
   // Save current state as a new user preset
   const savePreset = useCallback((name: string) => {
@@ -250,6 +323,9 @@ export function usePresets() {
     // State
     factoryPresets: state.factory,
     userPresets: state.user,
+    totalUserPresets: state.userTotal,
+    hasMorePresets: state.user.length < state.userTotal,
+    searchQuery: state.query,
     isLoading: state.isLoading,
     error: state.error,
     currentPreset: state.currentPreset,
@@ -263,5 +339,7 @@ export function usePresets() {
     clearError,
     presetExists,
     resetPreset,
+    loadMorePresets,
+    searchPresets,
   };
 }
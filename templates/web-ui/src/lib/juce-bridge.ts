@@ -430,3 +430,120 @@ export function addCustomEventListener(
     window.__JUCE__!.backend.removeEventListener(token);
   };
 }
+
+// ==============================================================================
+// Visualizer Streams (packed float32 frames from C++)
+// ==============================================================================
+// Must match beatconnect::VisualizerTransport in sdk/webui
+
+const VisualizerEventId = '__beatconnect__viz';
+const VisualizerResyncEventId = '__beatconnect__vizResync';
+
+interface VisualizerPayload {
+  stream: string;
+  seq: number;
+  data: string; // base64 of little-endian float32 values
+}
+
+/** Receives each frame; `data` is reused between frames, copy it to keep it. */
+export type VisualizerStreamCallback = (data: Float32Array, sequence: number) => void;
+
+interface VisualizerStreamEntry {
+  buffer: Float32Array;
+  listeners: Set<VisualizerStreamCallback>;
+}
+
+const visualizerStreams = new Map<string, VisualizerStreamEntry>();
+let visualizerToken: [string, number] | null = null;
+
+/** Decode base64 bytes into `target` if it has the right length, else a new array. */
+function decodeFloat32(base64: string, target: Float32Array): Float32Array {
+  const binary = atob(base64);
+  const count = binary.length >> 2;
+  const out = target.length === count ? target : new Float32Array(count);
+  const bytes = new Uint8Array(out.buffer, out.byteOffset, count * 4);
+  for (let i = 0; i < bytes.length; i++) {
+    bytes[i] = binary.charCodeAt(i);
+  }
+  return out;
+}
+
+function handleVisualizerEvent(payload: unknown): void {
+  const frame = payload as VisualizerPayload;
+  const entry = visualizerStreams.get(frame.stream);
+  if (!entry) return;
+
+  entry.buffer = decodeFloat32(frame.data, entry.buffer);
+  for (const fn of entry.listeners) {
+    fn(entry.buffer, frame.seq);
+  }
+}
+
+/**
+ * Listen for frames on a visualizer stream sent with
+ * beatconnect::sendVisualizerFrame(). Cheaper than JSON events for meters,
+ * waveforms and spectra: one base64 string per frame, decoded into a reused
+ * Float32Array. C++ skips unchanged frames, so this asks for a resend on
+ * subscribe to get the current one.
+ *
+ * Usage:
+ *   const unsub = addVisualizerStreamListener('scope', (samples) => draw(samples));
+ *   // Later: unsub();
+ */
+export function addVisualizerStreamListener(
+  stream: string,
+  callback: VisualizerStreamCallback
+): () => void {
+  if (!isInJuceWebView()) {
+    return () => {};
+  }
+
+  const backend = window.__JUCE__!.backend;
+  if (visualizerToken === null) {
+    visualizerToken = backend.addEventListener(VisualizerEventId, handleVisualizerEvent);
+  }
+
+  let entry = visualizerStreams.get(stream);
+  if (!entry) {
+    entry = { buffer: new Float32Array(0), listeners: new Set() };
+    visualizerStreams.set(stream, entry);
+  }
+  entry.listeners.add(callback);
+
+  backend.emitEvent(VisualizerResyncEventId, {});
+
+  return () => {
+    const current = visualizerStreams.get(stream);
+    if (!current) return;
+
+    current.listeners.delete(callback);
+    if (current.listeners.size === 0) {
+      visualizerStreams.delete(stream);
+    }
+    if (visualizerStreams.size === 0 && visualizerToken !== null) {
+      backend.removeEventListener(visualizerToken);
+      visualizerToken = null;
+    }
+  };
+}
+
+// ==============================================================================
+// Editor Reattach (page reused by another editor)
+// ==============================================================================
+// Must match beatconnect::WebViewHost::attachedEventId in sdk/webui
+
+const EditorAttachedEventId = '__beatconnect__attached';
+
+/**
+ * Called when this page, still loaded from an earlier editor, is shown in a
+ * newly opened one (possibly of another plugin instance). Parameters resync
+ * on their own; use this to re-request anything else the editor owns, such
+ * as activation state or the preset list.
+ *
+ * Usage:
+ *   const unsub = addEditorAttachedListener(() => refreshPresets());
+ *   // Later: unsub();
+ */
+export function addEditorAttachedListener(callback: () => void): () => void {
+  return addCustomEventListener(EditorAttachedEventId, () => callback());
+}